@@ -792,6 +792,15 @@ extern "C"
         
     };
 
+    /* Describes how source files are referred to by the debug information produced during a compilation. */
+    typedef SlangUInt32 SlangDebugInfoSourceModeIntegral;
+    enum SlangDebugInfoSourceMode : SlangDebugInfoSourceModeIntegral
+    {
+        SLANG_DEBUG_INFO_SOURCE_MODE_EMBED = 0, ///< Embed the text of each source file, where the format allows it
+        SLANG_DEBUG_INFO_SOURCE_MODE_PATH,      ///< Only refer to each source file by its path
+        SLANG_DEBUG_INFO_SOURCE_MODE_HASH,      ///< Refer to each source file by its path, and a hash of its text in place of the text
+    };
+
     /* Describes the debugging information format produced during a compilation. */
     typedef SlangUInt32 SlangDebugInfoFormatIntegral;
     enum SlangDebugInfoFormat : SlangDebugInfoFormatIntegral
@@ -944,6 +953,17 @@ extern "C"
             SaveStdLibBinSource,
             TrackLiveness,
             LoopInversion,              // bool, enable loop inversion optimization
+            ReportMemory,               // bool, record the memory held by the session at the end of each
+                                        // pipeline phase, and report it after compiling.
+            Permutation,                // Command line only: arguments for one permutation of the program to compile.
+            CheckJobs,                  // intValue0: maximum number of threads used to check function bodies.
+            EmitCompactSource,          // bool, when set, generated source has no indentation or line directives, and
+                                        // shorter names for locals, to reduce the time downstream compilers spend on it.
+            DebugInformationSource,     // intValue0: SlangDebugInfoSourceMode
+            DebugInformationLineTablesOnly, // bool, when set, debug information only maps code to source lines,
+                                            // and doesn't describe variables.
+            DownstreamJobs,             // intValue0: maximum number of downstream compiles to run at the same time.
+            DownstreamCache,            // stringValue0: directory of the cache of downstream compile results.
 
             // Deprecated
             ParameterBlocksUseRegisterSpaces,
@@ -959,6 +979,12 @@ extern "C"
 
             EmbedDXIL,                  // bool
             ForceDXLayout,              // bool
+            ModuleMemoryBudget,         // intValue0: budget in kilobytes for the modules a session keeps loaded.
+                                        // When exceeded, modules that the application holds no reference to,
+                                        // that no component type uses, and that no other loaded module imports
+                                        // are unloaded, least recently used first, and loaded again if they are
+                                        // needed later. A module returned by a load function is only valid
+                                        // while the application holds a reference to it.
             CountOf,
         };
 
@@ -5234,6 +5260,55 @@ namespace slang
 
     #define SLANG_UUID_ISession ISession::getTypeGuid()
 
+        /** The memory held by one part of the compiler, as reported by `ISessionMemoryUsage`.
+
+        The values are estimates. Arenas are measured exactly, but other allocations are either
+        approximated from the number of elements held, or not counted.
+        */
+    struct MemoryUsageEntry
+    {
+            /** The pipeline phase the values were recorded at the end of, or "peak" for
+            the largest values over every recorded phase, or "current" for the memory held
+            when the entries were queried. Values are also recorded at the points within code
+            generation where memory use is highest: "link IR" and "optimize IR".
+            */
+        const char* phase;
+            /** The part of the compiler, such as "ASTBuilder" or "IRModule". Categories starting with
+            "Global" are held by the global session, and shared by all of its sessions. */
+        const char* category;
+            /** Bytes allocated from the system. */
+        size_t reservedBytes;
+            /** Bytes in use, which is never more than `reservedBytes`. */
+        size_t usedBytes;
+    };
+
+        /** An extension of `ISession` for observing the memory a session holds.
+
+        Obtain it from an `ISession` via `queryInterface`. Values for pipeline phases are
+        only recorded when `CompilerOptionName::ReportMemory` is set for the session.
+        */
+    struct ISessionMemoryUsage : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(0x3f6b1c2e, 0x8d47, 0x4a91, { 0xb5, 0x0c, 0x72, 0xe9, 0x1d, 0x46, 0xa3, 0x8b })
+
+            /** Measure the memory the session holds now, and get the number of entries
+            available from `getMemoryUsageEntry`.
+            */
+        virtual SLANG_NO_THROW SlangInt SLANG_MCALL getMemoryUsageEntryCount() = 0;
+
+            /** Get an entry measured by the last call to `getMemoryUsageEntryCount`.
+            The strings in the entry remain valid until the next call to `getMemoryUsageEntryCount`.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsageEntry(
+            SlangInt            index,
+            MemoryUsageEntry*   outEntry) = 0;
+
+            /** Get all the entries, measured now, as a human readable table. */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsageReport(IBlob** outReport) = 0;
+    };
+
+    #define SLANG_UUID_ISessionMemoryUsage ISessionMemoryUsage::getTypeGuid()
+
         /** A component type is a unit of shader code layout, reflection, and linking.
 
         A component type is a unit of shader code that can be included into
@@ -5562,6 +5637,62 @@ namespace slang
             return rs;
         }
     };
+
+        /** Describes one variant of a program for `IComponentType2::getEntryPointCodeForPermutations`.
+        */
+    struct PermutationDesc
+    {
+            /** Arguments for the specialization parameters of the linked program.
+
+            The arguments are interpreted as by `IComponentType::specialize` on the result of
+            `IComponentType::link`. May be empty if the program has no specialization parameters.
+            */
+        SpecializationArg const*    specializationArgs = nullptr;
+        SlangInt                    specializationArgCount = 0;
+
+            /** Additional component types to link into this variant.
+
+            Typically these are modules that define the values of link-time
+            constants (`export static const`) declared by the program
+            (`extern static const`).
+            */
+        IComponentType* const*      linkTimeComponents = nullptr;
+        SlangInt                    linkTimeComponentCount = 0;
+    };
+
+        /** An extension of `IComponentType` for generating code for many variants of a program at once.
+
+        Obtain it from an `IComponentType` via `queryInterface`.
+        */
+    struct IComponentType2 : public ISlangUnknown
+    {
+        SLANG_COM_INTERFACE(0x9c2a4d73, 0x5e1b, 0x4f86, { 0xa0, 0x3d, 0x2b, 0x7e, 0x61, 0xc4, 0x58, 0x9f })
+
+            /** Get the compiled code for the entry point at `entryPointIndex` for each of the
+            variants of this component type described by `permutations`.
+
+            This is equivalent to specializing and linking this component type for each
+            permutation and calling `getEntryPointCode` on the result, except that linking
+            this component type with its dependencies is only done once for the whole batch,
+            and the IR links of the variants share the choices of definitions made for the
+            modules they have in common. The IR of each variant is still optimized separately,
+            and the downstream compiles of all of the variants run at the same time.
+
+            `outCodes` must point to an array of `permutationCount` blobs. The blob for any
+            permutation that failed to compile is set to null, and `SLANG_FAIL` is returned
+            after all permutations have been attempted.
+
+            Diagnostics for all permutations are written to `outDiagnostics`.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeForPermutations(
+            SlangInt                entryPointIndex,
+            SlangInt                targetIndex,
+            PermutationDesc const*  permutations,
+            SlangInt                permutationCount,
+            IBlob**                 outCodes,
+            IBlob**                 outDiagnostics = nullptr) = 0;
+    };
+    #define SLANG_UUID_IComponentType2 IComponentType2::getTypeGuid()
 }
 
 // Passed into functions to create globalSession to identify the API version client code is
@@ -55,7 +55,7 @@ void printDiagnosticArg(StringBuilder& sb, Slang::UnownedStringSlice const& str)
 
 void printDiagnosticArg(StringBuilder& sb, Name* name)
 {
-    sb << getText(name);
+    sb << getUnownedStringSliceText(name);
 }
 
 
@@ -508,6 +508,37 @@ void DiagnosticSink::reset()
 }
 
 
+void DiagnosticSink::initDeferred(DiagnosticSink const& sink)
+{
+    init(sink.m_sourceManager, sink.m_sourceLocationLexer);
+
+    m_flags = sink.m_flags;
+    m_sourceLineMaxLength = sink.m_sourceLineMaxLength;
+    m_severityOverrides = sink.m_severityOverrides;
+}
+
+void DiagnosticSink::outputDeferredDiagnostics(ConstArrayView<DeferredDiagnostic> diagnostics)
+{
+    for (auto const& deferred : diagnostics)
+    {
+        // An error this sink recorded itself was counted then, and is counted again below
+        if (deferred.recordedBy == this && deferred.info.severity >= Severity::Error)
+        {
+            m_errorCount--;
+        }
+
+        if (deferred.isRaw)
+        {
+            diagnoseRaw(deferred.info.severity, deferred.diagnostic.Message.getUnownedSlice());
+            continue;
+        }
+
+        StringBuilder messageBuilder;
+        formatDiagnostic(this, deferred.diagnostic, messageBuilder);
+        diagnoseImpl(deferred.info, messageBuilder.getUnownedSlice());
+    }
+}
+
 void DiagnosticSink::noteInternalErrorLoc(SourceLoc const& loc)
 {
     // Don't consider invalid source locations.
@@ -579,6 +610,21 @@ bool DiagnosticSink::diagnoseImpl(DiagnosticInfo const& info, const UnownedStrin
     return true;
 }
 
+bool DiagnosticSink::_noteDeferred(Severity severity)
+{
+    if (severity >= Severity::Error)
+    {
+        m_errorCount++;
+    }
+    // Stop at a fatal diagnostic, just as if it had been output. The sink that outputs the
+    // deferred diagnostics will abort again when it gets to it.
+    if (severity >= Severity::Fatal)
+    {
+        SLANG_ABORT_COMPILATION("");
+    }
+    return true;
+}
+
 Severity DiagnosticSink::getEffectiveMessageSeverity(DiagnosticInfo const& info)
 {
     Severity effectiveSeverity = info.severity;
@@ -618,6 +664,17 @@ bool DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo info, int
         diagnostic.loc = pos;
         diagnostic.severity = info.severity;
 
+        if (m_deferredOutput)
+        {
+            // Formatting the location is left to the sink the diagnostic is output to
+            DeferredDiagnostic deferred;
+            deferred.info = info;
+            deferred.diagnostic = diagnostic;
+            deferred.recordedBy = this;
+            m_deferredOutput->add(deferred);
+            return _noteDeferred(info.severity);
+        }
+
         // If so, pass the error string along to them
         formatDiagnostic(this, diagnostic, messageBuilder);
     }
@@ -636,6 +693,19 @@ void DiagnosticSink::diagnoseRaw(
     Severity    severity,
     const UnownedStringSlice& message)
 {
+    if (m_deferredOutput)
+    {
+        DeferredDiagnostic deferred;
+        deferred.info.severity = severity;
+        deferred.diagnostic.Message = message;
+        deferred.diagnostic.severity = severity;
+        deferred.isRaw = true;
+        deferred.recordedBy = this;
+        m_deferredOutput->add(deferred);
+        _noteDeferred(severity);
+        return;
+    }
+
     if (severity >= Severity::Error)
     {
         m_errorCount++;
@@ -162,6 +162,16 @@ public:
         /// will only display a caret at the SourceLoc
     typedef UnownedStringSlice(*SourceLocationLexer)(const UnownedStringSlice& text);
 
+        /// A diagnostic recorded by a sink with deferred output. The message is formatted, but
+        /// the location is not, as doing so requires access to the source manager.
+    struct DeferredDiagnostic
+    {
+        DiagnosticInfo info;            ///< The info, with the effective severity
+        Diagnostic diagnostic;
+        bool isRaw = false;             ///< If set `diagnostic.Message` is output as is
+        DiagnosticSink* recordedBy = nullptr;   ///< The sink that recorded it, and so has already counted it if it's an error
+    };
+
         /// Get the total amount of errors that have taken place on this DiagnosticSink
     SLANG_FORCE_INLINE int getErrorCount() { return m_errorCount; }
 
@@ -243,6 +253,15 @@ public:
         /// Resets error counts. Resets the output buffer.
     void reset();
 
+        /// Initialize as a sink that records diagnostics with `setDeferredOutput` rather than
+        /// outputting them, using the flags and severity overrides of `sink`. Diagnostics can be
+        /// produced this way on a thread other than the one that owns `sink`.
+    void initDeferred(DiagnosticSink const& sink);
+        /// Set the list diagnostics are recorded into instead of being output, or nullptr to output them again
+    void setDeferredOutput(List<DeferredDiagnostic>* deferredOutput) { m_deferredOutput = deferredOutput; }
+        /// Output recorded diagnostics, as if they were diagnosed on this sink
+    void outputDeferredDiagnostics(ConstArrayView<DeferredDiagnostic> diagnostics);
+
         /// Initialize state. 
     void init(SourceManager* sourceManager, SourceLocationLexer sourceLocationLexer);
 
@@ -269,6 +288,9 @@ protected:
 
     Severity getEffectiveMessageSeverity(DiagnosticInfo const& info);
 
+        /// Account for a diagnostic recorded into `m_deferredOutput`
+    bool _noteDeferred(Severity severity);
+
         /// If set all diagnostics (as formatted by *this* sink, will be routed to the parent).
     DiagnosticSink* m_parentSink = nullptr;
 
@@ -288,6 +310,9 @@ protected:
     
     // Configuration that allows the user to control the severity of certain diagnostic messages
     Dictionary<int, Severity> m_severityOverrides;
+
+        /// If set, diagnostics are recorded here instead of being output
+    List<DeferredDiagnostic>* m_deferredOutput = nullptr;
 };
 
     /// An `ISlangWriter` that writes directly to a diagnostic sink.
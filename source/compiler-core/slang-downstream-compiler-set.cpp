@@ -55,6 +55,19 @@ void DownstreamCompilerSet::addSharedLibrary(ISlangSharedLibrary* lib)
     }
 }
 
+PersistentCache* DownstreamCompilerSet::getOrCreateResultCache(const String& directory)
+{
+    if (!m_resultCache || m_resultCacheDirectory != directory)
+    {
+        PersistentCache::Desc desc;
+        desc.directory = directory.getBuffer();
+
+        m_resultCache = new PersistentCache(desc);
+        m_resultCacheDirectory = directory;
+    }
+    return m_resultCache;
+}
+
 bool DownstreamCompilerSet::hasCompiler(SlangPassThrough compilerType) const
 {
     for (IDownstreamCompiler* compiler : m_compilers)
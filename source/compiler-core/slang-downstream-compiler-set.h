@@ -3,6 +3,8 @@
 
 #include "slang-downstream-compiler.h"
 
+#include "../core/slang-persistent-cache.h"
+
 namespace Slang
 {
 
@@ -37,6 +39,10 @@ public:
     bool hasSharedLibrary(ISlangSharedLibrary* lib);
     void addSharedLibrary(ISlangSharedLibrary* lib);
 
+        /// Get the cache of compile results held in `directory`, creating it if needed.
+        /// The cache is shared by all of the compilers in the set.
+    PersistentCache* getOrCreateResultCache(const String& directory);
+
     ~DownstreamCompilerSet()
     {
         // A compiler may be implemented in a shared library, so release all first.
@@ -61,6 +67,9 @@ protected:
     List<ComPtr<IDownstreamCompiler>> m_compilers;
 
     List<ComPtr<ISlangSharedLibrary>> m_sharedLibraries;
+
+    String m_resultCacheDirectory;
+    RefPtr<PersistentCache> m_resultCache;
 };
 
 }
@@ -12,6 +12,10 @@
 #include "../core/slang-blob.h"
 #include "../core/slang-char-util.h"
 
+#include "slang-artifact-associated-impl.h"
+#include "slang-artifact-util.h"
+#include "slang-slice-allocator.h"
+
 #ifdef SLANG_VC
 #   include "windows/slang-win-visual-studio-util.h"
 #endif
@@ -467,4 +471,351 @@ static SlangResult _findPaths(const String& path, const char* libraryName, Strin
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Compile result cache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+namespace { // anonymous
+
+typedef DigestBuilder<SHA1> CompileKeyBuilder;
+
+// Strings are appended with their length, so that adjacent strings can't run into each other.
+static void _appendKeyString(CompileKeyBuilder& builder, const CharSlice& slice)
+{
+    builder.append(uint64_t(slice.count));
+    builder.append(slice.data, slice.count);
+}
+
+static void _appendKeyStrings(CompileKeyBuilder& builder, const Slice<TerminatedCharSlice>& slices)
+{
+    builder.append(uint64_t(slices.count));
+    for (const auto& slice : slices)
+    {
+        _appendKeyString(builder, slice);
+    }
+}
+
+static SlangResult _appendKeyArtifact(CompileKeyBuilder& builder, IArtifact* artifact, bool allowNameOnly)
+{
+    builder.append(uint32_t(artifact->getDesc().getPacked()));
+
+    const char* name = artifact->getName();
+    _appendKeyString(builder, name ? CharSlice(name) : CharSlice());
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+    {
+        builder.append(uint64_t(blob->getBufferSize()));
+        builder.append(blob);
+        return SLANG_OK;
+    }
+
+    // Libraries such as system libraries are only referenced by name
+    return allowNameOnly ? SLANG_OK : SLANG_FAIL;
+}
+
+/* The cache entry holds the desc and blob of the result artifact, along with its diagnostics. 
+All values are written in the byte order of the host, as the cache isn't shared between machines. */
+static const uint32_t kCompileResultEntryIdentifier = 0x52434453;       // 'SDCR'
+static const uint32_t kCompileResultEntryVersion = 1;
+
+struct CompileResultEntryWriter
+{
+    template <typename T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        writeBytes(&value, sizeof(T));
+    }
+    void writeBytes(const void* data, size_t size)
+    {
+        m_data.addRange((const uint8_t*)data, Count(size));
+    }
+    void writeString(const CharSlice& slice)
+    {
+        write(uint64_t(slice.count));
+        writeBytes(slice.data, slice.count);
+    }
+
+    List<uint8_t> m_data;
+};
+
+struct CompileResultEntryReader
+{
+    template <typename T>
+    SlangResult read(T& outValue)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return readBytes(&outValue, sizeof(T));
+    }
+    SlangResult readBytes(void* dst, size_t size)
+    {
+        if (size > size_t(m_end - m_cur))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(dst, m_cur, size);
+        m_cur += size;
+        return SLANG_OK;
+    }
+    SlangResult readString(String& outString)
+    {
+        uint64_t count;
+        SLANG_RETURN_ON_FAIL(read(count));
+        if (count > uint64_t(m_end - m_cur))
+        {
+            return SLANG_FAIL;
+        }
+        outString = UnownedStringSlice((const char*)m_cur, size_t(count));
+        m_cur += count;
+        return SLANG_OK;
+    }
+
+    CompileResultEntryReader(ISlangBlob* blob)
+        : m_cur((const uint8_t*)blob->getBufferPointer())
+        , m_end(m_cur + blob->getBufferSize())
+    {
+    }
+
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+static SlangResult _writeCompileResultEntry(IArtifact* artifact, ComPtr<ISlangBlob>& outEntry)
+{
+    // Anything associated with the result other than diagnostics (such as a separate pdb) isn't held in the entry
+    for (auto associated : artifact->getAssociated())
+    {
+        if (associated->getDesc().payload != ArtifactPayload::Diagnostics)
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+    }
+    auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
+    if (diagnostics && 
+        (SLANG_FAILED(diagnostics->getResult()) || diagnostics->hasOfAtLeastSeverity(ArtifactDiagnostic::Severity::Error)))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::No, blob.writeRef()));
+
+    CompileResultEntryWriter writer;
+    writer.write(kCompileResultEntryIdentifier);
+    writer.write(kCompileResultEntryVersion);
+    writer.write(uint32_t(artifact->getDesc().getPacked()));
+
+    const Count diagnosticCount = diagnostics ? diagnostics->getCount() : 0;
+    writer.writeString(diagnostics ? CharSlice(diagnostics->getRaw()) : CharSlice());
+    writer.write(uint64_t(diagnosticCount));
+    for (Index i = 0; i < diagnosticCount; ++i)
+    {
+        const auto diagnostic = diagnostics->getAt(i);
+        writer.write(diagnostic->severity);
+        writer.write(diagnostic->stage);
+        writer.write(int64_t(diagnostic->location.line));
+        writer.write(int64_t(diagnostic->location.column));
+        writer.writeString(diagnostic->text);
+        writer.writeString(diagnostic->code);
+        writer.writeString(diagnostic->filePath);
+    }
+
+    writer.write(uint64_t(blob->getBufferSize()));
+    writer.writeBytes(blob->getBufferPointer(), blob->getBufferSize());
+
+    outEntry = ListBlob::moveCreate(writer.m_data);
+    return SLANG_OK;
+}
+
+static SlangResult _readCompileResultEntry(ISlangBlob* entry, ComPtr<IArtifact>& outArtifact)
+{
+    CompileResultEntryReader reader(entry);
+
+    uint32_t identifier, version, packedDesc;
+    SLANG_RETURN_ON_FAIL(reader.read(identifier));
+    SLANG_RETURN_ON_FAIL(reader.read(version));
+    if (identifier != kCompileResultEntryIdentifier || version != kCompileResultEntryVersion)
+    {
+        return SLANG_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(reader.read(packedDesc));
+
+    auto diagnostics = ArtifactDiagnostics::create();
+
+    String raw;
+    SLANG_RETURN_ON_FAIL(reader.readString(raw));
+    diagnostics->setRaw(SliceUtil::asCharSlice(raw));
+
+    uint64_t diagnosticCount;
+    SLANG_RETURN_ON_FAIL(reader.read(diagnosticCount));
+    for (uint64_t i = 0; i < diagnosticCount; ++i)
+    {
+        ArtifactDiagnostic diagnostic;
+        int64_t line, column;
+        String text, code, filePath;
+
+        SLANG_RETURN_ON_FAIL(reader.read(diagnostic.severity));
+        SLANG_RETURN_ON_FAIL(reader.read(diagnostic.stage));
+        SLANG_RETURN_ON_FAIL(reader.read(line));
+        SLANG_RETURN_ON_FAIL(reader.read(column));
+        SLANG_RETURN_ON_FAIL(reader.readString(text));
+        SLANG_RETURN_ON_FAIL(reader.readString(code));
+        SLANG_RETURN_ON_FAIL(reader.readString(filePath));
+
+        // The strings are copied when the diagnostic is added
+        diagnostic.location.line = Int(line);
+        diagnostic.location.column = Int(column);
+        diagnostic.text = SliceUtil::asTerminatedCharSlice(text);
+        diagnostic.code = SliceUtil::asTerminatedCharSlice(code);
+        diagnostic.filePath = SliceUtil::asTerminatedCharSlice(filePath);
+        diagnostics->add(diagnostic);
+    }
+
+    uint64_t blobSize;
+    SLANG_RETURN_ON_FAIL(reader.read(blobSize));
+    if (blobSize != uint64_t(reader.m_end - reader.m_cur))
+    {
+        return SLANG_FAIL;
+    }
+    auto blob = RawBlob::create(reader.m_cur, size_t(blobSize));
+
+    auto artifact = ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactDesc::Packed(packedDesc)));
+    artifact->addRepresentationUnknown(blob);
+    ArtifactUtil::addAssociated(artifact, diagnostics);
+
+    outArtifact = artifact;
+    return SLANG_OK;
+}
+
+} // anonymous
+
+/* static */SlangResult DownstreamCompilerUtil::calcCompileResultKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache::Key& outKey)
+{
+    if (options.includePaths.count)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    CompileKeyBuilder builder;
+
+    // The compiler. The version string is more specific than the version in the desc where available
+    // (for example, dxc includes the timestamp of the library).
+    {
+        const auto& desc = compiler->getDesc();
+        builder.append(desc.type);
+        builder.append(desc.version.m_major);
+        builder.append(desc.version.m_minor);
+        builder.append(desc.version.m_patch);
+
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            builder.append(versionString);
+        }
+    }
+
+    // The options
+    builder.append(options.optimizationLevel);
+    builder.append(options.debugInfoType);
+    builder.append(options.targetType);
+    builder.append(options.sourceLanguage);
+    builder.append(options.floatingPointMode);
+    builder.append(options.pipelineType);
+    builder.append(options.matrixLayout);
+    builder.append(options.flags);
+    builder.append(options.platform);
+    builder.append(options.stage);
+    builder.append(options.m_debugInfoFormat);
+
+    _appendKeyString(builder, options.modulePath);
+    _appendKeyString(builder, options.entryPointName);
+    _appendKeyString(builder, options.profileName);
+    _appendKeyStrings(builder, options.libraryPaths);
+    _appendKeyStrings(builder, options.compilerSpecificArguments);
+
+    builder.append(uint64_t(options.defines.count));
+    for (const auto& define : options.defines)
+    {
+        _appendKeyString(builder, define.nameWithSig);
+        _appendKeyString(builder, define.value);
+    }
+
+    builder.append(uint64_t(options.requiredCapabilityVersions.count));
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.append(capabilityVersion.kind);
+        builder.append(capabilityVersion.version.m_major);
+        builder.append(capabilityVersion.version.m_minor);
+        builder.append(capabilityVersion.version.m_patch);
+    }
+
+    // The inputs
+    builder.append(uint64_t(options.sourceArtifacts.count));
+    for (auto sourceArtifact : options.sourceArtifacts)
+    {
+        SLANG_RETURN_ON_FAIL(_appendKeyArtifact(builder, sourceArtifact, false));
+    }
+    builder.append(uint64_t(options.libraries.count));
+    for (auto library : options.libraries)
+    {
+        SLANG_RETURN_ON_FAIL(_appendKeyArtifact(builder, library, true));
+    }
+
+    outKey = builder.finalize();
+    return SLANG_OK;
+}
+
+/* static */SlangResult DownstreamCompilerUtil::compileWithCache(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache* cache, IArtifact** outArtifact)
+{
+    if (!cache)
+    {
+        return compiler->compile(options, outArtifact);
+    }
+
+    PersistentCache::Key key;
+    const SlangResult findResult = findCachedCompileResult(compiler, options, cache, key, outArtifact);
+    if (SLANG_SUCCEEDED(findResult))
+    {
+        return SLANG_OK;
+    }
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+
+    if (findResult == SLANG_E_NOT_FOUND)
+    {
+        addCompileResultToCache(cache, key, artifact);
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+/* static */SlangResult DownstreamCompilerUtil::findCachedCompileResult(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache* cache, PersistentCache::Key& outKey, IArtifact** outArtifact)
+{
+    SLANG_RETURN_ON_FAIL(calcCompileResultKey(compiler, options, outKey));
+
+    ComPtr<ISlangBlob> entry;
+    if (SLANG_SUCCEEDED(cache->readEntry(outKey, entry.writeRef())))
+    {
+        ComPtr<IArtifact> cachedArtifact;
+        // If the entry can't be read, it's replaced with the result of compiling
+        if (SLANG_SUCCEEDED(_readCompileResultEntry(entry, cachedArtifact)))
+        {
+            *outArtifact = cachedArtifact.detach();
+            return SLANG_OK;
+        }
+    }
+    return SLANG_E_NOT_FOUND;
+}
+
+/* static */void DownstreamCompilerUtil::addCompileResultToCache(PersistentCache* cache, const PersistentCache::Key& key, IArtifact* artifact)
+{
+    // Results that can't be held in the cache (such as a library loaded in process) are just not written
+    ComPtr<ISlangBlob> entry;
+    if (SLANG_SUCCEEDED(_writeCompileResultEntry(artifact, entry)))
+    {
+        cache->writeEntry(key, entry);
+    }
+}
+
 }
@@ -98,6 +98,24 @@ struct DownstreamCompilerUtil: public DownstreamCompilerUtilBase
 
         /// Append the desc as text
     static void appendAsText(const DownstreamCompilerDesc& desc, StringBuilder& out);
+
+        /// Calculate a key that identifies the result of compiling with `options` on `compiler`.
+        /// The key covers the compiler and its version, the options, and the contents of the source artifacts.
+        /// Files the source includes are not part of the key, so fails if there are any include paths.
+    static SlangResult calcCompileResultKey(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache::Key& outKey);
+
+        /// Compile with `compiler`, reusing the result held in `cache` from an earlier compile with the same key, if there is one.
+        /// A successful compile whose result can be held in a blob is written to `cache`, along with its diagnostics.
+        /// If `cache` is nullptr, or no key can be calculated, just compiles.
+    static SlangResult compileWithCache(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache* cache, IArtifact** outArtifact);
+
+        /// Find the result of compiling with `options` on `compiler` in `cache`, as `compileWithCache` does.
+        /// If it isn't there returns SLANG_E_NOT_FOUND, with `outKey` set to the key to add the result with.
+        /// Other failures mean the result can't be cached.
+    static SlangResult findCachedCompileResult(IDownstreamCompiler* compiler, const DownstreamCompileOptions& options, PersistentCache* cache, PersistentCache::Key& outKey, IArtifact** outArtifact);
+
+        /// Add `artifact`, the result of a compile, to `cache` with `key`, if it can be held in a blob.
+    static void addCompileResultToCache(PersistentCache* cache, const PersistentCache::Key& key, IArtifact* artifact);
 };
 
 }
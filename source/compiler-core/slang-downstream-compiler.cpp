@@ -64,6 +64,15 @@ void* DownstreamCompilerBase::getObject(const Guid& guid)
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CommandLineDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!*/
 
+void* CommandLineDownstreamCompiler::castAs(const Guid& guid)
+{
+    if (guid == CommandLineDownstreamCompiler::getTypeGuid())
+    {
+        return this;
+    }
+    return Super::castAs(guid);
+}
+
 SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
 {
     if (!isVersionCompatible(inOptions))
@@ -72,23 +81,108 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
         return SLANG_E_NOT_IMPLEMENTED;
     }
 
-    CompileOptions options = getCompatibleVersion(&inOptions);
+    PreparedCompile prepared;
+    SLANG_RETURN_ON_FAIL(_prepareCompile(getCompatibleVersion(&inOptions), prepared));
+
+    ExecuteResult exeRes;
+
+#if 0
+    // Test
+    {
+        String line = ProcessUtil::getCommandLineString(prepared.cmdLine);
+        printf("%s", line.getBuffer());
+    }
+#endif
+
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(prepared.cmdLine, exeRes));
+
+#if 0
+    {
+        printf("stdout=\"%s\"\nstderr=\"%s\"\nret=%d\n", exeRes.standardOutput.getBuffer(), exeRes.standardError.getBuffer(), int(exeRes.resultCode));
+    }
+#endif
+
+    return _finishCompile(prepared, exeRes, outArtifact);
+}
+
+/* static */void CommandLineDownstreamCompiler::compileAll(
+    CommandLineDownstreamCompiler* const* compilers,
+    const CompileOptions* options,
+    Count count,
+    Count maxProcessCount,
+    SlangResult* outResults,
+    ComPtr<IArtifact>* outArtifacts)
+{
+    maxProcessCount = Math::Max(maxProcessCount, Count(1));
+
+    List<PreparedCompile> prepared;
+    prepared.setCount(count);
+
+    // The compiles are run in groups of up to `maxProcessCount`, with all of the processes of a group
+    // running at the same time.
+    List<Index> groupIndices;
+    List<CommandLine> groupCmdLines;
+    List<ExecuteResult> groupExeResults;
+    for (Index start = 0; start < count; )
+    {
+        groupIndices.clear();
+        groupCmdLines.clear();
+        for (; start < count && groupIndices.getCount() < maxProcessCount; ++start)
+        {
+            outArtifacts[start].setNull();
+
+            const auto& compileOptions = options[start];
+            auto compiler = compilers[start];
+            if (!isVersionCompatible(compileOptions))
+            {
+                outResults[start] = SLANG_E_NOT_IMPLEMENTED;
+                continue;
+            }
+            outResults[start] = compiler->_prepareCompile(getCompatibleVersion(&compileOptions), prepared[start]);
+            if (SLANG_SUCCEEDED(outResults[start]))
+            {
+                groupIndices.add(start);
+                groupCmdLines.add(prepared[start].cmdLine);
+            }
+        }
+
+        groupExeResults.setCount(groupIndices.getCount());
+        const SlangResult executeResult = ProcessUtil::execute(groupCmdLines.getBuffer(), groupCmdLines.getCount(), groupExeResults.getBuffer());
+
+        for (Index i = 0; i < groupIndices.getCount(); ++i)
+        {
+            const Index index = groupIndices[i];
+            outResults[index] = SLANG_SUCCEEDED(executeResult) ?
+                compilers[index]->_finishCompile(prepared[index], groupExeResults[i], outArtifacts[index].writeRef()) :
+                executeResult;
+
+            // Release the products of the compile, such as the lock file, as soon as it is done with
+            prepared[index] = PreparedCompile();
+        }
+    }
+}
+
+SlangResult CommandLineDownstreamCompiler::_prepareCompile(const CompileOptions& inOptions, PreparedCompile& outPrepared)
+{
+    auto& options = outPrepared.options;
+    options = inOptions;
 
     // Copy the command line options
-    CommandLine cmdLine(m_cmdLine);
+    auto& cmdLine = outPrepared.cmdLine;
+    cmdLine = m_cmdLine;
 
     // Work out the ArtifactDesc 
     const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
     auto helper = DefaultArtifactHelper::getSingleton();
     
-    List<ComPtr<IArtifact>> artifactList;
+    auto& artifactList = outPrepared.artifactList;
 
     // It may be necessary to produce a temporary file 'lock file'.
-    ComPtr<IOSFileArtifactRepresentation> lockFile;
+    auto& lockFile = outPrepared.lockFile;
 
-    // The allocator can be used for items that are not kept in scope by the options
-    String modulePath;
+    // Holds the module path if one is generated, as the options only refer to it
+    auto& modulePath = outPrepared.modulePath;
 
     // If no module path is set we will need to generate one
     if (options.modulePath.count == 0)
@@ -112,7 +206,7 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     SLANG_RETURN_ON_FAIL(calcArgs(options, cmdLine));
 
     // The 'productArtifact' is the main product produced from the compilation - the executable/sharedlibrary/object etc
-    ComPtr<IArtifact> productArtifact;
+    auto& productArtifact = outPrepared.productArtifact;
     {
         List<ComPtr<IArtifact>> artifacts;
         SLANG_RETURN_ON_FAIL(calcCompileProducts(options, DownstreamProductFlag::All, lockFile, artifacts));
@@ -136,24 +230,16 @@ SlangResult CommandLineDownstreamCompiler::compile(const CompileOptions& inOptio
     {
         return SLANG_FAIL;
     }
+    return SLANG_OK;
+}
 
-    ExecuteResult exeRes;
-
-#if 0
-    // Test
-    {
-        String line = ProcessUtil::getCommandLineString(cmdLine);
-        printf("%s", line.getBuffer());
-    }
-#endif
-
-    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+SlangResult CommandLineDownstreamCompiler::_finishCompile(PreparedCompile& prepared, const ExecuteResult& exeRes, IArtifact** outArtifact)
+{
+    const auto& options = prepared.options;
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
 
-#if 0
-    {
-        printf("stdout=\"%s\"\nstderr=\"%s\"\nret=%d\n", exeRes.standardOutput.getBuffer(), exeRes.standardError.getBuffer(), int(exeRes.resultCode));
-    }
-#endif
+    auto& artifactList = prepared.artifactList;
+    auto& productArtifact = prepared.productArtifact;
 
     // Go through the list of artifacts in the artifactList and check if they exist. 
     // 
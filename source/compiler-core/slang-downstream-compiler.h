@@ -346,12 +346,28 @@ public:
 class CommandLineDownstreamCompiler : public DownstreamCompilerBase
 {
 public:
+    SLANG_CLASS_GUID(0x5e0c6f3a, 0x7d21, 0x4b8e, { 0x9a, 0x4f, 0x13, 0xc2, 0x6b, 0x80, 0xe5, 0x37 })
+
     typedef DownstreamCompilerBase Super;
 
+    // ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const Guid& guid) SLANG_OVERRIDE;
+
     // IDownstreamCompiler
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE { return true; }
 
+        /// Compile with each of `compilers`, using the options at the same index. At most `maxProcessCount`
+        /// compiler processes run at the same time, and the output of all of them is read on the calling thread.
+        /// The result of each compile is written to `outResults`, and its artifact to `outArtifacts`.
+    static void compileAll(
+        CommandLineDownstreamCompiler* const* compilers,
+        const CompileOptions* options,
+        Count count,
+        Count maxProcessCount,
+        SlangResult* outResults,
+        ComPtr<IArtifact>* outArtifacts);
+
     // Functions to be implemented for a specific CommandLine
 
         /// Given options determines the paths to products produced (including the 'moduleFilePath').
@@ -376,6 +392,26 @@ public:
     CommandLineDownstreamCompiler(const Desc& desc):Super(desc) {}
 
     CommandLine m_cmdLine;
+
+protected:
+        /// A compile whose command line and products have been worked out, but that hasn't been run yet.
+    struct PreparedCompile
+    {
+        CompileOptions options;
+        CommandLine cmdLine;
+            /// Holds the module path `options` refers to, if one had to be generated
+        String modulePath;
+        ComPtr<IOSFileArtifactRepresentation> lockFile;
+            /// The products of the compile, and the lock file
+        List<ComPtr<IArtifact>> artifactList;
+            /// The main product of the compile
+        ComPtr<IArtifact> productArtifact;
+    };
+
+        /// Work out the command line and products of compiling with `options`.
+    SlangResult _prepareCompile(const CompileOptions& options, PreparedCompile& outPrepared);
+        /// Make the artifact for a prepared compile, given the result of running its command line.
+    SlangResult _finishCompile(PreparedCompile& prepared, const ExecuteResult& exeRes, IArtifact** outArtifact);
 };
 
 /* Only purpose of having base-class here is to make all the DownstreamCompiler types available directly in derived Utils */
@@ -19,8 +19,18 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
+size_t RootNamePool::calcMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Each name is held by the dictionary, and its text is held by both the name and the key.
+    return size_t(names.getCount()) * (sizeof(Name) + sizeof(RefPtr<Name>) + sizeof(String)) + 2 * textLength;
+}
+
 Name* NamePool::getName(UnownedStringSlice text)
 {
+    std::lock_guard<std::mutex> lock(rootPool->mutex);
+
     RefPtr<Name> name;
     if (rootPool->names.tryGetValue(text, name))
         return name;
@@ -28,6 +38,7 @@ Name* NamePool::getName(UnownedStringSlice text)
     name = new Name();
     name->text = text;
     rootPool->names.add(text, name);
+    rootPool->textLength += text.getLength();
     return name;
 }
 
@@ -38,6 +49,8 @@ Name* NamePool::getName(String const& text)
 
 Name* NamePool::tryGetName(String const& text)
 {
+    std::lock_guard<std::mutex> lock(rootPool->mutex);
+
     RefPtr<Name> name;
     if (rootPool->names.tryGetValue(text, name))
         return name;
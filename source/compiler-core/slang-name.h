@@ -7,6 +7,8 @@
 
 #include "../core/slang-basic.h"
 
+#include <mutex>
+
 namespace Slang {
 
 // The `Name` type is used to represent the name of a type, variable, etc.
@@ -47,10 +49,21 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// Names can be looked up and added from multiple threads at the same time.
+//
 struct RootNamePool
 {
+    // Get an estimate of the bytes held by the names, without walking them.
+    size_t calcMemoryUsage();
+
     // The mapping from text strings to the corresponding name.
     Dictionary<String, RefPtr<Name> > names;
+
+    // The total length of the text of `names`
+    size_t textLength = 0;
+
+    // Guards `names` and `textLength`
+    std::mutex mutex;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -21,6 +21,8 @@
 #include "slang-artifact-desc-util.h"
 #include "slang-artifact-associated-impl.h"
 
+#include <mutex>
+
 namespace nvrtc
 {
 
@@ -142,6 +144,10 @@ protected:
 
     SLANG_NVRTC_FUNCS(SLANG_NVTRC_MEMBER_FUNCS);
 
+    // Compiles may run on several threads at once, so the state below, which compiles
+    // add to as they find where the headers are, is only accessed with this held.
+    std::mutex m_includeMutex;
+
     // Holds list of paths passed in where cuda_fp16.h is found. Does *NOT* include cuda_fp16.h.
     List<String> m_cudaFp16FoundPaths;
 
@@ -685,6 +691,8 @@ SlangResult NVRTCDownstreamCompiler::_maybeAddHalfSupport(const DownstreamCompil
         return SLANG_OK;
     }
 
+    std::lock_guard<std::mutex> lock(m_includeMutex);
+
     // First check if we know if one of the include paths contains cuda_fp16.h
     for (const auto& includePath : options.includePaths)
     {
@@ -146,7 +146,9 @@ String perfectHashToEmbeddableCpp(
     w.print("bool %s(const UnownedStringSlice& str, %s& value)\n", String(funcName).getBuffer(), String(valueType).getBuffer());
     line("{");
 
-    w.print("    static const unsigned tableSalt[%d] = {\n", (int)hashParams.saltTable.getCount());
+    // The tables are constexpr, so that they are in the binary, rather than built
+    // when the function is first called.
+    w.print("    static constexpr unsigned tableSalt[%d] = {\n", (int)hashParams.saltTable.getCount());
     w.print("       ");
     for (Index i = 0; i < hashParams.saltTable.getCount(); ++i)
     {
@@ -167,18 +169,25 @@ String perfectHashToEmbeddableCpp(
     line("\n    };");
     line("");
 
-    w.print("    using KV = std::pair<const char*, %s>;\n", String(valueType).getBuffer());
+    // The length of each word is stored, so that a lookup doesn't need to measure it.
+    line("    struct Entry");
+    line("    {");
+    line("        const char* word;");
+    line("        Index length;");
+    w.print("        %s value;\n", String(valueType).getBuffer());
+    line("    };");
     line("");
 
-    w.print("    static const KV words[%d] =\n", (int)hashParams.destTable.getCount());
+    w.print("    static constexpr Entry words[%d] =\n", (int)hashParams.destTable.getCount());
     line("    {");
     for (Index i = 0; i < hashParams.destTable.getCount(); ++i)
     {
         const auto& s = hashParams.destTable[i];
         const auto& v = values[i];
         w.print(
-            "        {\"%s\", %s},\n",
+            "        {\"%s\", %d, %s},\n",
             s.getBuffer(),
+            (int)s.getLength(),
             v.getBuffer()
         );
     }
@@ -187,7 +196,7 @@ String perfectHashToEmbeddableCpp(
 
     // Make sure to update the hash function in the search function above if
     // you change this.
-    line("    static const auto hash = [](const UnownedStringSlice& str, UInt32 salt){");
+    line("    const auto hash = [](const UnownedStringSlice& str, UInt32 salt){");
     line("        UInt32 h = salt;");
     line("        for (const char c : str)");
     line("            h = (h * 0x01000193) ^ c;");
@@ -195,10 +204,10 @@ String perfectHashToEmbeddableCpp(
     line("    };");
     line("");
 
-    line("    const auto i = hash(str, tableSalt[hash(str, 0)]);");
-    line("    if(str == words[i].first)");
+    line("    const auto& entry = words[hash(str, tableSalt[hash(str, 0)])];");
+    line("    if(str == UnownedStringSlice(entry.word, size_t(entry.length)))");
     line("    {");
-    line("        value = words[i].second;");
+    line("        value = entry.value;");
     line("        return true;");
     line("    }");
     line("    else");
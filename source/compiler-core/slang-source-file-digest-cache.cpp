@@ -0,0 +1,61 @@
+// slang-source-file-digest-cache.cpp
+#include "slang-source-file-digest-cache.h"
+
+#include "../core/slang-blob.h"
+
+#include "slang-source-loc.h"
+
+namespace Slang
+{
+
+bool SourceFileDigestCache::tryGetDigest(const String& canonicalPath, const File::Stat& stat, SHA1::Digest& outDigest)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto entry = m_entries.tryGetValue(canonicalPath))
+    {
+        if (entry->stat == stat)
+        {
+            outDigest = entry->digest;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SourceFileDigestCache::addDigest(const String& canonicalPath, const File::Stat& stat, const SHA1::Digest& digest)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry entry;
+    entry.stat = stat;
+    entry.digest = digest;
+    m_entries[canonicalPath] = entry;
+}
+
+Index SourceFileDigestCache::getCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.getCount();
+}
+
+/* static */SlangResult SourceFileDigestCache::readFile(const String& path, File::Stat& outStat, SHA1::Digest& outDigest)
+{
+    SLANG_RETURN_ON_FAIL(File::getStat(path, outStat));
+
+    ScopedAllocation contents;
+    SLANG_RETURN_ON_FAIL(File::readAllBytes(path, contents));
+    auto blob = RawBlob::moveCreate(contents);
+
+    // Use a SourceFile so the contents are decoded exactly as when the file is loaded for compilation
+    SourceFile sourceFile(nullptr, PathInfo::makePath(path), blob->getBufferSize());
+    sourceFile.setContents(blob);
+    outDigest = sourceFile.getDigest();
+    return SLANG_OK;
+}
+
+/* static */SourceFileDigestCache& SourceFileDigestCache::getSingleton()
+{
+    static SourceFileDigestCache cache;
+    return cache;
+}
+
+}
@@ -0,0 +1,49 @@
+#ifndef SLANG_SOURCE_FILE_DIGEST_CACHE_H
+#define SLANG_SOURCE_FILE_DIGEST_CACHE_H
+// slang-source-file-digest-cache.h
+
+#include "../core/slang-basic.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-io.h"
+
+#include <mutex>
+
+namespace Slang
+{
+
+/* Digests of source files on the OS file system, keyed by canonical path, size and modification time.
+
+Shared by all linkages in the process, so that repeatedly checking whether binary modules are up to
+date doesn't read and hash files that haven't changed. */
+class SourceFileDigestCache
+{
+public:
+        /// Get the digest of the file at `canonicalPath`, if it was added with the same `stat`
+    bool tryGetDigest(const String& canonicalPath, const File::Stat& stat, SHA1::Digest& outDigest);
+        /// Add the digest of the file at `canonicalPath`, replacing any older entry for the path
+    void addDigest(const String& canonicalPath, const File::Stat& stat, const SHA1::Digest& digest);
+
+        /// Get the number of files with a digest
+    Index getCount();
+
+        /// Get the stat of the file at `path`, then read it and compute the digest that a SourceFile with its contents
+        /// would have. As the stat is taken first, a file that is changed while it is read has a different stat when it
+        /// is next checked, so a stat and digest pair from here can't describe different versions of a file.
+    static SlangResult readFile(const String& path, File::Stat& outStat, SHA1::Digest& outDigest);
+
+    static SourceFileDigestCache& getSingleton();
+
+protected:
+    struct Entry
+    {
+        File::Stat stat;
+        SHA1::Digest digest;
+    };
+
+    std::mutex m_mutex;
+    Dictionary<String, Entry> m_entries;
+};
+
+}
+
+#endif
@@ -15,7 +15,11 @@ namespace Slang
 
     struct SPIRVCoreGrammarInfo : public RefObject
     {
+        // Parse a `spirv.core.grammar.json`. Only needed to use a grammar other than
+        // the one Slang was built with.
         static RefPtr<SPIRVCoreGrammarInfo> loadFromJSON(SourceView& source, DiagnosticSink& sink);
+        // The grammar Slang was built with. Its tables are generated as constexpr data
+        // by slang-spirv-embed-generator, so nothing is parsed or built to use it.
         static RefPtr<SPIRVCoreGrammarInfo>& getEmbeddedVersion();
         static inline void freeEmbeddedGrammerInfo() { getEmbeddedVersion() = nullptr; }
 
@@ -23,7 +23,7 @@
 namespace Slang
 {
 
-SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComPtr<ISlangFileSystemExt>& outFileSystem)
+SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComPtr<ISlangFileSystemExt>& outFileSystem, ThreadPool* threadPool)
 {
     ComPtr<ISlangMutableFileSystem> fileSystem;
     if (ZipFileSystem::isArchive(data, dataSizeInBytes))
@@ -34,7 +34,7 @@ SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComP
     else if (RiffFileSystem::isArchive(data, dataSizeInBytes))
     {
         // It's riff contained (Slang specific)
-       fileSystem = new RiffFileSystem(nullptr);
+       fileSystem = new RiffFileSystem(nullptr, threadPool);
     }
     else
     {
@@ -53,7 +53,7 @@ SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComP
     return SLANG_OK;
 }
     
-SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem)
+SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem, ThreadPool* threadPool)
 {
     switch (type)
     {
@@ -73,7 +73,9 @@ SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableF
         }
         case SLANG_ARCHIVE_TYPE_RIFF_LZ4:
         {
-            outFileSystem = new RiffFileSystem(LZ4CompressionSystem::getSingleton());
+            // Files are compressed in blocks, so that large files (such as the serialized stdlib)
+            // can be compressed and decompressed on the threads of `threadPool`.
+            outFileSystem = new RiffFileSystem(ChunkedLZ4CompressionSystem::create(threadPool), threadPool);
             return SLANG_OK;
         }
     }
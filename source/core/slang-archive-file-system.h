@@ -10,6 +10,8 @@
 namespace Slang
 {
 
+class ThreadPool;
+
 class IArchiveFileSystem : public ISlangCastable
 {
     SLANG_COM_INTERFACE(0x5c565aac, 0xe834, 0x41fc, { 0x8b, 0xb, 0x7d, 0x4c, 0xf3, 0x8b, 0x89, 0x50 });
@@ -23,8 +25,10 @@ class IArchiveFileSystem : public ISlangCastable
     SLANG_NO_THROW virtual void SLANG_MCALL setCompressionStyle(const CompressionStyle& style) = 0;
 };
 
-SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComPtr<ISlangFileSystemExt>& outFileSystem);
-SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem);
+    /// Load an archive. If `threadPool` is passed, archive formats that support it decompress on its threads.
+SlangResult loadArchiveFileSystem(const void* data, size_t dataSizeInBytes, ComPtr<ISlangFileSystemExt>& outFileSystem, ThreadPool* threadPool = nullptr);
+    /// Create an empty archive. If `threadPool` is passed, archive formats that support it compress on its threads.
+SlangResult createArchiveFileSystem(SlangArchiveType type, ComPtr<ISlangMutableFileSystem>& outFileSystem, ThreadPool* threadPool = nullptr);
 
 }
 
@@ -24,6 +24,7 @@ enum class CompressionSystemType
     None,
     Deflate,
     LZ4,
+    ChunkedLZ4,                             ///< LZ4 compressing fixed size blocks independently, so they can be processed in parallel
     CountOf,
 };
 
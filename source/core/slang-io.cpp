@@ -186,6 +186,34 @@ namespace Slang
 #endif
     }
 
+    /* static */SlangResult File::getStat(const String& fileName, Stat& outStat)
+    {
+#ifdef _WIN32
+        struct _stat64 statVar;
+        if (::_wstat64(fileName.toWString(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+        outStat.size = uint64_t(statVar.st_size);
+        outStat.modifiedTime = uint64_t(statVar.st_mtime);
+#else
+        struct stat statVar;
+        if (::stat(fileName.getBuffer(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+        outStat.size = uint64_t(statVar.st_size);
+#   if SLANG_APPLE_FAMILY
+        const auto& modifiedTime = statVar.st_mtimespec;
+#   else
+        const auto& modifiedTime = statVar.st_mtim;
+#   endif
+        // Use nanoseconds where available, so that a file rewritten within the same second is seen to change
+        outStat.modifiedTime = uint64_t(modifiedTime.tv_sec) * 1000000000 + uint64_t(modifiedTime.tv_nsec);
+#endif
+        return SLANG_OK;
+    }
+
     String Path::replaceExt(const String& path, const char* newExt)
     {
         StringBuilder sb(path.getLength() + 10);
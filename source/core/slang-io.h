@@ -12,8 +12,22 @@ namespace Slang
     class File
     {
     public:
+            /// The size and modification time of a file. Used to detect that a file has
+            /// (probably) not changed without reading it.
+        struct Stat
+        {
+            bool operator==(const Stat& rhs) const { return size == rhs.size && modifiedTime == rhs.modifiedTime; }
+            bool operator!=(const Stat& rhs) const { return !(*this == rhs); }
+
+            uint64_t size = 0;
+            uint64_t modifiedTime = 0;          ///< In platform-specific units. 0 if unknown.
+        };
+
         static bool exists(const String& fileName);
 
+            /// Get the size and modification time of a file
+        static SlangResult getStat(const String& fileName, Stat& outStat);
+
         static SlangResult readAllText(const String& fileName, String& outString);
 
         static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
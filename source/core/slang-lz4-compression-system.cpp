@@ -4,9 +4,12 @@
 #include "slang-com-ptr.h"
 
 #include "slang-blob.h"
+#include "slang-thread-pool.h"
 
 #include "../../external/lz4/lib/lz4.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -67,4 +70,256 @@ SlangResult LZ4CompressionSystemImpl::decompress(const void* compressed, size_t
     return &impl;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ChunkedLZ4CompressionSystem !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// Handing blocks to the workers of a pool has a cost, so each thread used must have at least
+// this many blocks to work on.
+static const Index kMinBlocksPerThread = 4;
+
+// Calls `func(i)` for each i in [0, count), spreading the calls over the threads of `threadPool`
+// when there is one and there are enough blocks. Returns SLANG_FAIL if any call fails.
+template <typename F>
+static SlangResult _forEachBlockParallel(ThreadPool* threadPool, Index count, const F& func)
+{
+    const Index threadCount = threadPool ? Math::Min(count / kMinBlocksPerThread, threadPool->getWorkerCount() + 1) : 0;
+    if (threadCount <= 1)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(func(i));
+        }
+        return SLANG_OK;
+    }
+
+    std::atomic<bool> failed{false};
+    threadPool->forEach(count, threadCount, [&](Index i, Index threadSlot)
+    {
+        SLANG_UNUSED(threadSlot);
+        if (!failed && SLANG_FAILED(func(i)))
+        {
+            failed = true;
+        }
+    });
+    return failed ? SLANG_FAIL : SLANG_OK;
+}
+
+namespace { // anonymous
+
+// The layout of a block of compressed data
+struct ChunkedLZ4Frame
+{
+    SlangResult init(const void* compressed, size_t compressedSizeInBytes)
+    {
+        typedef ChunkedLZ4CompressionSystem::Header Header;
+        if (compressedSizeInBytes < sizeof(Header))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&m_header, compressed, sizeof(Header));
+        if (m_header.magic != Header::kMagic || m_header.blockSize == 0)
+        {
+            return SLANG_FAIL;
+        }
+
+        const size_t sizesInBytes = sizeof(uint32_t) * m_header.blockCount;
+        if (compressedSizeInBytes - sizeof(Header) < sizesInBytes)
+        {
+            return SLANG_FAIL;
+        }
+        const uint32_t* blockSizes = (const uint32_t*)((const Byte*)compressed + sizeof(Header));
+
+        // Work out where each block starts
+        m_blockOffsets.setCount(m_header.blockCount + 1);
+        size_t offset = sizeof(Header) + sizesInBytes;
+        for (uint32_t i = 0; i < m_header.blockCount; ++i)
+        {
+            m_blockOffsets[i] = offset;
+            offset += blockSizes[i];
+        }
+        m_blockOffsets[m_header.blockCount] = offset;
+        if (offset != compressedSizeInBytes)
+        {
+            return SLANG_FAIL;
+        }
+
+        m_data = (const Byte*)compressed;
+        return SLANG_OK;
+    }
+
+        /// Decompress the block `index` into `dst`, which must be the block's decompressed size
+    SlangResult decompressBlock(Index index, size_t decompressedBlockSize, void* dst) const
+    {
+        const size_t compressedBlockSize = m_blockOffsets[index + 1] - m_blockOffsets[index];
+        const int decompressedSize = LZ4_decompress_safe((const char*)m_data + m_blockOffsets[index], (char*)dst, int(compressedBlockSize), int(decompressedBlockSize));
+        return (decompressedSize >= 0 && size_t(decompressedSize) == decompressedBlockSize) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    ChunkedLZ4CompressionSystem::Header m_header;
+    List<size_t> m_blockOffsets;
+    const Byte* m_data = nullptr;
+};
+
+} // anonymous
+
+class ChunkedLZ4CompressionSystemImpl : public RefObject, public ICompressionSystem
+{
+public:
+    // ISlangUnknown
+    SLANG_REF_OBJECT_IUNKNOWN_ALL
+
+    // ICompressionSystem
+    virtual SLANG_NO_THROW CompressionSystemType SLANG_MCALL getSystemType() SLANG_OVERRIDE { return CompressionSystemType::ChunkedLZ4; }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compress(const CompressionStyle* style, const void* src, size_t srcSizeInBytes, ISlangBlob** outBlob) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL decompress(const void* compressed, size_t compressedSizeInBytes, size_t decompressedSizeInBytes, void* outDecompressed) SLANG_OVERRIDE;
+
+        /// Ctor. Blocks are processed on the threads of `threadPool`, or on the calling thread if it is null.
+    explicit ChunkedLZ4CompressionSystemImpl(ThreadPool* threadPool) : m_threadPool(threadPool) {}
+
+protected:
+    ICompressionSystem* getInterface(const Guid& guid);
+
+    RefPtr<ThreadPool> m_threadPool;
+};
+
+ICompressionSystem* ChunkedLZ4CompressionSystemImpl::getInterface(const Guid& guid)
+{
+    return (guid == ISlangUnknown::getTypeGuid() || guid == ICompressionSystem::getTypeGuid()) ? static_cast<ICompressionSystem*>(this) : nullptr;
+}
+
+SlangResult ChunkedLZ4CompressionSystemImpl::compress(const CompressionStyle* style, const void* src, size_t srcSizeInBytes, ISlangBlob** outBlob)
+{
+    SLANG_UNUSED(style);
+    typedef ChunkedLZ4CompressionSystem::Header Header;
+
+    const size_t blockSize = ChunkedLZ4CompressionSystem::kDefaultBlockSize;
+    const Index blockCount = Index((srcSizeInBytes + blockSize - 1) / blockSize);
+
+    // Compress each block into its own buffer
+    List<List<Byte>> compressedBlocks;
+    compressedBlocks.setCount(blockCount);
+    SLANG_RETURN_ON_FAIL(_forEachBlockParallel(m_threadPool, blockCount, [&](Index i) -> SlangResult
+    {
+        const size_t offset = size_t(i) * blockSize;
+        const int srcBlockSize = int(Math::Min(blockSize, srcSizeInBytes - offset));
+
+        auto& compressedBlock = compressedBlocks[i];
+        compressedBlock.setCount(LZ4_compressBound(srcBlockSize));
+        const int compressedSize = LZ4_compress_default((const char*)src + offset, (char*)compressedBlock.getBuffer(), srcBlockSize, int(compressedBlock.getCount()));
+        if (compressedSize <= 0)
+        {
+            return SLANG_FAIL;
+        }
+        compressedBlock.setCount(compressedSize);
+        return SLANG_OK;
+    }));
+
+    size_t totalSize = sizeof(Header) + sizeof(uint32_t) * blockCount;
+    for (const auto& compressedBlock : compressedBlocks)
+    {
+        totalSize += compressedBlock.getCount();
+    }
+
+    ScopedAllocation alloc;
+    Byte* dst = (Byte*)alloc.allocate(totalSize);
+
+    Header header;
+    header.magic = Header::kMagic;
+    header.blockSize = uint32_t(blockSize);
+    header.blockCount = uint32_t(blockCount);
+    ::memcpy(dst, &header, sizeof(header));
+    dst += sizeof(header);
+
+    for (const auto& compressedBlock : compressedBlocks)
+    {
+        const uint32_t compressedSize = uint32_t(compressedBlock.getCount());
+        ::memcpy(dst, &compressedSize, sizeof(compressedSize));
+        dst += sizeof(compressedSize);
+    }
+    for (const auto& compressedBlock : compressedBlocks)
+    {
+        ::memcpy(dst, compressedBlock.getBuffer(), compressedBlock.getCount());
+        dst += compressedBlock.getCount();
+    }
+
+    auto blob = RawBlob::moveCreate(alloc);
+    *outBlob = blob.detach();
+    return SLANG_OK;
+}
+
+SlangResult ChunkedLZ4CompressionSystemImpl::decompress(const void* compressed, size_t compressedSizeInBytes, size_t decompressedSizeInBytes, void* outDecompressed)
+{
+    return ChunkedLZ4CompressionSystem::decompressRange(compressed, compressedSizeInBytes, 0, decompressedSizeInBytes, outDecompressed, m_threadPool);
+}
+
+/* static */ICompressionSystem* ChunkedLZ4CompressionSystem::getSingleton()
+{
+    // Held by a ComPtr, so the count never drops to 0 while it is handed out
+    static ComPtr<ICompressionSystem> singleton(new ChunkedLZ4CompressionSystemImpl(nullptr));
+    return singleton;
+}
+
+/* static */ComPtr<ICompressionSystem> ChunkedLZ4CompressionSystem::create(ThreadPool* threadPool)
+{
+    if (!threadPool)
+    {
+        return ComPtr<ICompressionSystem>(getSingleton());
+    }
+    return ComPtr<ICompressionSystem>(new ChunkedLZ4CompressionSystemImpl(threadPool));
+}
+
+/* static */SlangResult ChunkedLZ4CompressionSystem::decompressRange(const void* compressed, size_t compressedSizeInBytes, size_t offset, size_t size, void* outDecompressed, ThreadPool* threadPool)
+{
+    ChunkedLZ4Frame frame;
+    SLANG_RETURN_ON_FAIL(frame.init(compressed, compressedSizeInBytes));
+    if (size == 0)
+    {
+        return SLANG_OK;
+    }
+
+    const size_t blockSize = frame.m_header.blockSize;
+    const Index firstBlock = Index(offset / blockSize);
+    const Index endBlock = Index((offset + size + blockSize - 1) / blockSize);
+    if (endBlock > Index(frame.m_header.blockCount))
+    {
+        return SLANG_FAIL;
+    }
+
+    Byte* dst = (Byte*)outDecompressed;
+    return _forEachBlockParallel(threadPool, endBlock - firstBlock, [&](Index i) -> SlangResult
+    {
+        const Index blockIndex = firstBlock + i;
+        const size_t blockStart = size_t(blockIndex) * blockSize;
+
+        // All blocks but the last are full. The size of the last block is only known once it has been
+        // decompressed, so it is decompressed with the size of the range that is requested from it.
+        const bool isLastBlock = blockIndex == Index(frame.m_header.blockCount) - 1;
+        const bool isWholeBlock = blockStart >= offset && blockStart + blockSize <= offset + size;
+
+        if (isWholeBlock || (isLastBlock && blockStart >= offset))
+        {
+            const size_t decompressedBlockSize = Math::Min(blockSize, offset + size - blockStart);
+            return frame.decompressBlock(blockIndex, decompressedBlockSize, dst + (blockStart - offset));
+        }
+
+        // The range only covers part of this block, so decompress all of it and copy out what's needed
+        List<Byte> block;
+        block.setCount(blockSize);
+        const int decompressedSize = LZ4_decompress_safe((const char*)frame.m_data + frame.m_blockOffsets[blockIndex], (char*)block.getBuffer(),
+            int(frame.m_blockOffsets[blockIndex + 1] - frame.m_blockOffsets[blockIndex]), int(blockSize));
+        if (decompressedSize < 0)
+        {
+            return SLANG_FAIL;
+        }
+
+        const size_t copyStart = Math::Max(blockStart, offset);
+        const size_t copyEnd = Math::Min(blockStart + size_t(decompressedSize), offset + size);
+        if (copyEnd < copyStart || (copyEnd - copyStart) != Math::Min(blockStart + blockSize, offset + size) - copyStart)
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(dst + (copyStart - offset), block.getBuffer() + (copyStart - blockStart), copyEnd - copyStart);
+        return SLANG_OK;
+    });
+}
+
 } // namespace Slang
@@ -10,6 +10,8 @@
 namespace Slang
 {
 
+class ThreadPool;
+
 class LZ4CompressionSystem
 {
 public:
@@ -17,6 +19,40 @@ public:
     static ICompressionSystem* getSingleton();
 };
 
+/* Compresses data as a sequence of independently compressed LZ4 blocks.
+
+The compressed data starts with a ChunkedLZ4Header, followed by the compressed size of each block as a uint32_t,
+followed by the compressed blocks. Every block except the last decompresses to exactly `blockSize` bytes.
+
+As blocks don't depend on each other, large inputs can be compressed and decompressed on the threads of a ThreadPool,
+and a range of the data can be decompressed without decompressing what comes before it. */
+class ChunkedLZ4CompressionSystem
+{
+public:
+    struct Header
+    {
+        static const uint32_t kMagic = 0x43345a4c;    ///< 'LZ4C'
+
+        uint32_t magic;
+        uint32_t blockSize;                 ///< The decompressed size of each block, apart from the last one
+        uint32_t blockCount;
+    };
+
+        /// The decompressed size of blocks written by the singleton
+    static const size_t kDefaultBlockSize = 256 * 1024;
+
+    /* Get the chunked LZ4 compression system singleton. It processes blocks on the calling thread. */
+    static ICompressionSystem* getSingleton();
+
+        /// Create a chunked LZ4 compression system that spreads the blocks of large inputs over the threads of `threadPool`.
+        /// With a null `threadPool` the singleton is returned.
+    static ComPtr<ICompressionSystem> create(ThreadPool* threadPool);
+
+        /// Decompress the `size` bytes starting at `offset` of the data compressed in `compressed`.
+        /// Only the blocks overlapping the range are decompressed, on the threads of `threadPool` if one is passed.
+    static SlangResult decompressRange(const void* compressed, size_t compressedSizeInBytes, size_t offset, size_t size, void* outDecompressed, ThreadPool* threadPool = nullptr);
+};
+
 }
 
 #endif
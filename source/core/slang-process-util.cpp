@@ -18,11 +18,6 @@ namespace Slang {
     return SLANG_OK;
 }
 
-static Index _getCount(List<Byte>* buf)
-{
-    return buf ? buf->getCount() : 0;
-}
-
 // We may want something more sophisticated here, if bytes is something other than ascii/utf8
 static String _getText(const ConstArrayView<Byte>& bytes)
 {
@@ -47,40 +42,71 @@ static String _getText(const ConstArrayView<Byte>& bytes)
     return SLANG_OK;
 }
 
-/* static */SlangResult ProcessUtil::readUntilTermination(Process* process, List<Byte>* outStdOut, List<Byte>* outStdError)
+/* static */SlangResult ProcessUtil::execute(const CommandLine* commandLines, Count count, ExecuteResult* outExecuteResults)
 {
-    Stream* stdOutStream = process->getStream(StdStreamType::Out);
-    Stream* stdErrorStream = process->getStream(StdStreamType::ErrorOut);
-
-    while (!process->isTerminated())
+    List<RefPtr<Process>> processes;
+    List<List<Byte>> stdOuts;
+    List<List<Byte>> stdErrors;
+    processes.setCount(count);
+    stdOuts.setCount(count);
+    stdErrors.setCount(count);
+
+    List<Process::StreamIO> ios;
+    ios.setCount(count);
+
+    SlangResult res = SLANG_OK;
+    for (Index i = 0; i < count && SLANG_SUCCEEDED(res); ++i)
     {
-        const auto preCount = _getCount(outStdOut) + _getCount(outStdError);
+        res = Process::create(commandLines[i], 0, processes[i]);
 
-        SLANG_RETURN_ON_FAIL(StreamUtil::readOrDiscard(stdOutStream, 0, outStdOut));
-        if (stdErrorStream)
-            SLANG_RETURN_ON_FAIL(StreamUtil::readOrDiscard(stdErrorStream, 0, outStdError));
+        auto& io = ios[i];
+        io.process = processes[i];
+        io.output = &stdOuts[i];
+        io.errorOutput = &stdErrors[i];
+    }
 
-        const auto postCount = _getCount(outStdOut) + _getCount(outStdError);
+    if (SLANG_SUCCEEDED(res))
+    {
+        res = Process::pumpStreams(ios.getBuffer(), count);
+    }
 
-        // If nothing was read, we can yield
-        if (preCount == postCount)
+    if (SLANG_FAILED(res))
+    {
+        // Don't leave any processes that were started running
+        for (auto& process : processes)
         {
-            Process::sleepCurrentThread(0);
+            if (process)
+            {
+                process->kill(-1);
+            }
         }
+        return res;
     }
 
-    // Read anything remaining
-    for(;;)
+    for (Index i = 0; i < count; ++i)
     {
-        const auto preCount = _getCount(outStdOut) + _getCount(outStdError);
-        StreamUtil::readOrDiscard(stdOutStream, 0, outStdOut);
-        if (stdErrorStream)
-            StreamUtil::readOrDiscard(stdErrorStream, 0, outStdError);
-        const auto postCount = _getCount(outStdOut) + _getCount(outStdError);
-        if (preCount == postCount)
-            break;
+        processes[i]->waitForTermination();
+
+        auto& executeResult = outExecuteResults[i];
+        executeResult.resultCode = ExecuteResult::ResultCode(processes[i]->getReturnValue());
+        executeResult.standardOutput = _getText(stdOuts[i].getArrayView());
+        executeResult.standardError = _getText(stdErrors[i].getArrayView());
     }
     return SLANG_OK;
 }
 
+/* static */SlangResult ProcessUtil::readUntilTermination(Process* process, List<Byte>* outStdOut, List<Byte>* outStdError)
+{
+    Process::StreamIO io;
+    io.process = process;
+    io.output = outStdOut;
+    io.errorOutput = outStdError;
+
+    SLANG_RETURN_ON_FAIL(Process::pumpStreams(&io, 1));
+
+    // The output has all been read, but the process may not have exited yet
+    process->waitForTermination();
+    return SLANG_OK;
+}
+
 } // namespace Slang
@@ -27,6 +27,11 @@ struct ProcessUtil
         /// Execute the command line 
     static SlangResult execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult);
 
+        /// Execute all of the command lines at the same time, with the output of all of the processes
+        /// read on the calling thread. If any process can't be started, or its output can't be read,
+        /// all of the processes that were started are killed.
+    static SlangResult execute(const CommandLine* commandLines, Count count, ExecuteResult* outExecuteResults);
+
         /// Read from read from streams until process terminates.
         /// Passing nullptr for a stream, will just discard what's in the stream
     static SlangResult readUntilTermination(Process* process, List<Byte>* outStdOut, List<Byte>* stdError);
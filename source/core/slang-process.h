@@ -27,6 +27,18 @@ public:
         };
     };
 
+        /// The input for, and output of, a process serviced by `pumpStreams`.
+    struct StreamIO
+    {
+        Process* process = nullptr;
+            /// If set, `input` is written to standard input, which is then closed. Otherwise standard input is left alone.
+        bool writeInput = false;
+        ConstArrayView<Byte> input;
+            /// Standard output and error are appended to these. If nullptr the output is discarded.
+        List<Byte>* output = nullptr;
+        List<Byte>* errorOutput = nullptr;
+    };
+
         /// Get the stream for the type
     Stream* getStream(StdStreamType type) const { return m_streams[Index(type)]; }
 
@@ -61,6 +73,14 @@ public:
         /// Create a process using the executable/args defined from the commandLine
     static SlangResult create(const CommandLine& commandLine, Process::Flags flags, RefPtr<Process>& outProcess);
 
+        /// Write the input to, and read the output from, the standard streams of all of the `ios` processes, on
+        /// the calling thread. Returns once every process has closed its output, or has terminated with nothing
+        /// left to read. The processes must have been created with `create`.
+        ///
+        /// Input is written as the process reads it, so a process writing a lot of output before it has read all of
+        /// its input doesn't deadlock. Where the platform allows, the thread sleeps until one of the pipes is ready.
+    static SlangResult pumpStreams(StreamIO* ios, Count count);
+
         /// Sleep the current thread for time specified in milliseconds. 0 indicates to OS ok to yield this thread.
     static void sleepCurrentThread(Int timeInMs);
 
@@ -12,8 +12,9 @@
 namespace Slang
 {
 
-RiffFileSystem::RiffFileSystem(ICompressionSystem* compressionSystem):
-    m_compressionSystem(compressionSystem)
+RiffFileSystem::RiffFileSystem(ICompressionSystem* compressionSystem, ThreadPool* threadPool):
+    m_compressionSystem(compressionSystem),
+    m_threadPool(threadPool)
 {
 }
 
@@ -32,7 +33,10 @@ void* RiffFileSystem::getInterface(const Guid& guid)
 
 void* RiffFileSystem::getObject(const Guid& guid)
 {
-    SLANG_UNUSED(guid);
+    if (guid == RiffFileSystem::getTypeGuid())
+    {
+        return this;
+    }
     return nullptr;
 }
 
@@ -73,6 +77,99 @@ SlangResult RiffFileSystem::loadFile(char const* path, ISlangBlob** outBlob)
     }
 }
 
+namespace { // anonymous
+
+// Reads ranges of a file compressed with ChunkedLZ4CompressionSystem, decompressing only the blocks that hold them.
+class ChunkedLZ4PayloadSource : public RiffContainer::PayloadSource
+{
+public:
+    virtual SlangResult read(size_t offset, size_t size, void* outData) SLANG_OVERRIDE
+    {
+        if (offset > m_decompressedSize || size > m_decompressedSize - offset)
+        {
+            return SLANG_FAIL;
+        }
+
+        const void* compressed = m_compressed->getBufferPointer();
+        const size_t compressedSize = m_compressed->getBufferSize();
+
+        // Reads of a range that spans blocks decompress straight into the output
+        const size_t blockStart = offset - (offset % m_blockSize);
+        if (offset + size > blockStart + m_blockSize)
+        {
+            return ChunkedLZ4CompressionSystem::decompressRange(compressed, compressedSize, offset, size, outData, m_threadPool);
+        }
+
+        // Chunk headers and small payloads are read one after another from the same block, so keep the
+        // last block read from. Reads may come from several threads, so the cached block is locked while in use.
+        std::lock_guard<std::mutex> lock(m_cachedBlockMutex);
+        if (m_cachedBlock.getCount() == 0 || m_cachedBlockStart != blockStart)
+        {
+            m_cachedBlock.setCount(Math::Min(m_blockSize, m_decompressedSize - blockStart));
+            m_cachedBlockStart = blockStart;
+            if (SLANG_FAILED(ChunkedLZ4CompressionSystem::decompressRange(compressed, compressedSize, blockStart, m_cachedBlock.getCount(), m_cachedBlock.getBuffer())))
+            {
+                m_cachedBlock.clear();
+                return SLANG_FAIL;
+            }
+        }
+        ::memcpy(outData, m_cachedBlock.getBuffer() + (offset - blockStart), size);
+        return SLANG_OK;
+    }
+
+    SlangResult init(ISlangBlob* compressed, size_t decompressedSize, ThreadPool* threadPool)
+    {
+        typedef ChunkedLZ4CompressionSystem::Header Header;
+        Header header;
+        if (compressed->getBufferSize() < sizeof(header))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&header, compressed->getBufferPointer(), sizeof(header));
+        if (header.magic != Header::kMagic || header.blockSize == 0)
+        {
+            return SLANG_FAIL;
+        }
+
+        m_compressed = compressed;
+        m_decompressedSize = decompressedSize;
+        m_blockSize = header.blockSize;
+        m_threadPool = threadPool;
+        return SLANG_OK;
+    }
+
+protected:
+    ComPtr<ISlangBlob> m_compressed;
+    size_t m_decompressedSize = 0;
+    size_t m_blockSize = 0;
+    RefPtr<ThreadPool> m_threadPool;
+
+    std::mutex m_cachedBlockMutex;
+    List<Byte> m_cachedBlock;
+    size_t m_cachedBlockStart = 0;
+};
+
+} // anonymous
+
+SlangResult RiffFileSystem::loadFileRiff(char const* path, RiffContainer& outContainer)
+{
+    Entry* entry;
+    SLANG_RETURN_ON_FAIL(_loadFile(path, &entry));
+
+    if (m_compressionSystem && m_compressionSystem->getSystemType() == CompressionSystemType::ChunkedLZ4)
+    {
+        RefPtr<ChunkedLZ4PayloadSource> source = new ChunkedLZ4PayloadSource;
+        SLANG_RETURN_ON_FAIL(source->init(entry->m_contents, entry->m_uncompressedSizeInBytes, m_threadPool));
+        return RiffUtil::readDeferred(source, entry->m_uncompressedSizeInBytes, outContainer);
+    }
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(loadFile(path, blob.writeRef()));
+
+    MemoryStreamBase stream(FileAccess::Read, blob->getBufferPointer(), blob->getBufferSize());
+    return RiffUtil::read(&stream, outContainer);
+}
+
 SlangResult RiffFileSystem::saveFile(const char* path, const void* data, size_t size)
 {   
     Entry* entry;
@@ -150,6 +247,11 @@ SlangResult RiffFileSystem::loadArchive(const void* archive, size_t archiveSizeI
             m_compressionSystem = LZ4CompressionSystem::getSingleton();
             break;
         }
+        case CompressionSystemType::ChunkedLZ4:
+        {
+            m_compressionSystem = ChunkedLZ4CompressionSystem::create(m_threadPool);
+            break;
+        }
         default: return SLANG_FAIL;
     }
 
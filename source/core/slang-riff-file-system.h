@@ -5,6 +5,7 @@
 #include "slang-memory-file-system.h"
 
 #include "slang-riff.h"
+#include "slang-thread-pool.h"
 
 namespace Slang
 {
@@ -50,6 +51,8 @@ NOTE:
 class RiffFileSystem : public MemoryFileSystem, public IArchiveFileSystem
 {
 public:
+    SLANG_CLASS_GUID(0x38f43999, 0xed86, 0x4147, { 0x80, 0xff, 0x40, 0x9c, 0xac, 0xf6, 0x77, 0x0d })
+
     typedef MemoryFileSystem Super;
 
     // ISlangUnknown 
@@ -70,8 +73,13 @@ public:
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL storeArchive(bool blobOwnsContent, ISlangBlob** outBlob) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW void SLANG_MCALL setCompressionStyle(const CompressionStyle& style) SLANG_OVERRIDE { m_compressionStyle = style; }
 
-        /// Pass in nullptr, if no compression is wanted. 
-    explicit RiffFileSystem(ICompressionSystem* compressionSystem);
+        /// Read the RIFF held in the file at `path` into `outContainer`. With chunked compression, the payload of each
+        /// data chunk is only decompressed when it is first accessed, and `outContainer` keeps the compressed contents.
+    SlangResult loadFileRiff(char const* path, RiffContainer& outContainer);
+
+        /// Pass in nullptr, if no compression is wanted. Chunked compression of archives loaded later
+        /// uses the threads of `threadPool`, if one is passed.
+    explicit RiffFileSystem(ICompressionSystem* compressionSystem, ThreadPool* threadPool = nullptr);
 
         /// True if this appears to be Riff archive
     static bool isArchive(const void* data, size_t sizeInBytes);
@@ -81,6 +89,7 @@ protected:
     void* getObject(const Guid& guid);
 
     ComPtr<ICompressionSystem> m_compressionSystem;
+    RefPtr<ThreadPool> m_threadPool;
 
     CompressionStyle m_compressionStyle;
 };
@@ -365,6 +365,115 @@ struct DumpVisitor : public RiffContainer::Visitor
     return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
 }
 
+/* static */SlangResult RiffUtil::readDeferred(RiffContainer::PayloadSource* source, size_t sizeInBytes, RiffContainer& outContainer)
+{
+    typedef RiffContainer::ScopeChunk ScopeChunk;
+    outContainer.reset();
+    outContainer.setPayloadSource(source);
+
+    size_t offset = 0;
+
+    // Read the header of the chunk at `offset`, and move past it
+    auto readHeaderAtOffset = [&](RiffListHeader& outHeader) -> SlangResult
+    {
+        if (sizeInBytes - offset < sizeof(RiffHeader))
+        {
+            return SLANG_FAIL;
+        }
+        SLANG_RETURN_ON_FAIL(source->read(offset, sizeof(RiffHeader), &outHeader.chunk));
+        offset += sizeof(RiffHeader);
+
+        outHeader.subType = 0;
+        if (isListType(outHeader.chunk.type))
+        {
+            const size_t subTypeSize = sizeof(RiffListHeader) - sizeof(RiffHeader);
+            if (sizeInBytes - offset < subTypeSize)
+            {
+                return SLANG_FAIL;
+            }
+            SLANG_RETURN_ON_FAIL(source->read(offset, subTypeSize, &outHeader.subType));
+            offset += subTypeSize;
+        }
+        return SLANG_OK;
+    };
+
+    size_t remaining;
+    {
+        RiffListHeader header;
+
+        SLANG_RETURN_ON_FAIL(readHeaderAtOffset(header));
+        if (!isListType(header.chunk.type))
+        {
+            return SLANG_FAIL;
+        }
+
+        remaining = getPadSize(header.chunk.size) - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+        outContainer.startChunk(Chunk::Kind::List, header.subType);
+    }
+
+    // Walks the chunks in the same way as `read`, except the payloads of data chunks are skipped over
+    List<size_t> remainingStack;
+    while (true)
+    {
+        if (remaining == 0)
+        {
+            outContainer.endChunk();
+            if (remainingStack.getCount() <= 0)
+            {
+                break;
+            }
+
+            remaining = remainingStack.getLast();
+            remainingStack.removeLast();
+        }
+        else
+        {
+            RiffListHeader header;
+            SLANG_RETURN_ON_FAIL(readHeaderAtOffset(header));
+
+            if (header.chunk.size > remaining)
+            {
+                return SLANG_FAIL;
+            }
+
+            if (header.chunk.type == RiffFourCC::kList)
+            {
+                if (header.chunk.size & kRiffPadMask)
+                {
+                    SLANG_ASSERT(!"A list chunk can only have divisible by 2 size");
+                    return SLANG_FAIL;
+                }
+
+                const size_t padSize = getPadSize(header.chunk.size);
+
+                remaining -= sizeof(RiffHeader) + padSize;
+                remainingStack.add(remaining);
+
+                remaining = padSize - (sizeof(RiffListHeader) - sizeof(RiffHeader));
+
+                outContainer.startChunk(Chunk::Kind::List, header.subType);
+            }
+            else
+            {
+                const size_t padSize = getPadSize(header.chunk.size);
+                if (sizeInBytes - offset < padSize)
+                {
+                    return SLANG_FAIL;
+                }
+
+                ScopeChunk scopeChunk(&outContainer, Chunk::Kind::Data, header.chunk.type);
+                RiffContainer::Data* data = outContainer.addData();
+                outContainer.setDeferred(data, offset, header.chunk.size);
+
+                offset += padSize;
+                remaining -= sizeof(RiffHeader) + padSize;
+            }
+        }
+    }
+
+    return outContainer.isFullyConstructed() ? SLANG_OK : SLANG_FAIL;
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RiffContainer::Chunk !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 SlangResult RiffContainer::Chunk::visit(Visitor* visitor)
@@ -694,6 +803,7 @@ RiffContainer::RiffContainer() :
 void RiffContainer::reset()
 {
     m_arena.reset();
+    m_payloadSource.setNull();
 
     m_rootList = nullptr;
     m_listChunk = nullptr;
@@ -868,6 +978,40 @@ void RiffContainer::setUnowned(Data* data, void* payload, size_t size)
     data->m_payload = payload;
 }
 
+void RiffContainer::setDeferred(Data* data, size_t sourceOffset, size_t size)
+{
+    // We must be in a data chunk
+    SLANG_ASSERT(m_dataChunk);
+    // The data shouldn't be set up
+    SLANG_ASSERT(data->m_ownership == Ownership::Uninitialized);
+
+    // Add current chunks data
+    m_dataChunk->m_payloadSize += size;
+
+    data->m_ownership = Ownership::Deferred;
+    data->m_size = size;
+    data->m_container = this;
+    data->m_sourceOffset = sourceOffset;
+}
+
+void RiffContainer::Data::_readDeferredPayload()
+{
+    SLANG_ASSERT(m_ownership == Ownership::Deferred);
+
+    PayloadSource* source = m_container->m_payloadSource;
+    void* payload = m_container->m_arena.allocateAligned(m_size ? m_size : 1, kPayloadMinAlignment);
+    if (!source || SLANG_FAILED(source->read(m_sourceOffset, m_size, payload)))
+    {
+        // Leave the data empty, so it isn't read again
+        m_ownership = Ownership::Uninitialized;
+        m_payload = nullptr;
+        return;
+    }
+
+    m_ownership = Ownership::Arena;
+    m_payload = payload;
+}
+
 RiffContainer::Data* RiffContainer::addData()
 {
     // We must be in a chunk
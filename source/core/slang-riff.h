@@ -196,14 +196,30 @@ public:
         NotOwned,           ///< It's not owned by the container
         Arena,              ///< It's owned and allocated on the arena
         Owned,              ///< It's owned, but wasn't allocated on the arena
+        Deferred,           ///< It's read from the container's payload source into the arena when first accessed
+    };
+
+        /// Supplies the payloads of data chunks that are only read when they are first accessed
+    class PayloadSource : public RefObject
+    {
+    public:
+            /// Read `size` bytes starting at `offset` into `outData`
+        virtual SlangResult read(size_t offset, size_t size, void* outData) = 0;
     };
 
     struct Data
     {
-            /// Get the payload
-        void* getPayload() { return m_payload; }
+            /// Get the payload. A deferred payload is read when first accessed, and is nullptr if it can't be read.
+        void* getPayload()
+        {
+            if (m_ownership == Ownership::Deferred)
+            {
+                _readDeferredPayload();
+            }
+            return m_payload;
+        }
             /// Get the end pointer
-        void* getPayloadEnd() { return (void*)((uint8_t*)m_payload + m_size); }
+        void* getPayloadEnd() { return (void*)((uint8_t*)getPayload() + m_size); }
             /// Get the size of the payload
         size_t getSize() const { return m_size; }
             /// Get the ownership of the data held in the payload
@@ -215,12 +231,19 @@ public:
             m_size = 0;
             m_next = nullptr;
             m_payload = nullptr;
+            m_container = nullptr;
+            m_sourceOffset = 0;
         }
 
+        void _readDeferredPayload();
+
         Ownership m_ownership;          ///< Stores the ownership of the payload
         size_t m_size;                  ///< The size of the payload
         void* m_payload;                ///< The payload
         Data* m_next;                   ///< The next Data block in the list
+
+        RiffContainer* m_container;     ///< For a deferred payload, the container whose payload source holds it
+        size_t m_sourceOffset;          ///< For a deferred payload, its offset in the payload source
     };
 
     struct Chunk;
@@ -390,6 +413,14 @@ public:
     void moveOwned(Data* data, void* payload, size_t size);
         /// Move unowned. The payload scope must last longer than the RiffContainer
     void setUnowned(Data* data, void* payload, size_t size);
+        /// Set the payload to be the `size` bytes at `sourceOffset` in the payload source, read when first accessed.
+    void setDeferred(Data* data, size_t sourceOffset, size_t size);
+
+        /// Set the source deferred payloads are read from. Deferred payloads are read on the thread that accesses
+        /// them, so like the rest of the container, they can't be accessed concurrently.
+    void setPayloadSource(PayloadSource* source) { m_payloadSource = source; }
+        /// Get the source deferred payloads are read from
+    PayloadSource* getPayloadSource() const { return m_payloadSource; }
 
         /// End a chunk
     void endChunk();
@@ -432,6 +463,8 @@ protected:
     DataChunk* m_dataChunk;
 
     MemoryArena m_arena;            ///< Can be used to use other owned blocks
+
+    RefPtr<PayloadSource> m_payloadSource;  ///< Where deferred payloads are read from
 };
 
 // -----------------------------------------------------------------------------
@@ -483,6 +516,10 @@ struct RiffUtil
 
         /// Read the stream into the container
     static SlangResult read(Stream* stream, RiffContainer& outContainer);
+
+        /// Read the chunk structure of the RIFF held in `source`, which is `sizeInBytes` long, into the container.
+        /// The payload of each data chunk is only read from `source` when it is first accessed.
+    static SlangResult readDeferred(RiffContainer::PayloadSource* source, size_t sizeInBytes, RiffContainer& outContainer);
 };
 
 }
@@ -2,7 +2,6 @@
 #ifdef _WIN32
 #include <share.h>
 #endif
-#include <thread>
 #include "slang-io.h"
 #include "slang-process.h"
 
@@ -588,33 +587,6 @@ SlangResult BufferedReadStream::readUntilContains(size_t size)
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!! StreamUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-SlangResult StreamUtil::readAndWrite(
-    Stream* writeStream,
-    ArrayView<Byte> bytesToWrite,
-    Stream* readStream, List<Byte>& outReadBytes,
-    Stream* errStream,
-    List<Byte>& outErrBytes)
-{
-    std::thread writeThread([&]()
-        {
-            writeStream->write(bytesToWrite.getBuffer(), (size_t)bytesToWrite.getCount());
-            writeStream->close();
-        });
-    SlangResult readResult = SLANG_OK;
-    std::thread readThread([&]()
-        {
-            readResult = readAll(readStream, 1024, outReadBytes);
-        });
-    std::thread readErrThread([&]()
-        {
-            readAll(errStream, 1024, outErrBytes);
-        });
-    writeThread.join();
-    readThread.join();
-    readErrThread.join();
-    return readResult;
-}
-
 /* static */SlangResult StreamUtil::readAll(Stream* stream, size_t readSize, List<Byte>& ioBytes)
 {
     while (!stream->isEnd())
@@ -627,7 +599,7 @@ SlangResult StreamUtil::readAndWrite(
 
 /* static */SlangResult StreamUtil::read(Stream* stream, size_t readSize, List<Byte>& ioBytes)
 {
-    readSize = (readSize <= 0) ? 1024 : readSize;
+    readSize = (readSize <= 0) ? kMinReadSize : readSize;
 
     while (true)
     {
@@ -642,6 +614,8 @@ SlangResult StreamUtil::readAndWrite(
         {
             return SLANG_OK;
         }
+
+        readSize = calcNextReadSize(readSize, readBytesCount);
     }
 }
 
@@ -256,14 +256,23 @@ enum class StreamBufferStyle
 
 struct StreamUtil
 {
-        // Write inputs to writeStream while simultaneously read from readStream and errStream.
-    static SlangResult readAndWrite(Stream* writeStream, ArrayView<Byte> bytesToWrite, Stream* readStream, List<Byte>& outReadBytes, Stream* errStream, List<Byte>& outErrBytes);
+        /// The read size used when none is specified.
+    static const size_t kMinReadSize = 4 * 1024;
+        /// The largest a read size grows to.
+    static const size_t kMaxReadSize = 256 * 1024;
+
+        /// Get the size for the next read, given the last read of `readSize` read `readCount` bytes.
+        /// Grows the size when reads are being filled, such that large outputs take fewer reads.
+    static size_t calcNextReadSize(size_t readSize, size_t readCount)
+    {
+        return (readCount >= readSize && readSize < kMaxReadSize) ? readSize * 2 : readSize;
+    }
 
         /// Appends all bytes that can be read from stream into bytes
     static SlangResult readAll(Stream* stream, size_t readSize, List<Byte>& ioBytes);
 
         /// Read as much as can be read until a 0 sized read, or an error and append onto ioBytes
-        /// Read size controls the size of each buffer read. Passing 0, will use the default read size.
+        /// Read size controls the size of the first buffer read. Passing 0, will use the default read size.
     static SlangResult read(Stream* stream, size_t readSize, List<Byte>& ioBytes);
 
     static SlangResult discard(Stream* stream);
@@ -106,6 +106,9 @@ public:
         /// Get the index of the first added handle
     Index getFirstAddedIndex() const { return m_style == Style::Default ? kDefaultHandlesCount : 0; }
 
+        /// Get the arena that holds the contents of the added slices
+    const MemoryArena& getArena() const { return m_arena; }
+
         /// Swap this with rhs
     void swapWith(ThisType& rhs);
 
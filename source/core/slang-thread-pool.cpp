@@ -0,0 +1,166 @@
+#include "slang-thread-pool.h"
+
+#include <atomic>
+#include <exception>
+
+namespace Slang
+{
+
+struct ThreadPool::Loop
+{
+    IterationFunc func;
+    Index count = 0;
+
+    std::atomic<Index> nextIndex{0};
+
+    std::mutex mutex;
+    std::condition_variable finished;
+        /// Once closed, workers can no longer join the loop
+    bool isClosed = false;
+    Index joinedWorkerCount = 0;
+    Index activeWorkerCount = 0;
+    std::exception_ptr exception;
+};
+
+/* static */Index ThreadPool::getHardwareThreadCount()
+{
+    const Index count = Index(std::thread::hardware_concurrency());
+    return count > 0 ? count : 1;
+}
+
+ThreadPool::ThreadPool(Index workerCount)
+{
+    for (Index i = 0; i < workerCount; ++i)
+    {
+        m_workers.add(std::thread([this]() { _workerMain(); }));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_loopAvailable.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+/* static */void ThreadPool::_runIterations(Loop& loop, Index threadSlot)
+{
+    for (;;)
+    {
+        const Index index = loop.nextIndex.fetch_add(1);
+        if (index >= loop.count)
+        {
+            break;
+        }
+
+        try
+        {
+            loop.func(index, threadSlot);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(loop.mutex);
+            if (!loop.exception)
+            {
+                loop.exception = std::current_exception();
+            }
+        }
+    }
+}
+
+/* static */void ThreadPool::_joinLoop(std::shared_ptr<Loop> const& loop)
+{
+    Index threadSlot = 0;
+    {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        // If the loop's thread already finished it, there is nothing to do
+        if (loop->isClosed)
+        {
+            return;
+        }
+        threadSlot = ++loop->joinedWorkerCount;
+        loop->activeWorkerCount++;
+    }
+
+    _runIterations(*loop, threadSlot);
+
+    {
+        std::lock_guard<std::mutex> lock(loop->mutex);
+        loop->activeWorkerCount--;
+    }
+    loop->finished.notify_all();
+}
+
+void ThreadPool::_workerMain()
+{
+    for (;;)
+    {
+        std::shared_ptr<Loop> loop;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_loopAvailable.wait(lock, [this]() { return m_isStopping || m_pendingJoins.getCount() > 0; });
+            if (m_pendingJoins.getCount() == 0)
+            {
+                return;
+            }
+            loop = m_pendingJoins[0];
+            m_pendingJoins.removeAt(0);
+        }
+        _joinLoop(loop);
+    }
+}
+
+void ThreadPool::forEach(Index count, Index maxThreadCount, IterationFunc const& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+
+    const Index workerCount = Math::Min(Math::Min(maxThreadCount - 1, count - 1), m_workers.getCount());
+    if (workerCount <= 0)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            func(i, 0);
+        }
+        return;
+    }
+
+    auto loop = std::make_shared<Loop>();
+    loop->func = func;
+    loop->count = count;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Index i = 0; i < workerCount; ++i)
+        {
+            m_pendingJoins.add(loop);
+        }
+    }
+    m_loopAvailable.notify_all();
+
+    _runIterations(*loop, 0);
+
+    {
+        std::unique_lock<std::mutex> lock(loop->mutex);
+        // Workers that haven't joined yet will find the loop closed, so only the
+        // ones still running iterations need to be waited for.
+        loop->isClosed = true;
+        loop->finished.wait(lock, [&]() { return loop->activeWorkerCount == 0; });
+    }
+
+    if (loop->exception)
+    {
+        std::rethrow_exception(loop->exception);
+    }
+}
+
+} // namespace Slang
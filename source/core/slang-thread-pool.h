@@ -0,0 +1,65 @@
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-basic.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// A fixed set of worker threads used to run the iterations of parallel loops.
+///
+/// The thread that starts a loop runs iterations as well, and only waits for the workers that
+/// have joined the loop. A loop therefore always completes, even when all workers are busy,
+/// and loops can be started from within the iterations of another loop.
+class ThreadPool : public RefObject
+{
+public:
+        /// Called for each iteration of a loop. `threadSlot` identifies the thread running the
+        /// iteration within the loop: it is 0 for the calling thread, and is always less than the
+        /// `maxThreadCount` passed to `forEach`, so it can be used to index per-thread state.
+    typedef std::function<void(Index index, Index threadSlot)> IterationFunc;
+
+        /// Run `func` for each index in [0, count) using at most `maxThreadCount` threads,
+        /// including the calling thread, and return once all iterations have completed.
+        ///
+        /// Iterations may run in any order. If an iteration throws, the remaining iterations
+        /// still run, and the first exception caught is rethrown on the calling thread.
+    void forEach(Index count, Index maxThreadCount, IterationFunc const& func);
+
+        /// Get the number of worker threads in the pool
+    Index getWorkerCount() const { return m_workers.getCount(); }
+
+        /// Get the number of threads the hardware can run at the same time (at least 1)
+    static Index getHardwareThreadCount();
+
+        /// Ctor. With a `workerCount` of 0, all loops run on the calling thread.
+    explicit ThreadPool(Index workerCount);
+        /// Dtor. Waits for the worker threads to exit.
+    ~ThreadPool();
+
+protected:
+    struct Loop;
+
+    void _workerMain();
+
+    static void _runIterations(Loop& loop, Index threadSlot);
+    static void _joinLoop(std::shared_ptr<Loop> const& loop);
+
+    std::mutex m_mutex;
+    std::condition_variable m_loopAvailable;
+        /// One entry for each worker that may join a loop, in the order they were requested
+    List<std::shared_ptr<Loop>> m_pendingJoins;
+    bool m_isStopping = false;
+
+    List<std::thread> m_workers;
+};
+
+} // namespace Slang
+
+#endif
@@ -150,6 +150,13 @@ static const NamesDescriptionValue s_debugLevels[] =
     { SLANG_DEBUG_INFO_LEVEL_MAXIMAL,   "3,maximal",    "Emit as much debug information as possible for each target." },
 };
 
+static const NamesDescriptionValue s_debugInfoSourceModes[] =
+{
+    { SLANG_DEBUG_INFO_SOURCE_MODE_EMBED,   "embed",    "Embed the text of each source file, where the debug information format allows it." },
+    { SLANG_DEBUG_INFO_SOURCE_MODE_PATH,    "path",     "Only refer to each source file by its path." },
+    { SLANG_DEBUG_INFO_SOURCE_MODE_HASH,    "hash",     "Refer to each source file by its path, with a hash of its text in place of the text." },
+};
+
 static const NamesDescriptionValue s_fileSystemTypes[] =
 {
     { ValueInt(TypeTextUtil::FileSystemType::Default),     "default",      "Default file system." },
@@ -209,6 +216,11 @@ static const NamesDescriptionValue s_fileSystemTypes[] =
     return makeConstArrayView(s_debugLevels);
 }
 
+/* static */ConstArrayView<NamesDescriptionValue> TypeTextUtil::getDebugInfoSourceModeInfos()
+{
+    return makeConstArrayView(s_debugInfoSourceModes);
+}
+
 /* static */SlangArchiveType TypeTextUtil::findArchiveType(const UnownedStringSlice& slice)
 {
     return NameValueUtil::findValue(getArchiveTypeInfos(), slice, SLANG_ARCHIVE_TYPE_UNDEFINED);
@@ -41,6 +41,8 @@ struct TypeTextUtil
     static ConstArrayView<NamesDescriptionValue> getDebugInfoFormatInfos();
         /// Get the debug levels
     static ConstArrayView<NamesDescriptionValue> getDebugLevelInfos();
+        /// Get the ways debug information can refer to source files
+    static ConstArrayView<NamesDescriptionValue> getDebugInfoSourceModeInfos();
         /// Get the floating point modes
     static ConstArrayView<NamesDescriptionValue> getFloatingPointModeInfos();
         // Get the line directive infos
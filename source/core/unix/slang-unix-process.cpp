@@ -63,6 +63,18 @@ public:
     virtual void close() SLANG_OVERRIDE;
     virtual SlangResult flush() SLANG_OVERRIDE;
 
+        /// Get the file descriptor. Is -1 if the stream is closed.
+    int getFileDescriptor() const { return m_fd; }
+
+        /// Make writes non blocking, such that a write only writes what fits in the pipe.
+    void setWriteNonBlocking()
+    {
+        if (_has(FileAccess::Write) && !m_isClosed)
+        {
+            fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK);
+        }
+    }
+
     UnixPipeStream(int fd, FileAccess access, bool isOwned) :
         m_fd(fd),
         m_access(access),
@@ -355,6 +367,158 @@ SlangResult UnixPipeStream::write(const void* buffer, size_t length)
 
 /* !!!!!!!!!!!!!!!!!!!!!! Process !!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
+/* static */SlangResult Process::pumpStreams(StreamIO* ios, Count count)
+{
+    // The state of a pipe being pumped
+    struct Pipe
+    {
+        Process* process;
+        UnixPipeStream* stream;
+        ConstArrayView<Byte> input;     ///< The input, if the pipe is a process' standard input
+        size_t writtenCount;
+        List<Byte>* output;             ///< If nullptr and not input, the output is discarded
+        size_t readSize;
+        bool isInput;
+    };
+
+    List<Pipe> pipes;
+    for (Index i = 0; i < count; ++i)
+    {
+        auto& io = ios[i];
+
+        auto inStream = static_cast<UnixPipeStream*>(io.process->getStream(StdStreamType::In));
+        if (io.writeInput && inStream && inStream->canWrite())
+        {
+            if (io.input.getCount() == 0)
+            {
+                inStream->close();
+            }
+            else
+            {
+                inStream->setWriteNonBlocking();
+                pipes.add(Pipe{ io.process, inStream, io.input, 0, nullptr, 0, true });
+            }
+        }
+
+        const StdStreamType outTypes[] = { StdStreamType::Out, StdStreamType::ErrorOut };
+        List<Byte>* outputs[] = { io.output, io.errorOutput };
+        for (Index j = 0; j < SLANG_COUNT_OF(outTypes); ++j)
+        {
+            auto outStream = static_cast<UnixPipeStream*>(io.process->getStream(outTypes[j]));
+            if (outStream && outStream->canRead())
+            {
+                pipes.add(Pipe{ io.process, outStream, ConstArrayView<Byte>(), 0, outputs[j], StreamUtil::kMinReadSize, false });
+            }
+        }
+    }
+
+    // Holds output that is being discarded
+    List<Byte> discardBuffer;
+
+    // How long to wait for a pipe, before checking if a process has terminated without closing its output
+    // (for example because it has started a process that holds onto it).
+    const int pollTimeOutInMs = 100;
+
+    List<pollfd> pollInfos;
+    while (pipes.getCount())
+    {
+        pollInfos.setCount(pipes.getCount());
+        for (Index i = 0; i < pipes.getCount(); ++i)
+        {
+            auto& pollInfo = pollInfos[i];
+            pollInfo.fd = pipes[i].stream->getFileDescriptor();
+            pollInfo.events = pipes[i].isInput ? POLLOUT : POLLIN;
+            pollInfo.revents = 0;
+        }
+
+        const int pollResult = ::poll(pollInfos.getBuffer(), nfds_t(pollInfos.getCount()), pollTimeOutInMs);
+        if (pollResult < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            return SLANG_FAIL;
+        }
+
+        // Go backwards, so a pipe that is done can be removed from the list.
+        // Removing swaps the last pipe into its place, which has already been handled.
+        for (Index i = pipes.getCount() - 1; i >= 0; --i)
+        {
+            auto& pipe = pipes[i];
+            const auto revents = pollInfos[i].revents;
+
+            bool isDone = false;
+            if (revents == 0)
+            {
+                // If nothing happened before the time out and the process has terminated there can't be
+                // anything more to come. The process may have written to the pipe after the poll and then
+                // terminated though, so check the pipe again, without waiting, now it's known to have terminated.
+                if (pollResult == 0 && pipe.process->isTerminated())
+                {
+                    pollfd pollInfo = pollInfos[i];
+                    pollInfo.revents = 0;
+                    isDone = (::poll(&pollInfo, 1, 0) == 0);
+                }
+            }
+            else if (pipe.isInput)
+            {
+                if (revents & (POLLERR | POLLHUP | POLLNVAL))
+                {
+                    // The process has closed its input
+                    isDone = true;
+                }
+                else
+                {
+                    const size_t remainingCount = size_t(pipe.input.getCount()) - pipe.writtenCount;
+                    const ssize_t writeCount = ::write(pipe.stream->getFileDescriptor(), pipe.input.getBuffer() + pipe.writtenCount, remainingCount);
+                    if (writeCount < 0)
+                    {
+                        isDone = (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                    }
+                    else
+                    {
+                        pipe.writtenCount += size_t(writeCount);
+                        isDone = (pipe.writtenCount == size_t(pipe.input.getCount()));
+                    }
+                }
+            }
+            else
+            {
+                // Read directly into the output.
+                List<Byte>& dst = pipe.output ? *pipe.output : discardBuffer;
+                const Index prevCount = pipe.output ? dst.getCount() : 0;
+                dst.setCount(prevCount + Index(pipe.readSize));
+
+                const ssize_t readCount = ::read(pipe.stream->getFileDescriptor(), dst.getBuffer() + prevCount, pipe.readSize);
+
+                dst.setCount(prevCount + Index(readCount > 0 ? readCount : 0));
+                if (readCount > 0)
+                {
+                    pipe.readSize = StreamUtil::calcNextReadSize(pipe.readSize, size_t(readCount));
+                }
+                else if (readCount == 0)
+                {
+                    // End of file, the process has closed its output
+                    isDone = true;
+                }
+                else
+                {
+                    isDone = (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+                }
+            }
+
+            if (isDone)
+            {
+                pipe.stream->close();
+                pipes.fastRemoveAt(i);
+            }
+        }
+    }
+
+    return SLANG_OK;
+}
+
 /* static */UnownedStringSlice Process::getExecutableSuffix()
 {
 #if __CYGWIN__
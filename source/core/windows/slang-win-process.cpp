@@ -89,6 +89,9 @@ public:
 
     ~WinPipeStream() { close(); }
 
+        /// Get the handle. Is nullptr if the stream is closed.
+    HANDLE getHandle() const { return m_streamHandle; }
+
 protected:
 
     bool _has(FileAccess access) const { return (Index(access) & Index(m_access)) != 0; }
@@ -357,6 +360,152 @@ void WinProcess::kill(int32_t returnCode)
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
+/* static */SlangResult Process::pumpStreams(StreamIO* ios, Count count)
+{
+    // The anonymous pipes made by `create` don't support overlapped IO, so instead 
+    // * Reads only read what `PeekNamedPipe` says is available, so never block
+    // * The input is made non blocking, so a write only writes what fits in the pipe
+    // The thread sleeps only when none of the pipes made progress.
+
+    // The state of a pipe being pumped
+    struct Pipe
+    {
+        Process* process;
+        WinPipeStream* stream;
+        ConstArrayView<Byte> input;     ///< The input, if the pipe is a process' standard input
+        size_t writtenCount;
+        List<Byte>* output;             ///< If nullptr and not input, the output is discarded
+        size_t readSize;
+        bool isInput;
+    };
+
+    List<Pipe> pipes;
+    for (Index i = 0; i < count; ++i)
+    {
+        auto& io = ios[i];
+
+        auto inStream = static_cast<WinPipeStream*>(io.process->getStream(StdStreamType::In));
+        if (io.writeInput && inStream && inStream->canWrite())
+        {
+            DWORD mode = PIPE_READMODE_BYTE | PIPE_NOWAIT;
+            if (io.input.getCount() == 0 || !::SetNamedPipeHandleState(inStream->getHandle(), &mode, nullptr, nullptr))
+            {
+                // If it can't be made non blocking, write it all up front. This can only block if the process
+                // writes more output than fits in its pipes before reading all of its input.
+                inStream->write(io.input.getBuffer(), size_t(io.input.getCount()));
+                inStream->close();
+            }
+            else
+            {
+                pipes.add(Pipe{ io.process, inStream, io.input, 0, nullptr, 0, true });
+            }
+        }
+
+        const StdStreamType outTypes[] = { StdStreamType::Out, StdStreamType::ErrorOut };
+        List<Byte>* outputs[] = { io.output, io.errorOutput };
+        for (Index j = 0; j < SLANG_COUNT_OF(outTypes); ++j)
+        {
+            auto outStream = static_cast<WinPipeStream*>(io.process->getStream(outTypes[j]));
+            if (outStream && outStream->canRead())
+            {
+                pipes.add(Pipe{ io.process, outStream, ConstArrayView<Byte>(), 0, outputs[j], StreamUtil::kMinReadSize, false });
+            }
+        }
+    }
+
+    // Holds output that is being discarded
+    List<Byte> discardBuffer;
+
+    // The number of passes in a row where no pipe made progress
+    Index idleCount = 0;
+
+    while (pipes.getCount())
+    {
+        bool hasProgress = false;
+
+        // Go backwards, so a pipe that is done can be removed from the list
+        for (Index i = pipes.getCount() - 1; i >= 0; --i)
+        {
+            auto& pipe = pipes[i];
+            const HANDLE handle = pipe.stream->getHandle();
+
+            bool isDone = false;
+            if (pipe.isInput)
+            {
+                const DWORD remainingCount = DWORD(size_t(pipe.input.getCount()) - pipe.writtenCount);
+                DWORD writtenCount = 0;
+                if (!::WriteFile(handle, pipe.input.getBuffer() + pipe.writtenCount, remainingCount, &writtenCount, nullptr))
+                {
+                    // The process has closed its input, or something has gone wrong
+                    isDone = true;
+                }
+                else
+                {
+                    pipe.writtenCount += writtenCount;
+                    hasProgress = hasProgress || writtenCount > 0;
+                    isDone = (pipe.writtenCount == size_t(pipe.input.getCount()));
+                }
+            }
+            else
+            {
+                DWORD availableCount = 0;
+                if (!::PeekNamedPipe(handle, nullptr, 0, nullptr, &availableCount, nullptr))
+                {
+                    // Typically ERROR_BROKEN_PIPE, meaning the process has closed its output
+                    isDone = true;
+                }
+                else if (availableCount > 0)
+                {
+                    while (size_t(availableCount) > pipe.readSize && pipe.readSize < StreamUtil::kMaxReadSize)
+                    {
+                        pipe.readSize = StreamUtil::calcNextReadSize(pipe.readSize, pipe.readSize);
+                    }
+                    const DWORD readSize = DWORD((size_t(availableCount) < pipe.readSize) ? size_t(availableCount) : pipe.readSize);
+
+                    List<Byte>& dst = pipe.output ? *pipe.output : discardBuffer;
+                    const Index prevCount = pipe.output ? dst.getCount() : 0;
+                    dst.setCount(prevCount + Index(readSize));
+
+                    DWORD readCount = 0;
+                    const BOOL readResult = ::ReadFile(handle, dst.getBuffer() + prevCount, readSize, &readCount, nullptr);
+                    dst.setCount(prevCount + Index(readCount));
+
+                    hasProgress = hasProgress || readCount > 0;
+                    isDone = !readResult;
+                }
+                else if (pipe.process->isTerminated())
+                {
+                    // If the process has terminated and there is nothing to read, there can't be anything
+                    // more to come, even if a process it started holds onto the pipe. The process may have
+                    // written to the pipe after the peek and then terminated though, so peek again now it's
+                    // known to have terminated.
+                    isDone = !::PeekNamedPipe(handle, nullptr, 0, nullptr, &availableCount, nullptr) || availableCount == 0;
+                }
+            }
+
+            if (isDone)
+            {
+                pipe.stream->close();
+                pipes.fastRemoveAt(i);
+                hasProgress = true;
+            }
+        }
+
+        if (hasProgress)
+        {
+            idleCount = 0;
+        }
+        else
+        {
+            // Yield at first, then sleep so an idle wait doesn't use a whole core
+            sleepCurrentThread(idleCount < 16 ? 0 : 1);
+            idleCount++;
+        }
+    }
+
+    return SLANG_OK;
+}
+
 /* static */StringEscapeHandler* Process::getEscapeHandler()
 {
     return StringEscapeUtil::getHandler(StringEscapeUtil::Style::Space);
@@ -222,11 +222,20 @@ namespace SlangRecord
         CASE(SaveStdLibBinSource);
         CASE(TrackLiveness);
         CASE(LoopInversion);
+        CASE(ReportMemory);
+        CASE(Permutation);
+        CASE(CheckJobs);
+        CASE(EmitCompactSource);
+        CASE(DebugInformationSource);
+        CASE(DebugInformationLineTablesOnly);
+        CASE(DownstreamJobs);
+        CASE(DownstreamCache);
         CASE(CountOfParsableOptions);
         CASE(DebugInformationFormat);
         CASE(VulkanBindShiftAll);
         CASE(GenerateWholeProgram);
         CASE(UseUpToDateBinaryModule);
+        CASE(ModuleMemoryBudget);
         CASE(CountOf);
         default:
             Slang::StringBuilder str;
@@ -1,16 +1,17 @@
 #include "slang-ast-base.h"
 #include "slang-ast-builder.h"
 
+#include <atomic>
+
 namespace Slang
 {
     void NodeBase::_initDebug(ASTNodeType inAstNodeType, ASTBuilder* inAstBuilder)
     {
 #ifdef _DEBUG
         SLANG_UNUSED(inAstNodeType);
-        static int32_t uidCounter = 0;
+        static std::atomic<int32_t> uidCounter{0};
         static int32_t breakValue = 0;
-        uidCounter++;
-        _debugUID = uidCounter;
+        _debugUID = ++uidCounter;
         if (inAstBuilder->getId() == -1)
             _debugUID = -_debugUID;
         if (breakValue != 0 && _debugUID == breakValue)
@@ -27,6 +28,10 @@ namespace Slang
             const Index currentEpoch = astBuilder->getEpoch();
             if (currentEpoch != m_defaultDeclRefEpoch || !m_defaultDeclRef)
             {
+                // Other threads may be reading this decl, so a worker builder doesn't cache
+                // the decl-ref, and looks it up again each time instead.
+                if (astBuilder->isWorker())
+                    return astBuilder->getOrCreate<DirectDeclRef>(this);
                 m_defaultDeclRef = astBuilder->getOrCreate<DirectDeclRef>(this);
                 m_defaultDeclRefEpoch = currentEpoch;
             }
@@ -461,11 +461,17 @@ class Val : public NodeBase
     // Private use by stdlib deserialization only. Since we know the Vals serialized into stdlib is already
     // unique, we can just use `this` pointer as the `m_resolvedVal` so we don't need to resolve them again.
     void _setUnique();
+
+    // Private use by `ASTBuilder` deduplication only. The hash code of the `ValNodeDesc` the node was
+    // created from, stored so that the deduplication cache doesn't need to rehash the operands.
+    HashCode _getDescHashCode() const { return m_descHashCode; }
+    void _setDescHashCode(HashCode hashCode) { m_descHashCode = hashCode; }
 protected:
     Val* defaultResolveImpl();
 private:
     mutable Val* m_resolvedVal = nullptr;
     SLANG_UNREFLECTED mutable Index m_resolvedValEpoch = 0;
+    SLANG_UNREFLECTED HashCode m_descHashCode = 0;
 };
 
 template<int N, typename T, typename... Ts>
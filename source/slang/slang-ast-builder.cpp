@@ -170,6 +170,30 @@ Type* SharedASTBuilder::getOverloadedType()
     return m_overloadedType;
 }
 
+void SharedASTBuilder::createLazyTypes()
+{
+    // Types for a magic decl can only be created once the module declaring it is loaded
+    if (tryFindMagicDecl("StringType"))
+        getStringType();
+    if (tryFindMagicDecl("NativeStringType"))
+        getNativeStringType();
+    if (tryFindMagicDecl("EnumTypeType"))
+        getEnumTypeType();
+    if (tryFindMagicDecl("DynamicType"))
+        getDynamicType();
+    if (tryFindMagicDecl("NullPtrType"))
+        getNullPtrType();
+    if (tryFindMagicDecl("NoneType"))
+        getNoneType();
+    if (tryFindMagicDecl("DifferentiableType"))
+        getDiffInterfaceType();
+
+    getErrorType();
+    getBottomType();
+    getInitializerListType();
+    getOverloadedType();
+}
+
 SharedASTBuilder::~SharedASTBuilder()
 {
     // Release built in types..
@@ -219,6 +243,113 @@ Decl* SharedASTBuilder::tryFindMagicDecl(const String& name)
     return d ? *d : nullptr;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ValNodeCache !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+Val* ValNodeCache::_findInShard(ValNodeDesc const& desc)
+{
+    auto& shard = m_shards[_getShardIndex(desc.getHashCode())];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (auto found = shard.nodes.tryGetValue(desc))
+        return *found;
+    return nullptr;
+}
+
+Val* ValNodeCache::find(ValNodeDesc const& desc)
+{
+    auto& shard = m_shards[_getShardIndex(desc.getHashCode())];
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.lookupCount++;
+        if (auto found = shard.nodes.tryGetValue(desc))
+        {
+            shard.hitCount++;
+            return *found;
+        }
+    }
+
+    // The parent doesn't count lookups made on behalf of its children,
+    // so that its statistics only reflect its own use.
+    for (auto parent = m_parent; parent; parent = parent->m_parent)
+    {
+        if (auto found = parent->_findInShard(desc))
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.hitCount++;
+            return found;
+        }
+    }
+    return nullptr;
+}
+
+Val* ValNodeCache::addOrFind(Val* node)
+{
+    ValKey key(node);
+    auto& shard = m_shards[_getShardIndex(key.getHashCode())];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if (auto found = shard.nodes.tryGetValueOrAdd(key, node))
+        return *found;
+    return node;
+}
+
+ValNodeCache::Stats ValNodeCache::getStats()
+{
+    Stats stats;
+    stats.shardCount = kShardCount;
+    for (auto& shard : m_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const Index shardNodeCount = Index(shard.nodes.getCount());
+        stats.nodeCount += shardNodeCount;
+        stats.largestShardNodeCount = Math::Max(stats.largestShardNodeCount, shardNodeCount);
+        stats.lookupCount += shard.lookupCount;
+        stats.hitCount += shard.hitCount;
+    }
+    return stats;
+}
+
+Index ValNodeCache::removeNodesReferencing(MemoryArena const& arena)
+{
+    HashSet<NodeBase*> removedNodes;
+    auto refersToRemovedNode = [&](Val* node)
+    {
+        for (auto& operand : node->m_operands)
+        {
+            if (operand.kind == ValNodeOperandKind::ConstantValue)
+                continue;
+            auto operandNode = operand.values.nodeOperand;
+            if (operandNode && (removedNodes.contains(operandNode) || arena.isValid(operandNode, 1)))
+                return true;
+        }
+        return false;
+    };
+
+    // A node can refer to the arena through a node in another shard, which may not have
+    // been removed yet, so the shards are visited until nothing more is removed.
+    for (;;)
+    {
+        const auto previousRemovedCount = removedNodes.getCount();
+        for (auto& shard : m_shards)
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            List<ValKey> keysToRemove;
+            for (auto& [key, node] : shard.nodes)
+            {
+                if (!removedNodes.contains(node) && refersToRemovedNode(node))
+                {
+                    keysToRemove.add(key);
+                    removedNodes.add(node);
+                }
+            }
+            for (auto& key : keysToRemove)
+                shard.nodes.remove(key);
+        }
+        if (removedNodes.getCount() == previousRemovedCount)
+            break;
+    }
+    return removedNodes.getCount();
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! ASTBuilder !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 ASTBuilder::ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name):
@@ -228,9 +359,41 @@ ASTBuilder::ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name):
     m_arena(2097152)
 {
     SLANG_ASSERT(sharedASTBuilder);
-    // Copy Val deduplication map over so we don't create duplicate Vals that are already
-    // existent in the stdlib.
-    m_cachedNodes = sharedASTBuilder->getInnerASTBuilder()->m_cachedNodes;
+    // Look up Vals in the deduplication map of the stdlib so we don't create duplicate
+    // Vals that are already existent in the stdlib.
+    m_cachedNodes.setParent(&sharedASTBuilder->getInnerASTBuilder()->m_cachedNodes);
+}
+
+ASTBuilder::ASTBuilder(ASTBuilder* parent, const String& name):
+    m_sharedASTBuilder(parent->m_sharedASTBuilder),
+    m_name(name),
+    m_id(parent->m_sharedASTBuilder->m_id++),
+    m_arena(2097152)
+{
+    m_valCache = parent->m_valCache;
+}
+
+ASTBuilder::ASTBuilder(ASTBuilder* valBuilder, const String& name, size_t arenaBlockSize):
+    m_sharedASTBuilder(valBuilder->m_sharedASTBuilder),
+    m_name(name),
+    m_id(valBuilder->m_sharedASTBuilder->m_id++),
+    m_arena(arenaBlockSize)
+{
+    m_valBuilder = valBuilder;
+}
+
+/* static */RefPtr<ASTBuilder> ASTBuilder::createModuleBuilder(ASTBuilder* valBuilder, const String& name, size_t arenaBlockSize)
+{
+    return RefPtr<ASTBuilder>(new ASTBuilder(valBuilder, name, arenaBlockSize));
+}
+
+void ASTBuilder::removeValsReferencing(ASTBuilder* moduleBuilder)
+{
+    SLANG_ASSERT(moduleBuilder->m_valBuilder == this);
+    m_valCache->removeNodesReferencing(moduleBuilder->getMemoryArena());
+
+    // The default arguments are `Val`s, which may have just been removed
+    m_cachedGenericDefaultArgs.clear();
 }
 
 ASTBuilder::ASTBuilder():
@@ -273,6 +436,12 @@ NodeBase* ASTBuilder::createByNodeType(ASTNodeType nodeType)
         return nullptr;
     }
 
+    // A module builder doesn't hold any `Val`s, see `m_valBuilder`.
+    if (m_valBuilder && info->isSubClassOf(*ASTClassInfo::getInfo(Val::kType)))
+    {
+        return m_valBuilder->createByNodeType(nodeType);
+    }
+
     return (NodeBase*)createFunc(this);
 }
 
@@ -432,7 +601,7 @@ DeclRef<InterfaceDecl> ASTBuilder::getDefaultInitializableTypeInterfaceDecl()
 }
 Type* ASTBuilder::getDefaultInitializableType()
 {
-    return DeclRefType::create(m_sharedASTBuilder->m_astBuilder, getDefaultInitializableTypeInterfaceDecl());
+    return DeclRefType::create(this, getDefaultInitializableTypeInterfaceDecl());
 }
 
 MeshOutputType* ASTBuilder::getMeshOutputTypeFromModifier(
@@ -2,6 +2,7 @@
 #ifndef SLANG_AST_BUILDER_H
 #define SLANG_AST_BUILDER_H
 
+#include <mutex>
 #include <type_traits>
 
 #include "slang-ast-support-types.h"
@@ -44,6 +45,10 @@ public:
     Type* getInitializerListType();
     Type* getOverloadedType();
 
+        /// Create the types above that are otherwise created on first use, so that
+        /// they can then be got from multiple threads at the same time.
+    void createLazyTypes();
+
     const ReflectClassInfo* findClassInfo(Name* name);
     SyntaxClass<NodeBase> findSyntaxClass(Name* name);
 
@@ -114,22 +119,15 @@ protected:
 
 struct ValKey
 {
-    Val* val;
-    HashCode hashCode;
+    Val* val = nullptr;
     ValKey() = default;
     ValKey(Val* v)
-    {
-        val = v;
-        Hasher hasher;
-        hasher.hashValue(v->astNodeType);
-        for (auto& operand : v->m_operands)
-            hasher.hashValue(operand.values.intOperand);
-        hashCode = hasher.getResult();
-    }
+        : val(v)
+    {}
     bool operator==(ValKey other) const
     {
         if (val == other.val) return true;
-        if (hashCode != other.hashCode) return false;
+        if (getHashCode() != other.getHashCode()) return false;
         if (val->astNodeType != other.val->astNodeType)
             return false;
         if (val->m_operands.getCount() != other.val->m_operands.getCount())
@@ -141,7 +139,7 @@ struct ValKey
     }
     bool operator==(const ValNodeDesc& desc) const
     {
-        if (hashCode != desc.getHashCode()) return false;
+        if (getHashCode() != desc.getHashCode()) return false;
         if (val->astNodeType != desc.type)
             return false;
         if (val->m_operands.getCount() != desc.operands.getCount())
@@ -151,7 +149,8 @@ struct ValKey
                 return false;
         return true;
     }
-    HashCode getHashCode() const { return hashCode; }
+        /// The hash of the `ValNodeDesc` that `val` was created from.
+    HashCode getHashCode() const { return val->_getDescHashCode(); }
 };
 
 // Add a specialization which can hash both ValKey and ValNodeDesc
@@ -183,6 +182,74 @@ struct ValKeyEqual
     }
 };
 
+    /// A hash-consing table used to deduplicate `Val` nodes.
+    ///
+    /// Two `Val`s created from equal `ValNodeDesc`s must be the same node, so every
+    /// `Val` created by an `ASTBuilder` goes through this table. The table is split into
+    /// shards selected by the (precomputed) hash of the node, and each shard has its own
+    /// lock, so that lookups from multiple threads can proceed concurrently.
+    ///
+    /// A cache can have a parent cache that is consulted for nodes not found in the cache
+    /// itself. This is used so that the AST builder of each linkage can find the `Val`s of
+    /// the builtin modules without holding a copy of their table. The parent must outlive
+    /// the cache.
+    ///
+class ValNodeCache
+{
+public:
+    struct Stats
+    {
+        Index nodeCount = 0;                ///< Number of nodes held in the cache (excluding the parent)
+        Index shardCount = 0;               ///< Number of shards in the cache
+        Index largestShardNodeCount = 0;    ///< Number of nodes in the fullest shard
+        uint64_t lookupCount = 0;           ///< Number of lookups performed
+        uint64_t hitCount = 0;              ///< Number of lookups that found an existing node (possibly in the parent)
+
+        double getHitRate() const { return lookupCount ? double(hitCount) / double(lookupCount) : 0.0; }
+    };
+
+        /// Find the node matching `desc` in this cache or its parent, or return nullptr.
+    Val* find(ValNodeDesc const& desc);
+
+        /// Add `node` to the cache, unless a node with the same description was added
+        /// in the meantime, in which case that node is returned instead.
+    Val* addOrFind(Val* node);
+
+    void setParent(ValNodeCache* parent) { m_parent = (parent == this) ? nullptr : parent; }
+    ValNodeCache* getParent() const { return m_parent; }
+
+        /// Get occupancy and hit-rate statistics for the cache.
+    Stats getStats();
+
+        /// Remove the nodes that refer to memory allocated from `arena`, directly or through
+        /// other nodes, so that they can't be found once the arena is released. The parent
+        /// cache is not changed. Returns the number of nodes removed.
+    Index removeNodesReferencing(MemoryArena const& arena);
+
+private:
+    static const Index kShardCount = 16;
+
+    struct Shard
+    {
+        std::mutex mutex;
+        Dictionary<ValKey, Val*, Hash<ValKey>, ValKeyEqual> nodes;
+        uint64_t lookupCount = 0;
+        uint64_t hitCount = 0;
+    };
+
+    static Index _getShardIndex(HashCode hashCode)
+    {
+        // The low bits are used by the dictionaries in the shards, so we
+        // select the shard with the high bits.
+        return Index((UInt64(hashCode) >> 32) % kShardCount);
+    }
+
+    Val* _findInShard(ValNodeDesc const& desc);
+
+    ValNodeCache* m_parent = nullptr;
+    Shard m_shards[kShardCount];
+};
+
 class ASTBuilder : public RefObject
 {
     friend class SharedASTBuilder;
@@ -191,21 +258,34 @@ public:
 
     Val* _getOrCreateImpl(ValNodeDesc&& desc)
     {
-        if (auto found = m_cachedNodes.tryGetValue(desc))
-            return *found;
+        if (m_valBuilder)
+            return m_valBuilder->_getOrCreateImpl(_Move(desc));
+
+        if (auto found = m_valCache->find(desc))
+            return found;
 
         auto node = as<Val>(createByNodeType(desc.type));
         SLANG_ASSERT(node);
         for (auto& operand : desc.operands)
             node->m_operands.add(operand);
-        auto result = node;
-        m_cachedNodes.add(ValKey(node), _Move(node));
-        return result;
+        node->_setDescHashCode(desc.getHashCode());
+        return m_valCache->addOrFind(node);
     }
 
     /// A cache for AST nodes that are entirely defined by their node type, with
     /// no need for additional state.
-    Dictionary<ValKey, Val*, Hash<ValKey>, ValKeyEqual> m_cachedNodes;
+    ValNodeCache m_cachedNodes;
+
+    /// The cache `Val`s are deduplicated with. This is `m_cachedNodes`, except for a
+    /// worker builder, which uses the cache of the builder it was created for.
+    ValNodeCache* m_valCache = &m_cachedNodes;
+
+    /// For a module builder, the builder that creates its `Val`s, see the constructor taking a `valBuilder`.
+    ASTBuilder* m_valBuilder = nullptr;
+
+    /// The results of `Val::resolve` for a worker builder, which can't cache them on the
+    /// nodes themselves because other threads may be reading them.
+    Dictionary<Val*, Val*> m_workerResolvedVals;
 
     Dictionary<GenericDecl*, List<Val*>> m_cachedGenericDefaultArgs;
 
@@ -571,9 +651,37 @@ public:
 
     Index getId() { return m_id; }
 
+        /// True if this is a worker builder, see the constructor taking a `parent`.
+    bool isWorker() const { return m_valCache != &m_cachedNodes; }
+
         /// Ctor
     ASTBuilder(SharedASTBuilder* sharedASTBuilder, const String& name); 
 
+        /// Create a worker builder, used to check code on one thread while other threads
+        /// check code with `parent` or its other workers.
+        ///
+        /// The worker allocates nodes from its own arena, but deduplicates `Val`s with the
+        /// cache of `parent`, so it produces the same `Val`s `parent` would. Values that
+        /// are otherwise cached on shared nodes when they are first computed (resolved `Val`s
+        /// and default `DeclRef`s) are kept by the worker, or computed again, instead.
+        ///
+        /// The nodes of the worker can be found through the cache of `parent`, so the
+        /// worker must be kept alive as long as `parent`.
+    ASTBuilder(ASTBuilder* parent, const String& name);
+
+        /// Create a builder for the AST of a single module, so that the AST is released along
+        /// with the module.
+        ///
+        /// Nodes are allocated from the builder's own arena, except for `Val`s, which are
+        /// created by `valBuilder`. `Val`s are deduplicated across modules, so they have to
+        /// outlive any one module. Before the module builder is released, the `Val`s that
+        /// refer to its nodes have to be removed with `removeValsReferencing`.
+    static RefPtr<ASTBuilder> createModuleBuilder(ASTBuilder* valBuilder, const String& name, size_t arenaBlockSize);
+
+        /// Remove the `Val`s that refer to nodes of `moduleBuilder`, a builder created with
+        /// this builder as its `valBuilder`, from the `Val` cache.
+    void removeValsReferencing(ASTBuilder* moduleBuilder);
+
         /// Dtor
     ~ASTBuilder();
 
@@ -581,6 +689,9 @@ protected:
     // Special default Ctor that can only be used by SharedASTBuilder
     ASTBuilder();
 
+    // Used by `createModuleBuilder`
+    ASTBuilder(ASTBuilder* valBuilder, const String& name, size_t arenaBlockSize);
+
 
     template <typename T>
     SLANG_FORCE_INLINE T* _initAndAdd(T* node)
@@ -47,6 +47,42 @@ bool isInterfaceRequirement(Decl* decl)
     return false;
 }
 
+ContainerDecl* ContainerDecl::getMemberInvalidationOwner()
+{
+    // The target type of an extension is only known once the extension has been
+    // checked, but an extension can't contribute members to lookups in its target
+    // type before then either.
+    //
+    if (auto extensionDecl = as<ExtensionDecl>(this))
+    {
+        if (auto targetType = as<DeclRefType>(extensionDecl->targetType.type))
+        {
+            if (auto aggTypeDecl = as<AggTypeDecl>(targetType->getDeclRef().getDecl()))
+                return aggTypeDecl;
+        }
+    }
+    return this;
+}
+
+void ContainerDecl::invalidateMemberDictionary()
+{
+    dictionaryLastCount = -1;
+    getMemberInvalidationOwner()->memberInvalidationCount++;
+}
+
+void ContainerDecl::addMember(Decl* member)
+{
+    if (member)
+    {
+        // Adding a member makes an up to date dictionary out of date
+        if (isMemberDictionaryValid())
+            getMemberInvalidationOwner()->memberInvalidationCount++;
+
+        member->parentDecl = this;
+        members.add(member);
+    }
+}
+
 void ContainerDecl::buildMemberDictionary()
 {
     // Don't rebuild if already built
@@ -42,7 +42,21 @@ class ContainerDecl: public Decl
 
     bool isMemberDictionaryValid() const { return dictionaryLastCount == members.getCount(); }
 
-    void invalidateMemberDictionary() { dictionaryLastCount = -1; }
+    void invalidateMemberDictionary();
+
+        /// Get the container whose member invalidation count covers this container.
+        ///
+        /// This is the container itself, except for an `extension` of an aggregate type, which
+        /// is covered by the type. A cache built from the members of a type and all of its
+        /// extensions then only needs to check the count of the type.
+        ///
+    ContainerDecl* getMemberInvalidationOwner();
+
+        /// Get a count that is incremented whenever the member dictionary of a container this
+        /// one owns (see `getMemberInvalidationOwner`) is invalidated, either explicitly or by
+        /// adding a member to it while it was up to date.
+        ///
+    Index getMemberInvalidationCount() const { return memberInvalidationCount; }
 
     Dictionary<Name*, Decl*>& getMemberDictionary()
     {
@@ -56,14 +70,7 @@ class ContainerDecl: public Decl
         return transparentMembers;
     }
 
-    void addMember(Decl* member)
-    {
-        if (member)
-        {
-            member->parentDecl = this;
-            members.add(member);
-        }
-    }
+    void addMember(Decl* member);
 
     SLANG_UNREFLECTED   // We don't want to reflect the following fields
 
@@ -74,6 +81,9 @@ private:
     // If it < 0 it means that the dictionary/transparentMembers is invalid and needs to be recreated.
     Index dictionaryLastCount = 0;
 
+    // See `getMemberInvalidationCount`.
+    Index memberInvalidationCount = 0;
+
     // Dictionary for looking up members by name.
     // This is built on demand before performing lookup.
     Dictionary<Name*, Decl*> memberDictionary;
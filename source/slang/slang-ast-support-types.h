@@ -1492,7 +1492,7 @@ namespace Slang
             return m_val;
         }
 
-        RefPtr<WitnessTable> getWitnessTable();
+        WitnessTable* getWitnessTable() const;
 
         RequirementWitness specialize(ASTBuilder* astBuilder, SubstitutionSet const& subst);
 
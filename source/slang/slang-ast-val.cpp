@@ -66,6 +66,15 @@ Val* Val::resolve()
         SLANG_ASSERT(as<Val>(m_resolvedVal));
         return m_resolvedVal;
     }
+    // Other threads may be reading this node, so a worker builder keeps what it resolves to itself.
+    if (astBuilder->isWorker())
+    {
+        if (auto found = astBuilder->m_workerResolvedVals.tryGetValue(this))
+            return *found;
+        auto resolvedVal = resolveImpl();
+        astBuilder->m_workerResolvedVals[this] = resolvedVal;
+        return resolvedVal;
+    }
     // Update epoch now to avoid infinite recursion.
     m_resolvedValEpoch = astBuilder->getEpoch();
     m_resolvedVal = resolveImpl();
@@ -1331,12 +1340,12 @@ void FuncCallIntVal::_toTextOverride(StringBuilder& out)
     if (args.getCount() == 2)
     {
         argToText(0);
-        out << (name ? name->text : "");
+        out << getUnownedStringSliceText(name);
         argToText(1);;
     }
     else if (args.getCount() == 1)
     {
-        out << (name ? name->text : "");
+        out << getUnownedStringSliceText(name);
         argToText(0);
     }
     else if (name && name->text == "?:")
@@ -1615,7 +1624,7 @@ void WitnessLookupIntVal::_toTextOverride(StringBuilder& out)
 {
     getWitness()->getSub()->toText(out);
     out << ".";
-    out << (getKey()->getName() ? getKey()->getName()->text : "??");
+    out << (getKey()->getName() ? getUnownedStringSliceText(getKey()->getName()) : toSlice("??"));
 }
 
 Val* WitnessLookupIntVal::_resolveImplOverride()
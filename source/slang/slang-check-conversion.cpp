@@ -1396,7 +1396,7 @@ namespace Slang
         
         bool shouldAddToCache = false;
         ConversionCost cost;
-        TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+        TypeCheckingCache* typeCheckingCache = getShared()->getTypeCheckingCache();
 
         BasicTypeKeyPair cacheKey;
         cacheKey.type1 = makeBasicTypeKey(toType);
@@ -17,6 +17,7 @@
 #include "slang-ast-synthesis.h"
 #include "slang-ast-reflect.h"
 #include "slang-ast-iterator.h"
+#include <exception>
 #include <limits>
 
 namespace Slang
@@ -1166,6 +1167,17 @@ namespace Slang
         ///
     static void _dispatchDeclCheckingVisitor(Decl* decl, DeclCheckState state, SemanticsContext& shared);
 
+        /// Is `decl` declared within a statement, such as a local variable of a function body?
+    static bool _isDeclaredInStmt(Decl* decl)
+    {
+        for (auto parentDecl = decl->parentDecl; parentDecl; parentDecl = parentDecl->parentDecl)
+        {
+            if (as<ScopeDecl>(parentDecl))
+                return true;
+        }
+        return false;
+    }
+
     // Make sure a declaration has been checked, so we can refer to it.
     // Note that this may lead to us recursively invoking checking,
     // so this may not be the best way to handle things.
@@ -1176,6 +1188,13 @@ namespace Slang
         //
         if (decl->isChecked(state)) return;
 
+        // When function bodies are checked in parallel everything outside of them has
+        // been checked already, and each body is checked by its own iteration, so only
+        // declarations in the body being checked can be checked further.
+        //
+        if (getShared()->isParallelWorker() && !_isDeclaredInStmt(decl))
+            return;
+
         // Is the declaration already being checked, somewhere up the
         // call stack from us?
         //
@@ -2269,7 +2288,7 @@ namespace Slang
             assocTypeDef->type.type = context->conformingType;
             assocTypeDef->parentDecl = context->parentDecl;
             assocTypeDef->setCheckState(DeclCheckState::DefinitionChecked);
-            context->parentDecl->members.add(assocTypeDef);
+            context->parentDecl->addMember(assocTypeDef);
             
             markSelfDifferentialMembersOfType(as<AggTypeDecl>(context->parentDecl), context->conformingType);
 
@@ -2290,7 +2309,7 @@ namespace Slang
         {
             aggTypeDecl = m_astBuilder->create<StructDecl>();
             aggTypeDecl->parentDecl = context->parentDecl;
-            context->parentDecl->members.add((aggTypeDecl));
+            context->parentDecl->addMember(aggTypeDecl);
             aggTypeDecl->nameAndLoc.name = requirementDeclRef.getName();
             aggTypeDecl->loc = context->parentDecl->nameAndLoc.loc;
             context->parentDecl->invalidateMemberDictionary();
@@ -2343,7 +2362,7 @@ namespace Slang
             diffField->type.type = diffMemberType;
             diffField->checkState = DeclCheckState::SignatureChecked;
             diffField->parentDecl = aggTypeDecl;
-            aggTypeDecl->members.add(diffField);
+            aggTypeDecl->addMember(diffField);
 
             auto visibility = getDeclVisibility(member);
             addVisibilityModifier(m_astBuilder, diffField, visibility);
@@ -2399,7 +2418,7 @@ namespace Slang
             auto inheritanceIDiffernetiable = m_astBuilder->create<InheritanceDecl>();
             inheritanceIDiffernetiable->base.type = m_astBuilder->getDiffInterfaceType();
             inheritanceIDiffernetiable->parentDecl = aggTypeDecl;
-            aggTypeDecl->members.add(inheritanceIDiffernetiable);
+            aggTypeDecl->addMember(inheritanceIDiffernetiable);
         }
 
         // The `Differential` type of a `Differential` type is always itself.
@@ -2422,7 +2441,7 @@ namespace Slang
             assocTypeDef->type.type = satisfyingType;
             assocTypeDef->parentDecl = aggTypeDecl;
             assocTypeDef->setCheckState(DeclCheckState::DefinitionChecked);
-            aggTypeDecl->members.add(assocTypeDef);
+            aggTypeDecl->addMember(assocTypeDef);
         }
 
         // Go through all members and collect their differential types.
@@ -2935,6 +2954,13 @@ namespace Slang
                 break;
         }
 
+        // Function bodies are only checked in parallel when asked for, and never in the language
+        // server, which skips checking most of them anyway.
+        //
+        Index bodyCheckJobCount = getOptionSet().getIntOption(CompilerOptionName::CheckJobs);
+        if (getShared()->isInLanguageServer())
+            bodyCheckJobCount = 1;
+
         // With extensions taken care of, we can now check the remaining decls.
         for(auto s : states)
         {
@@ -2952,6 +2978,15 @@ namespace Slang
             // to the subset of declarations coming from a given source
             // file.
             //
+            // Function bodies can instead be checked in parallel (see `_checkBodiesInParallel`),
+            // once everything else has been checked.
+            //
+            if (s == DeclCheckState::DefinitionChecked && bodyCheckJobCount > 1)
+            {
+                _checkBodiesInParallel(moduleDecl, bodyCheckJobCount);
+                continue;
+            }
+
             ensureAllDeclsRec(moduleDecl, s);
         }
 
@@ -2962,6 +2997,296 @@ namespace Slang
         // declarations they contain should be fully checked.
     }
 
+    void SemanticsDeclVisitorBase::_ensureAllDeclsRecExceptBodies(Decl* decl, List<FunctionDeclBase*>& outFuncs)
+    {
+        auto funcDecl = as<FunctionDeclBase>(decl);
+        if (funcDecl && funcDecl->body)
+        {
+            ensureDecl(decl, DeclCheckState::AttributesChecked);
+            if (!decl->isChecked(DeclCheckState::DefinitionChecked))
+                outFuncs.add(funcDecl);
+        }
+        else
+        {
+            ensureDecl(decl, DeclCheckState::DefinitionChecked);
+        }
+
+        // The children are visited as in `ensureAllDeclsRec`, so declarations
+        // in function bodies are left to the body.
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            const auto& members = containerDecl->members;
+            for (Index i = 0; i < members.getCount(); ++i)
+            {
+                Decl* childDecl = members[i];
+                if (as<ScopeDecl>(childDecl))
+                    continue;
+                _ensureAllDeclsRecExceptBodies(childDecl, outFuncs);
+            }
+        }
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            _ensureAllDeclsRecExceptBodies(genericDecl->inner, outFuncs);
+        }
+    }
+
+    static void _buildWitnessTableDictionariesRec(WitnessTable* witnessTable)
+    {
+        for (auto requirement : witnessTable->getRequirementDictionary())
+        {
+            if (requirement.value.getFlavor() == RequirementWitness::Flavor::witnessTable)
+                _buildWitnessTableDictionariesRec(requirement.value.getWitnessTable());
+        }
+    }
+
+    static void _buildMemberDictionariesRec(Decl* decl)
+    {
+        if (auto inheritanceDecl = as<InheritanceDecl>(decl))
+        {
+            if (inheritanceDecl->witnessTable)
+                _buildWitnessTableDictionariesRec(inheritanceDecl->witnessTable);
+        }
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            containerDecl->buildMemberDictionary();
+            for (auto childDecl : containerDecl->members)
+            {
+                if (as<ScopeDecl>(childDecl))
+                    continue;
+                _buildMemberDictionariesRec(childDecl);
+            }
+        }
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            _buildMemberDictionariesRec(genericDecl->inner);
+        }
+    }
+
+    static void _findUserDefinedAttributeStructsRec(Decl* decl, List<StructDecl*>& outStructs)
+    {
+        if (auto structDecl = as<StructDecl>(decl))
+        {
+            if (structDecl->hasModifier<AttributeUsageAttribute>())
+                outStructs.add(structDecl);
+        }
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            for (auto childDecl : containerDecl->members)
+            {
+                if (as<ScopeDecl>(childDecl))
+                    continue;
+                _findUserDefinedAttributeStructsRec(childDecl, outStructs);
+            }
+        }
+    }
+
+    void SemanticsDeclVisitorBase::_prepareForParallelBodyChecking(ModuleDecl* moduleDecl)
+    {
+        List<ModuleDecl*> moduleDecls;
+        moduleDecls.add(moduleDecl);
+        moduleDecls.addRange(getShared()->importedModulesList);
+
+        // A user defined attribute is synthesized from its `struct` the first time it is
+        // looked up, and added next to the `struct`, so all of them are looked up up front.
+        //
+        List<StructDecl*> attributeStructs;
+        for (auto decl : moduleDecls)
+        {
+            if (!isFromStdLib(decl))
+                _findUserDefinedAttributeStructsRec(decl, attributeStructs);
+        }
+        const String attributeSuffix = "Attribute";
+        for (auto structDecl : attributeStructs)
+        {
+            const String structName = getText(structDecl->getName());
+            if (!structName.endsWith(attributeSuffix) || structName.getLength() == attributeSuffix.getLength())
+                continue;
+            const auto attributeName = structName.getUnownedSlice().head(structName.getLength() - attributeSuffix.getLength());
+            lookUpAttributeDecl(getNamePool()->getName(attributeName), getScope(structDecl));
+        }
+
+        for (auto module : getSession()->stdlibModules)
+        {
+            if (auto decl = module->getModuleDecl())
+                moduleDecls.add(decl);
+        }
+        for (auto decl : moduleDecls)
+        {
+            _buildMemberDictionariesRec(decl);
+        }
+
+        getASTBuilder()->getSharedASTBuilder()->createLazyTypes();
+    }
+
+    static bool _bodyDeclaresType(FunctionDeclBase* funcDecl)
+    {
+        bool declaresType = false;
+        iterateAST(
+            funcDecl->body,
+            [](DeclBase*) { return true; },
+            [&](SyntaxNode* node)
+            {
+                if (as<AggTypeDeclBase>(node))
+                    declaresType = true;
+            });
+        return declaresType;
+    }
+
+    void SemanticsDeclVisitorBase::_checkBodiesInParallel(ModuleDecl* moduleDecl, Index jobCount)
+    {
+        // The diagnostics for everything but the bodies are held back as well, so that
+        // they can be reported in source order along with those for the bodies.
+        //
+        auto sink = getSink();
+        List<DiagnosticSink::DeferredDiagnostic> declDiagnostics;
+        List<FunctionDeclBase*> funcs;
+        sink->setDeferredOutput(&declDiagnostics);
+        try
+        {
+            _ensureAllDeclsRecExceptBodies(moduleDecl, funcs);
+            if (funcs.getCount())
+                _prepareForParallelBodyChecking(moduleDecl);
+        }
+        catch (...)
+        {
+            sink->setDeferredOutput(nullptr);
+            sink->outputDeferredDiagnostics(declDiagnostics.getArrayView());
+            throw;
+        }
+        sink->setDeferredOutput(nullptr);
+
+        // Reference counts aren't atomic, so the threads must not take references to
+        // objects they share: witness tables are only looked at through raw pointers (see
+        // `tryLookUpRequirementWitness`), the decl associations are cached as raw pointers,
+        // and the text of names is looked at through slices. A body that declares a type is
+        // checked on this thread once the others are done, as checking the conformances of
+        // the type takes references to the witness tables of other declarations.
+        //
+        List<Index> parallelBodies;
+        List<Index> serialBodies;
+        for (Index i = 0; i < funcs.getCount(); ++i)
+        {
+            if (_bodyDeclaresType(funcs[i]))
+                serialBodies.add(i);
+            else
+                parallelBodies.add(i);
+        }
+
+        auto threadPool = getSession()->getThreadPool();
+        jobCount = Math::Min(jobCount, Math::Min(threadPool->getWorkerCount() + 1, parallelBodies.getCount()));
+
+        // Each thread checks with its own copy of the shared state, except for
+        // the `Val` cache, which all the worker builders share.
+        //
+        struct Worker : RefObject
+        {
+            DiagnosticSink sink;
+            TypeCheckingCache typeCheckingCache;
+            SharedSemanticsContext shared;
+
+            Worker(SharedSemanticsContext* mainShared, ASTBuilder* astBuilder)
+                : shared(
+                    mainShared->getLinkage(),
+                    mainShared->getModule(),
+                    &sink,
+                    mainShared->m_environmentModules,
+                    mainShared->getTranslationUnitRequest())
+            {
+                sink.initDeferred(*mainShared->getSink());
+                shared.m_astBuilder = astBuilder;
+                shared.m_typeCheckingCache = &typeCheckingCache;
+                shared.importedModulesList = mainShared->importedModulesList;
+                shared.importedModulesSet = mainShared->importedModulesSet;
+            }
+        };
+        List<RefPtr<Worker>> workers;
+        for (Index i = 0; i < jobCount; ++i)
+        {
+            auto astBuilder = getLinkage()->getWorkerASTBuilder(i);
+            // What a `Val` resolves to can change between modules
+            astBuilder->m_workerResolvedVals.clear();
+            workers.add(new Worker(getShared(), astBuilder));
+        }
+
+        struct Body
+        {
+            List<DiagnosticSink::DeferredDiagnostic> diagnostics;
+            std::exception_ptr exception;
+        };
+        List<Body> bodies;
+        bodies.setCount(funcs.getCount());
+
+        auto checkBody = [&](Index index, SharedSemanticsContext* shared)
+        {
+            auto funcDecl = funcs[index];
+            auto& body = bodies[index];
+
+            shared->getSink()->setDeferredOutput(&body.diagnostics);
+            try
+            {
+                // As in `ensureDecl`, except that the state of `funcDecl` is only
+                // updated once all bodies are checked.
+                SemanticsContext context(shared);
+                if (auto outerScope = getScope(funcDecl))
+                    context = context.withOuterScope(outerScope);
+                _dispatchDeclCheckingVisitor(funcDecl, DeclCheckState::DefinitionChecked, context);
+            }
+            catch (...)
+            {
+                body.exception = std::current_exception();
+            }
+            shared->getSink()->setDeferredOutput(nullptr);
+        };
+
+        threadPool->forEach(parallelBodies.getCount(), jobCount, [&](Index index, Index threadSlot)
+        {
+            Worker* worker = workers[threadSlot];
+            SLANG_AST_BUILDER_RAII(worker->shared.getASTBuilder());
+            checkBody(parallelBodies[index], &worker->shared);
+        });
+        for (auto index : serialBodies)
+        {
+            checkBody(index, getShared());
+        }
+
+        // Report in source order, stopping at the first body that failed, just as when
+        // checking everything one declaration after another. A diagnostic for the other
+        // declarations is output before the bodies that come after its location, and the
+        // notes (or diagnostics without a location) that follow it are kept with it.
+        //
+        List<SourceLoc::RawValue> declDiagnosticLocs;
+        for (auto const& deferred : declDiagnostics)
+        {
+            const auto loc = deferred.diagnostic.loc;
+            if (deferred.info.severity != Severity::Note && loc.isValid())
+                declDiagnosticLocs.add(loc.getRaw());
+            else
+                declDiagnosticLocs.add(declDiagnosticLocs.getCount() ? declDiagnosticLocs.getLast() : 0);
+        }
+
+        Index declDiagnosticIndex = 0;
+        auto outputDeclDiagnostics = [&](Index endIndex)
+        {
+            sink->outputDeferredDiagnostics(declDiagnostics.getArrayView(declDiagnosticIndex, endIndex - declDiagnosticIndex));
+            declDiagnosticIndex = endIndex;
+        };
+
+        for (Index i = 0; i < funcs.getCount(); ++i)
+        {
+            const auto funcLoc = funcs[i]->loc;
+            Index endIndex = declDiagnosticIndex;
+            while (funcLoc.isValid() && endIndex < declDiagnostics.getCount() && declDiagnosticLocs[endIndex] <= funcLoc.getRaw())
+                endIndex++;
+            outputDeclDiagnostics(endIndex);
+
+            sink->outputDeferredDiagnostics(bodies[i].diagnostics.getArrayView());
+            if (bodies[i].exception)
+                std::rethrow_exception(bodies[i].exception);
+            funcs[i]->setCheckState(DeclCheckState::DefinitionChecked);
+        }
+        outputDeclDiagnostics(declDiagnostics.getCount());
+    }
+
     bool SemanticsVisitor::doesSignatureMatchRequirement(
         DeclRef<CallableDecl>   satisfyingMemberDeclRef,
         DeclRef<CallableDecl>   requiredMemberDeclRef,
@@ -3773,7 +4098,7 @@ namespace Slang
                 synTypeParamDecl->nameAndLoc = typeParamDecl->getNameAndLoc();
                 synTypeParamDecl->initType = typeParamDecl->initType;
                 synTypeParamDecl->parentDecl = synGenericDecl;
-                synGenericDecl->members.add(synTypeParamDecl);
+                synGenericDecl->addMember(synTypeParamDecl);
 
                 mapOrigToSynTypeParams.add(typeParamDecl, synTypeParamDecl);
                 
@@ -3812,7 +4137,7 @@ namespace Slang
 
                     synConstraintDecl->sub = TypeExp(synTypeParamDeclRefExpr);
                     synConstraintDecl->sup = constraintDecl->sup;
-                    synGenericDecl->members.add(synConstraintDecl);
+                    synGenericDecl->addMember(synConstraintDecl);
                 }
                 else
                 {
@@ -3949,7 +4274,7 @@ namespace Slang
             // the method we are building.
             //
             synParamDecl->parentDecl = synthesized;
-            synthesized->members.add(synParamDecl);
+            synthesized->addMember(synParamDecl);
 
             // Add modifiers
             for (auto modifier : paramDeclRef.getDecl()->modifiers)
@@ -4533,7 +4858,7 @@ namespace Slang
                 // the accessor we are building.
                 //
                 synParamDecl->parentDecl = synAccessorDecl;
-                synAccessorDecl->members.add(synParamDecl);
+                synAccessorDecl->addMember(synParamDecl);
 
                 // For each paramter, we will create an argument expression
                 // to represent it in the body of the accessor.
@@ -4731,7 +5056,7 @@ namespace Slang
             synAccessorDecl->body = synBodyStmt;
 
             synAccessorDecl->parentDecl = synPropertyDecl;
-            synPropertyDecl->members.add(synAccessorDecl);
+            synPropertyDecl->addMember(synAccessorDecl);
 
             // If synthesis of an accessor worked, then we will record it into
             // a local dictionary. We do *not* install the accessor into the
@@ -4851,7 +5176,7 @@ namespace Slang
                 // the accessor we are building.
                 //
                 synParamDecl->parentDecl = synAccessorDecl;
-                synAccessorDecl->members.add(synParamDecl);
+                synAccessorDecl->addMember(synParamDecl);
 
                 // For each paramter, we will create an argument expression
                 // to represent it in the body of the accessor.
@@ -4910,7 +5235,7 @@ namespace Slang
             synAccessorDecl->body = synBodyStmt;
 
             synAccessorDecl->parentDecl = synPropertyDecl;
-            synPropertyDecl->members.add(synAccessorDecl);
+            synPropertyDecl->addMember(synAccessorDecl);
 
             // Register the synthesized accessor.
             //
@@ -5248,7 +5573,7 @@ namespace Slang
         synFunc->parentDecl = context->parentDecl;
         synFunc->loc = context->parentDecl->closingSourceLoc;
         synFunc->nameAndLoc.loc = synFunc->loc;
-        context->parentDecl->members.add(synFunc);
+        context->parentDecl->addMember(synFunc);
         context->parentDecl->invalidateMemberDictionary();
         addModifier(synFunc, intrinsicOpModifier);
         witnessTable->add(funcDeclRef.getDecl(), RequirementWitness(m_astBuilder->getDirectDeclRef(synFunc)));
@@ -5430,7 +5755,7 @@ namespace Slang
         seqStmt->stmts.add(synReturn);
 
         Decl* witnessDecl = synGeneric ? (Decl*)synGeneric : synFunc;
-        context->parentDecl->members.add(witnessDecl);
+        context->parentDecl->addMember(witnessDecl);
         context->parentDecl->invalidateMemberDictionary();
         addModifier(synFunc, m_astBuilder->create<SynthesizedModifier>());
 
@@ -6327,7 +6652,7 @@ namespace Slang
                     conformanceDecl->loc = decl->loc;
                     conformanceDecl->base.type = defaultInitializableType;
                     conformanceDecl->nameAndLoc.name = getName("$inheritance");
-                    decl->members.add(conformanceDecl);
+                    decl->addMember(conformanceDecl);
                 }
             }
 
@@ -6612,7 +6937,7 @@ namespace Slang
             enumConformanceDecl->parentDecl = decl;
             enumConformanceDecl->loc = decl->loc;
             enumConformanceDecl->base.type = getASTBuilder()->getEnumTypeType();
-            decl->members.add(enumConformanceDecl);
+            decl->addMember(enumConformanceDecl);
 
             // The `__EnumType` interface has one required member, the `__Tag` type.
             // We need to satisfy this requirement automatically, rather than require
@@ -8008,7 +8333,7 @@ namespace Slang
             default:
                 break;
             }
-            decl->members.add(param);
+            decl->addMember(param);
             param->parentDecl = decl;
         }
     }
@@ -8042,7 +8367,7 @@ namespace Slang
                 auto declRef = createDefaultSubstitutionsIfNeeded(m_astBuilder, this, makeDeclRef(decl)).as<CallableDecl>();
                 auto diffFuncType = getForwardDiffFuncType(getFuncType(m_astBuilder, declRef));
                 setFuncTypeIntoRequirementDecl(reqDecl, as<FuncType>(diffFuncType));
-                interfaceDecl->members.add(reqDecl);
+                interfaceDecl->addMember(reqDecl);
                 reqDecl->parentDecl = interfaceDecl;
 
                 if (!decl->hasModifier<NoDiffThisAttribute>())
@@ -8058,7 +8383,7 @@ namespace Slang
                 auto reqRef = m_astBuilder->create<DerivativeRequirementReferenceDecl>();
                 reqRef->referencedDecl = reqDecl;
                 reqRef->parentDecl = decl;
-                decl->members.add(reqRef);
+                decl->addMember(reqRef);
                 isDiffFunc = true;
             }
             if (decl->hasModifier<BackwardDifferentiableAttribute>())
@@ -8072,7 +8397,7 @@ namespace Slang
                     reqDecl->originalRequirementDecl = decl;
                     cloneModifiers(reqDecl, decl);
                     setFuncTypeIntoRequirementDecl(reqDecl, diffFuncType);
-                    interfaceDecl->members.add(reqDecl);
+                    interfaceDecl->addMember(reqDecl);
                     reqDecl->parentDecl = interfaceDecl;
                     if (!decl->hasModifier<NoDiffThisAttribute>())
                     {
@@ -8087,7 +8412,7 @@ namespace Slang
                     auto reqRef = m_astBuilder->create<DerivativeRequirementReferenceDecl>();
                     reqRef->referencedDecl = reqDecl;
                     reqRef->parentDecl = decl;
-                    decl->members.add(reqRef);
+                    decl->addMember(reqRef);
                 }
                 isDiffFunc = true;
             }
@@ -8459,7 +8784,7 @@ namespace Slang
             getterDecl->loc = decl->loc;
 
             getterDecl->parentDecl = decl;
-            decl->members.add(getterDecl);
+            decl->addMember(getterDecl);
         }
     }
 
@@ -8595,7 +8920,7 @@ namespace Slang
             newValueParam->nameAndLoc.loc = decl->loc;
 
             newValueParam->parentDecl = decl;
-            decl->members.add(newValueParam);
+            decl->addMember(newValueParam);
         }
 
         // The new-value parameter is expected to have the
@@ -9352,8 +9677,9 @@ namespace Slang
     {
         for (auto& entry : moduleDecl->mapDeclToAssociatedDecls)
         {
-            auto& list = _getDeclAssociationList(entry.key, m_mapDeclToAssociatedDecls);
-            list.addRange(entry.value->associations);
+            auto& list = m_mapDeclToAssociatedDecls[entry.key];
+            for (auto& assoc : entry.value->associations)
+                list.add(assoc);
         }
     }
 
@@ -9369,7 +9695,7 @@ namespace Slang
         m_mapDeclToAssociatedDecls.clear();
     }
 
-    List<RefPtr<DeclAssociation>> const& SharedSemanticsContext::getAssociatedDeclsForDecl(Decl* decl)
+    List<DeclAssociation*> const& SharedSemanticsContext::getAssociatedDeclsForDecl(Decl* decl)
     {
         // This duplicates the exact same logic from `getCandidateExtensionsForTypeDecl`.
         // Consider refactoring them into the same framework.
@@ -9398,7 +9724,7 @@ namespace Slang
                 }
             }
         }
-        return _getDeclAssociationList(decl, m_mapDeclToAssociatedDecls);
+        return m_mapDeclToAssociatedDecls[decl];
     }
 
     bool SharedSemanticsContext::isDifferentiableFunc(FunctionDeclBase* func)
@@ -610,7 +610,7 @@ namespace Slang
                     auto conformanceDecl = m_astBuilder->create<InheritanceDecl>();
                     conformanceDecl->base.type = m_astBuilder->getDiffInterfaceType();
                     conformanceDecl->parentDecl = structDecl;
-                    structDecl->members.add(conformanceDecl);
+                    structDecl->addMember(conformanceDecl);
                     structDecl->parentDecl = parent;
 
                     synthesizedDecl = structDecl;
@@ -621,12 +621,12 @@ namespace Slang
                     auto synthDeclRef = createDefaultSubstitutionsIfNeeded(m_astBuilder, this, makeDeclRef(structDecl));
 
                     typeDef->type.type = DeclRefType::create(m_astBuilder, synthDeclRef);
-                    structDecl->members.add(typeDef);
+                    structDecl->addMember(typeDef);
 
                     synthesizedDecl->parentDecl = parent;
                     synthesizedDecl->nameAndLoc.name = item.declRef.getName();
                     synthesizedDecl->loc = parent->loc;
-                    parent->members.add(synthesizedDecl);
+                    parent->addMember(synthesizedDecl);
                     parent->invalidateMemberDictionary();
 
                     // Mark the newly synthesized decl as `ToBeSynthesized` so future checking can differentiate it
@@ -651,7 +651,7 @@ namespace Slang
                     
                     synthesizedDecl = parent;
 
-                    parent->members.add(typeDef);
+                    parent->addMember(typeDef);
                     parent->invalidateMemberDictionary();
 
                     markSelfDifferentialMembersOfType(parent, subType);
@@ -3821,7 +3821,7 @@ namespace Slang
             suggestions.elementCount[1] = baseElementColCount;
         }
 
-        String swizzleText = getText(memberRefExpr->name);
+        UnownedStringSlice swizzleText = getUnownedStringSliceText(memberRefExpr->name);
         auto cursor = swizzleText.begin();
 
         // The contents of the string are 0-terminated
@@ -3980,8 +3980,7 @@ namespace Slang
             return memberExpr;
         }
 
-        String swizzleText = getText(memberExpr->name);
-        auto span = swizzleText.getUnownedSlice();
+        auto span = getUnownedStringSliceText(memberExpr->name);
         Index pos = 0;
 
         ShortList<UInt> elementCoords;
@@ -4021,7 +4020,7 @@ namespace Slang
 
             if (elementCoord >= tupleElementCount)
             {
-                getSink()->diagnose(memberExpr, Diagnostics::invalidSwizzleExpr, swizzleText, baseTupleType);
+                getSink()->diagnose(memberExpr, Diagnostics::invalidSwizzleExpr, span, baseTupleType);
                 return CreateErrorExpr(memberExpr);
             }
 
@@ -4089,7 +4088,7 @@ namespace Slang
             suggestions.elementCount[0] = baseElementCount;
             suggestions.elementCount[1] = 0;
         }
-        auto swizzleText = getText(memberRefExpr->name);
+        auto swizzleText = getUnownedStringSliceText(memberRefExpr->name);
 
         for (Index i = 0; i < swizzleText.getLength(); i++)
         {
@@ -546,6 +546,59 @@ namespace Slang
         }
     };
 
+        /// A flattened index of the members visible through a list of facets.
+        ///
+        /// Member lookup in a type has to consider every facet of the type
+        /// (its own body, its bases, and every `extension` that applies to it),
+        /// and types like the builtin vector and matrix types have a lot of
+        /// extension facets. This index maps a member name to the positions
+        /// of the facets that could contribute a result for that name, so that
+        /// lookup can skip all the others.
+        ///
+        /// The index is built lazily on first use, and is rebuilt if the member
+        /// dictionary of any of the containers it covers has been invalidated since.
+        /// That is checked with the member invalidation counts of the types (and
+        /// other containers) that own the facets (see `getMemberInvalidationOwner`),
+        /// so the extensions of a type don't need to be checked one by one.
+        ///
+    struct FacetMemberIndex : RefObject
+    {
+        explicit FacetMemberIndex(FacetList facets)
+            : m_facetList(facets)
+        {}
+
+            /// Get the positions (in `facets` order) of the facets that need to be
+            /// visited when looking up `name`.
+            ///
+            /// This includes every facet that directly declares a member called `name`,
+            /// as well as every facet with transparent members, since lookup through
+            /// those can find a member of any name.
+            ///
+        List<Index> const& getFacetsForName(Name* name);
+
+            /// Get the facet at position `index` in lookup order.
+        Facet getFacet(Index index) const { return m_facets[index]; }
+
+    private:
+        void _build();
+
+        bool _isUpToDate();
+
+        struct OwnerInfo
+        {
+            ContainerDecl* owner = nullptr;
+            Index invalidationCount = 0;
+        };
+
+        FacetList m_facetList;
+        bool m_isBuilt = false;
+            /// The owners of the facets, with their member invalidation counts when the index was built
+        List<OwnerInfo> m_owners;
+        List<Facet> m_facets;
+        List<Index> m_facetsWithTransparentMembers;
+        Dictionary<Name*, List<Index>> m_facetsForName;
+    };
+
         /// Information about the inheritance of an entity (type or declaration)
         ///
         /// Currently this is only used to store a linearized list of the
@@ -554,6 +607,15 @@ namespace Slang
     struct InheritanceInfo
     {
         FacetList facets;
+
+            /// Index of the members visible through `facets`, for use by lookup.
+            ///
+            /// Only set on inheritance information that has been cached by the
+            /// `SharedSemanticsContext`, so that the index is shared by all lookups
+            /// in the same type, and discarded along with the cached information when
+            /// a newly registered extension invalidates it.
+            ///
+        RefPtr<FacetMemberIndex> memberIndex;
     };
 
         /// Cached information about how to convert between two types.
@@ -614,11 +676,36 @@ namespace Slang
             /// Needed for handling `__include`s.
         TranslationUnitRequest* m_translationUnitRequest = nullptr;
 
+            /// The builder for AST nodes created while checking. This is the linkage's builder,
+            /// except when checking function bodies in parallel, where each thread has its own
+            /// (see `Linkage::getWorkerASTBuilder`).
+        ASTBuilder*     m_astBuilder = nullptr;
+
+            /// (optional) Cache used while checking. If not set, the linkage's cache is used.
+        TypeCheckingCache* m_typeCheckingCache = nullptr;
+
         DiagnosticSink* getSink()
         {
             return m_sink;
         }
 
+        ASTBuilder* getASTBuilder()
+        {
+            return m_astBuilder;
+        }
+
+        TypeCheckingCache* getTypeCheckingCache()
+        {
+            return m_typeCheckingCache ? m_typeCheckingCache : m_linkage->getTypeCheckingCache();
+        }
+
+            /// True if checking on one of the threads that check function bodies in parallel.
+            /// Declarations outside of the body being checked must then only be read.
+        bool isParallelWorker()
+        {
+            return m_astBuilder && m_astBuilder->isWorker();
+        }
+
         CompilerOptionSet& getOptionSet()
         {
             return m_linkage->m_optionSet;
@@ -643,6 +730,7 @@ namespace Slang
             , m_sink(sink)
             , m_environmentModules(environmentModules)
             , m_translationUnitRequest(translationUnit)
+            , m_astBuilder(linkage ? linkage->getASTBuilder() : nullptr)
         {}
 
         Session* getSession()
@@ -679,7 +767,7 @@ namespace Slang
 
         void registerAssociatedDecl(Decl* original, DeclAssociationKind assoc, Decl* declaration);
 
-        List<RefPtr<DeclAssociation>> const& getAssociatedDeclsForDecl(Decl* decl);
+        List<DeclAssociation*> const& getAssociatedDeclsForDecl(Decl* decl);
 
         bool isDifferentiableFunc(FunctionDeclBase* func);
         bool isBackwardDifferentiableFunc(FunctionDeclBase* func);
@@ -724,7 +812,8 @@ namespace Slang
 
             /// Mapping from a decl to additional declarations of the same decl.
             /// The additional declarations provide a location to hold extra decorations.
-        OrderedDictionary<Decl*, RefPtr<DeclAssociationList>> m_mapDeclToAssociatedDecls;
+            /// The associations are owned by the `ModuleDecl`s they are registered on.
+        Dictionary<Decl*, List<DeclAssociation*>> m_mapDeclToAssociatedDecls;
 
             /// Is the `m_mapDeclToAssociatedDecls` dictionary valid and up to date?
         bool m_associatedDeclListsBuilt = false;
@@ -732,7 +821,7 @@ namespace Slang
             /// Add associated decls declared in `moduleDecl` to `m_mapDeclToAssociatedDecls`
         void _addDeclAssociationsFromModule(ModuleDecl* moduleDecl);
 
-        ASTBuilder* _getASTBuilder() { return m_linkage->getASTBuilder(); }
+        ASTBuilder* _getASTBuilder() { return m_astBuilder; }
 
         InheritanceInfo _getInheritanceInfo(DeclRef<Decl> declRef, DeclRefType* correspondingType);
         InheritanceInfo _calcInheritanceInfo(Type* type);
@@ -852,7 +941,7 @@ namespace Slang
             SharedSemanticsContext* shared)
             : m_shared(shared)
             , m_sink(shared->getSink())
-            , m_astBuilder(shared->getLinkage()->getASTBuilder())
+            , m_astBuilder(shared->getASTBuilder())
         {
             if (shared->getLinkage()->m_optionSet.hasOption(CompilerOptionName::DisableShortCircuit))
             {
@@ -2907,6 +2996,21 @@ namespace Slang
         }
 
         void checkModule(ModuleDecl* programNode);
+
+            /// Like `ensureAllDeclsRec(decl, DeclCheckState::DefinitionChecked)`, except that functions
+            /// with a body are only checked up to `DeclCheckState::AttributesChecked`, and are added
+            /// to `outFuncs` in source order instead.
+        void _ensureAllDeclsRecExceptBodies(Decl* decl, List<FunctionDeclBase*>& outFuncs);
+
+            /// Make the lazily built state that checking a function body can reach outside of the
+            /// body (member dictionaries, witness table dictionaries, synthesized attributes and
+            /// builtin types) up to date, so that bodies can then be checked in parallel.
+        void _prepareForParallelBodyChecking(ModuleDecl* moduleDecl);
+
+            /// Like `ensureAllDeclsRec(moduleDecl, DeclCheckState::DefinitionChecked)`, except that
+            /// function bodies are checked on up to `jobCount` threads. Diagnostics are reported
+            /// in source order.
+        void _checkBodiesInParallel(ModuleDecl* moduleDecl, Index jobCount);
     };
 
     bool isUnsizedArrayType(Type* type);
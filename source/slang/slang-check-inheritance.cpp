@@ -30,6 +30,7 @@ namespace Slang
         m_mapTypeToInheritanceInfo[type] = InheritanceInfo();
 
         auto info = _calcInheritanceInfo(type);
+        info.memberIndex = new FacetMemberIndex(info.facets);
         m_mapTypeToInheritanceInfo[type] = info;
 
         return info;
@@ -63,14 +64,116 @@ namespace Slang
         m_mapDeclRefToInheritanceInfo[declRef] = InheritanceInfo();
 
         auto info = _calcInheritanceInfo(declRef, declRefType);
+        info.memberIndex = new FacetMemberIndex(info.facets);
         m_mapDeclRefToInheritanceInfo[declRef] = info;
 
-        getSession()->m_typeDictionarySize = Math::Max(
-            getSession()->m_typeDictionarySize, (int)m_mapDeclRefToInheritanceInfo.getCount());
+        if (!isParallelWorker())
+        {
+            getSession()->m_typeDictionarySize = Math::Max(
+                getSession()->m_typeDictionarySize, (int)m_mapDeclRefToInheritanceInfo.getCount());
+        }
 
         return info;
     }
 
+    List<Index> const& FacetMemberIndex::getFacetsForName(Name* name)
+    {
+        // Members can be added to a container after the index was built (e.g.,
+        // when checking synthesizes a requirement witness or a constructor), in
+        // which case the member dictionary of that container is invalidated.
+        //
+        if (!m_isBuilt || !_isUpToDate())
+            _build();
+
+        if (auto found = m_facetsForName.tryGetValue(name))
+            return *found;
+        return m_facetsWithTransparentMembers;
+    }
+
+    bool FacetMemberIndex::_isUpToDate()
+    {
+        for (auto& info : m_owners)
+        {
+            if (info.owner->getMemberInvalidationCount() != info.invalidationCount)
+                return false;
+        }
+        return true;
+    }
+
+    void FacetMemberIndex::_build()
+    {
+        m_owners.clear();
+        m_facets.clear();
+        m_facetsWithTransparentMembers.clear();
+        m_facetsForName.clear();
+
+        for (auto facet : m_facetList)
+        {
+            const Index facetIndex = m_facets.getCount();
+            m_facets.add(facet);
+
+            auto containerDeclRef = facet->getDeclRef().as<ContainerDecl>();
+            if (!containerDeclRef)
+                continue;
+            auto containerDecl = containerDeclRef.getDecl();
+
+            // Bringing the member dictionary up to date doesn't invalidate it, so
+            // the count recorded here is the one the index corresponds to.
+            //
+            auto& memberDictionary = containerDecl->getMemberDictionary();
+
+            auto owner = containerDecl->getMemberInvalidationOwner();
+            bool isKnownOwner = false;
+            for (auto& info : m_owners)
+                isKnownOwner = isKnownOwner || info.owner == owner;
+            if (!isKnownOwner)
+            {
+                OwnerInfo info;
+                info.owner = owner;
+                info.invalidationCount = owner->getMemberInvalidationCount();
+                m_owners.add(info);
+            }
+
+            if (containerDecl->getTransparentMembers().getCount())
+                m_facetsWithTransparentMembers.add(facetIndex);
+
+            for (auto& kv : memberDictionary)
+                m_facetsForName[kv.first].add(facetIndex);
+        }
+
+        // Lookup through a transparent member can find a member with any
+        // name, so the facets that have them must be visited for every name,
+        // in the same order as the other facets.
+        //
+        if (m_facetsWithTransparentMembers.getCount())
+        {
+            for (auto& kv : m_facetsForName)
+            {
+                auto& named = kv.second;
+                auto& transparent = m_facetsWithTransparentMembers;
+
+                List<Index> merged;
+                merged.reserve(named.getCount() + transparent.getCount());
+                Index i = 0, j = 0;
+                while (i < named.getCount() || j < transparent.getCount())
+                {
+                    if (j == transparent.getCount() || (i < named.getCount() && named[i] < transparent[j]))
+                        merged.add(named[i++]);
+                    else if (i == named.getCount() || transparent[j] < named[i])
+                        merged.add(transparent[j++]);
+                    else
+                    {
+                        merged.add(named[i++]);
+                        j++;
+                    }
+                }
+                named = _Move(merged);
+            }
+        }
+
+        m_isBuilt = true;
+    }
+
     InheritanceInfo SharedSemanticsContext::_calcInheritanceInfo(DeclRef<Decl> declRef, DeclRefType* declRefType)
     {
         // This method is the main engine for computing linearized inheritance
@@ -247,7 +247,7 @@ namespace Slang
                 paramDecl->setCheckState(DeclCheckState::DefinitionChecked);
 
                 paramDecl->parentDecl = attrDecl;
-                attrDecl->members.add(paramDecl);
+                attrDecl->addMember(paramDecl);
             }
         }
 
@@ -259,7 +259,7 @@ namespace Slang
         // TODO: handle the case where `parentDecl` is generic?
         //
         attrDecl->parentDecl = parentDecl;
-        parentDecl->members.add(attrDecl);
+        parentDecl->addMember(attrDecl);
         
         SLANG_ASSERT(!parentDecl->isMemberDictionaryValid());
 
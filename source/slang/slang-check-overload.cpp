@@ -2204,7 +2204,7 @@ namespace Slang
         // to speed up compilation
         bool shouldAddToCache = false;
         OperatorOverloadCacheKey key;
-        TypeCheckingCache* typeCheckingCache = getLinkage()->getTypeCheckingCache();
+        TypeCheckingCache* typeCheckingCache = getShared()->getTypeCheckingCache();
         if (auto opExpr = as<OperatorExpr>(expr))
         {
             if (key.fromOperatorExpr(opExpr))
@@ -21,6 +21,9 @@ namespace Slang
         auto module = getIRModule();
         auto linkage = getLinkage();
 
+        // The whole module is compiled, not just what an entry point uses.
+        module->materializeAllDeferredBodies();
+
         DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
         applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
         applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
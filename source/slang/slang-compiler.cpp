@@ -618,6 +618,15 @@ namespace Slang
         return endToEndReq;
     }
 
+    PersistentCache* CodeGenContext::getDownstreamResultCache()
+    {
+        const String cacheDirectory = getTargetProgram()->getOptionSet().getStringOption(CompilerOptionName::DownstreamCache);
+        if (cacheDirectory.getLength() == 0)
+            return nullptr;
+
+        return getSession()->m_downstreamCompilerSet->getOrCreateResultCache(cacheDirectory);
+    }
+
     /// If there is a pass-through compile going on, find the translation unit for the given entry point.
     /// Assumes isPassThroughEnabled has already been called
     TranslationUnitRequest* getPassThroughTranslationUnit(
@@ -1111,6 +1120,26 @@ namespace Slang
         return allPrecompiled;
     }
 
+        /// True if compiles with the `compilerType` compiler can run at the same time as other compiles.
+        ///
+        /// glslang and the LLVM based compiler hold global state, so only one compile can run at a time.
+    static bool _canCompileConcurrently(PassThroughMode compilerType)
+    {
+        switch (compilerType)
+        {
+            case PassThroughMode::Fxc:
+            case PassThroughMode::Dxc:
+            case PassThroughMode::NVRTC:
+            case PassThroughMode::Gcc:
+            case PassThroughMode::Clang:
+            case PassThroughMode::VisualStudio:
+            case PassThroughMode::MetalC:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>& outArtifact)
     {
         outArtifact.setNull();
@@ -1125,7 +1154,10 @@ namespace Slang
         RefPtr<ExtensionTracker> extensionTracker = _newExtensionTracker(target);
         PassThroughMode compilerType;
 
-        SliceAllocator allocator;
+        // The options for the compile, and everything they refer to, are held in the job, so that
+        // the compile can be deferred to the downstream compile queue.
+        RefPtr<DownstreamCompileJob> job = new DownstreamCompileJob;
+        SliceAllocator& allocator = job->allocator;
         
         if (auto endToEndReq = isPassThroughEnabled())
         {
@@ -1164,11 +1196,11 @@ namespace Slang
         List<String> includePaths;
 
         typedef DownstreamCompileOptions CompileOptions;
-        CompileOptions options;
+        CompileOptions& options = job->options;
 
-        List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+        List<DownstreamCompileOptions::CapabilityVersion>& requiredCapabilityVersions = job->requiredCapabilityVersions;
         List<String> compilerSpecificArguments;
-        List<ComPtr<IArtifact>> libraries;
+        List<ComPtr<IArtifact>>& libraries = job->libraries;
         List<String> libraryPaths;
 
         // Set compiler specific args
@@ -1190,7 +1222,7 @@ namespace Slang
             }
         }
 
-        ComPtr<IArtifact> sourceArtifact;
+        ComPtr<IArtifact>& sourceArtifact = job->sourceArtifact;
 
         /* This is more convoluted than the other scenarios, because when we invoke C/C++ compiler we would ideally like
         to use the original file. We want to do this because we want includes relative to the source file to work, and
@@ -1594,16 +1626,76 @@ namespace Slang
         options.requiredCapabilityVersions = SliceUtil::asSlice(requiredCapabilityVersions);
         options.libraries = SliceUtil::asSlice(libraries);
         options.libraryPaths = allocator.allocate(libraryPaths);
-        
+
+        job->compiler = compiler;
+        job->resultCache = getDownstreamResultCache();
+
+        // If there is a queue, and nothing the compile uses is shared with other compiles, defer it
+        // so it can run at the same time as the compiles of the other entry points and targets.
+        auto queue = m_shared->downstreamCompileQueue;
+        if (queue &&
+            !isPassThroughEnabled() &&
+            !isPrecompiled() &&
+            getLinkage()->m_libModules.getCount() == 0 &&
+            _canCompileConcurrently(compilerType))
+        {
+            // The include handlers may add files to the source manager, which can't be
+            // shared between threads. The generated source doesn't need it.
+            options.sourceManager = nullptr;
+
+            queue->add(job, outArtifact);
+            return SLANG_OK;
+        }
+
         // Compile
-        ComPtr<IArtifact> artifact;
-        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
-        auto downstreamElapsedTime =
-            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-        getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+        job->compile();
+        return job->finish(session, sink, outArtifact);
+    }
+
+    void DownstreamCompileJob::compile()
+    {
+        if (findCachedResult())
+            return;
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ComPtr<IArtifact> compiledArtifact;
+        const SlangResult compileResult = compiler->compile(options, compiledArtifact.writeRef());
+        setCompileResult(
+            compileResult,
+            compiledArtifact,
+            (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001);
+    }
+
+    bool DownstreamCompileJob::findCachedResult()
+    {
+        if (!resultCache)
+            return false;
+
+        const SlangResult findResult = DownstreamCompilerUtil::findCachedCompileResult(
+            compiler, options, resultCache, resultCacheKey, artifact.writeRef());
+        shouldCacheResult = (findResult == SLANG_E_NOT_FOUND);
+        if (SLANG_FAILED(findResult))
+            return false;
+
+        result = SLANG_OK;
+        return true;
+    }
+
+    void DownstreamCompileJob::setCompileResult(SlangResult compileResult, IArtifact* compiledArtifact, double compileTime)
+    {
+        result = compileResult;
+        artifact = compiledArtifact;
+        elapsedTime = compileTime;
+        if (SLANG_SUCCEEDED(result) && shouldCacheResult)
+            DownstreamCompilerUtil::addCompileResultToCache(resultCache, resultCacheKey, artifact);
+    }
+
+    SlangResult DownstreamCompileJob::finish(Session* session, DiagnosticSink* sink, ComPtr<IArtifact>& outArtifact)
+    {
+        SLANG_RETURN_ON_FAIL(result);
+        session->addDownstreamCompileTime(elapsedTime);
 
-        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(getSink(), compiler, artifact));
+        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(sink, compiler, artifact));
 
         // Copy over all of the information associated with the source into the output
         if (sourceArtifact)
@@ -1619,6 +1711,91 @@ namespace Slang
         return SLANG_OK;
     }
 
+    void DownstreamCompileQueue::add(DownstreamCompileJob* job, ComPtr<IArtifact>& outArtifact)
+    {
+        Entry entry;
+        entry.job = job;
+        entry.outArtifact = std::addressof(outArtifact);
+        m_entries.add(entry);
+    }
+
+        /// Compile `jobs`, whose compilers all run as a separate process, with at most `maxProcessCount`
+        /// processes running at once.
+    static void _compileInProcesses(List<DownstreamCompileJob*> const& jobs, Count maxProcessCount)
+    {
+        List<DownstreamCompileJob*> compileJobs;
+        List<CommandLineDownstreamCompiler*> compilers;
+        List<DownstreamCompileOptions> options;
+        for (auto job : jobs)
+        {
+            if (job->findCachedResult())
+                continue;
+            compileJobs.add(job);
+            compilers.add(as<CommandLineDownstreamCompiler>(job->compiler.get()));
+            options.add(job->options);
+        }
+
+        const Count count = compileJobs.getCount();
+        List<SlangResult> results;
+        List<ComPtr<IArtifact>> artifacts;
+        results.setCount(count);
+        artifacts.setCount(count);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        CommandLineDownstreamCompiler::compileAll(
+            compilers.getBuffer(),
+            options.getBuffer(),
+            count,
+            maxProcessCount,
+            results.getBuffer(),
+            artifacts.getBuffer());
+        const double elapsedTime = (std::chrono::high_resolution_clock::now() - startTime).count() * 0.000000001;
+
+        // The processes run at the same time, so the time taken is shared between them
+        for (Index i = 0; i < count; ++i)
+        {
+            compileJobs[i]->setCompileResult(results[i], artifacts[i], elapsedTime / double(count));
+        }
+    }
+
+    void DownstreamCompileQueue::run(Session* session, DiagnosticSink* sink)
+    {
+        List<DownstreamCompileJob*> processJobs;
+        List<DownstreamCompileJob*> threadJobs;
+        for (auto& entry : m_entries)
+        {
+            auto job = entry.job.Ptr();
+            if (as<CommandLineDownstreamCompiler>(job->compiler.get()))
+                processJobs.add(job);
+            else
+                threadJobs.add(job);
+        }
+
+        // The processes are run, and their output read, as the first iteration, so they run
+        // at the same time as the in process compiles. The jobs only touch their own state, so
+        // nothing else needs to be synchronized.
+        const Count processIterationCount = processJobs.getCount() ? 1 : 0;
+        session->getThreadPool()->forEach(
+            processIterationCount + threadJobs.getCount(),
+            m_maxConcurrentJobs,
+            [&](Index index, Index threadSlot)
+            {
+                SLANG_UNUSED(threadSlot);
+                if (index < processIterationCount)
+                    _compileInProcesses(processJobs, m_maxConcurrentJobs);
+                else
+                    threadJobs[index - processIterationCount]->compile();
+            });
+
+        // Diagnostics are reported, and the results set, in the order the compiles were added,
+        // so the output is the same as if they had run one after the other.
+        for (auto& entry : m_entries)
+        {
+            entry.job->finish(session, sink, *entry.outArtifact);
+        }
+        m_entries.clear();
+    }
+
     SlangResult emitSPIRVForEntryPointsDirectly(
         CodeGenContext* codeGenContext,
         ComPtr<IArtifact>& outArtifact);
@@ -1713,7 +1890,9 @@ namespace Slang
             {
                 SLANG_RETURN_ON_FAIL(_emitEntryPoints(outArtifact));
 
-                maybeDumpIntermediate(outArtifact);
+                // If the downstream compile was deferred there is nothing to dump yet.
+                if (outArtifact)
+                    maybeDumpIntermediate(outArtifact);
                 return SLANG_OK;
             }
             break;
@@ -1848,7 +2027,8 @@ namespace Slang
 
     IArtifact* TargetProgram::_createWholeProgramResult(
         DiagnosticSink* sink,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        DownstreamCompileQueue* downstreamCompileQueue)
     {
         // We want to call `emitEntryPoints` function to generate code that contains
         // all the entrypoints defined in `m_program`.
@@ -1861,7 +2041,7 @@ namespace Slang
         for (Index i = 0; i < entryPointIndices.getCount(); i++)
             entryPointIndices[i] = i;
     
-        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq, downstreamCompileQueue);
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
         if (SLANG_FAILED(codeGenContext.emitEntryPoints(m_wholeProgramResult)))
@@ -1875,7 +2055,8 @@ namespace Slang
     IArtifact* TargetProgram::_createEntryPointResult(
         Int                     entryPointIndex,
         DiagnosticSink*         sink,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        DownstreamCompileQueue* downstreamCompileQueue)
     {
         // It is possible that entry points got added to the `Program`
         // *after* we created this `TargetProgram`, so there might be
@@ -1892,7 +2073,7 @@ namespace Slang
         CodeGenContext::EntryPointIndices entryPointIndices;
         entryPointIndices.add(entryPointIndex);
 
-        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq);
+        CodeGenContext::Shared sharedCodeGenContext(this, entryPointIndices, sink, endToEndReq, downstreamCompileQueue);
         CodeGenContext codeGenContext(&sharedCodeGenContext);
 
         codeGenContext.emitEntryPoints(m_entryPointResults[entryPointIndex]);
@@ -1942,26 +2123,59 @@ namespace Slang
             sink);
     }
 
+    bool TargetProgram::canQueueDownstreamCompiles()
+    {
+        auto& optionSet = getOptionSet();
+        if (optionSet.getBoolOption(CompilerOptionName::DumpIntermediates))
+            return false;
+
+        switch (getTargetReq()->getTarget())
+        {
+            case CodeGenTarget::SPIRV:
+                return !optionSet.shouldEmitSPIRVDirectly();
+            case CodeGenTarget::DXIL:
+            case CodeGenTarget::DXBytecode:
+            case CodeGenTarget::MetalLib:
+            case CodeGenTarget::PTX:
+            case CodeGenTarget::ShaderHostCallable:
+            case CodeGenTarget::ShaderSharedLibrary:
+            case CodeGenTarget::HostExecutable:
+            case CodeGenTarget::HostHostCallable:
+            case CodeGenTarget::HostSharedLibrary:
+                return true;
+            default:
+                return false;
+        }
+    }
+
     void EndToEndCompileRequest::generateOutput(
-        TargetProgram* targetProgram)
+        TargetProgram* targetProgram,
+        DownstreamCompileQueue* downstreamCompileQueue)
     {
         auto program = targetProgram->getProgram();
 
+        if (!targetProgram->canQueueDownstreamCompiles())
+            downstreamCompileQueue = nullptr;
+
         // Generate target code any entry points that
         // have been requested for compilation.
         auto entryPointCount = program->getEntryPointCount();
         if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::GenerateWholeProgram))
         {
-            targetProgram->_createWholeProgramResult(getSink(), this);
+            targetProgram->_createWholeProgramResult(getSink(), this, downstreamCompileQueue);
         }
         else
         {
+            // The queue holds pointers into the results, so they must all be allocated up front.
+            targetProgram->reserveEntryPointResults(entryPointCount);
+
             for (Index ii = 0; ii < entryPointCount; ++ii)
             {
                 targetProgram->_createEntryPointResult(
                     ii,
                     getSink(),
-                    this);
+                    this,
+                    downstreamCompileQueue);
             }
         }
     }
@@ -2293,11 +2507,20 @@ namespace Slang
         // has specified, and generate code for each of them.
         //
         auto linkage = getLinkage();
+
+        // If asked for, the downstream compiles are collected across all of the targets, and run
+        // together once all of the code has been generated.
+        const Count downstreamJobCount = getOptionSet().getIntOption(CompilerOptionName::DownstreamJobs);
+        DownstreamCompileQueue downstreamCompileQueue(downstreamJobCount);
+        DownstreamCompileQueue* queue = downstreamJobCount > 1 ? &downstreamCompileQueue : nullptr;
+
         for (auto targetReq : linkage->targets)
         {
             auto targetProgram = program->getTargetProgram(targetReq);
-            generateOutput(targetProgram);
+            generateOutput(targetProgram, queue);
         }
+
+        downstreamCompileQueue.run(getSession(), getSink());
     }
 
     void EndToEndCompileRequest::generateOutput()
@@ -2358,6 +2581,134 @@ namespace Slang
         }
     }
 
+    SlangResult EndToEndCompileRequest::_createPermutations(
+        ComponentType*                          program,
+        List<ComponentType::Permutation>&       outPermutations)
+    {
+        auto sink = getSink();
+        auto linkage = getLinkage();
+
+        for (Index pp = 0; pp < m_permutationArgStrings.getCount(); ++pp)
+        {
+            ComponentType::Permutation permutation;
+
+            // Values for link-time constants are provided by a small
+            // module that defines them, which is linked into the
+            // permutation.
+            //
+            StringBuilder constantsSource;
+            for (auto& argString : m_permutationArgStrings[pp])
+            {
+                const Index equalsIndex = argString.indexOf('=');
+                if (equalsIndex < 0)
+                {
+                    Type* type = program->getTypeFromString(argString, sink);
+                    if (!type)
+                        return SLANG_FAIL;
+
+                    SpecializationArg arg;
+                    arg.val = type;
+                    permutation.specializationArgs.add(arg);
+                    continue;
+                }
+
+                String name = argString.getUnownedSlice().head(equalsIndex).trim();
+                String value = argString.getUnownedSlice().tail(equalsIndex + 1).trim();
+
+                auto declRef = program->findDeclFromString(name, sink);
+                auto varDecl = as<VarDeclBase>(declRef.getDecl());
+                if (!varDecl || !varDecl->type.type || !varDecl->hasModifier<ExternModifier>())
+                {
+                    sink->diagnose(SourceLoc(), Diagnostics::expectedLinkTimeConstantForPermutation, name);
+                    return SLANG_FAIL;
+                }
+
+                constantsSource << "export static const " << varDecl->type.type->toString();
+                constantsSource << " " << name << " = " << value << ";\n";
+            }
+
+            if (constantsSource.getLength() != 0)
+            {
+                String moduleName = "permutation" + String(pp) + "Constants";
+                RefPtr<Module> module = linkage->loadModule(
+                    getNamePool()->getName(moduleName),
+                    PathInfo::makeFromString(moduleName + ".slang"),
+                    StringBlob::moveCreate(constantsSource),
+                    SourceLoc(),
+                    sink,
+                    nullptr,
+                    ModuleBlobType::Source);
+                if (!module)
+                    return SLANG_FAIL;
+                permutation.linkTimeComponents.add(module);
+            }
+
+            outPermutations.add(permutation);
+        }
+        return SLANG_OK;
+    }
+
+    SlangResult EndToEndCompileRequest::generatePermutationOutput()
+    {
+        SLANG_PROFILE;
+
+        auto linkage = getLinkage();
+        auto program = getUnspecializedGlobalAndEntryPointsComponentType();
+
+        List<ComponentType::Permutation> permutations;
+        SLANG_RETURN_ON_FAIL(_createPermutations(program, permutations));
+
+        // Each permutation of an entry point is written to the output path
+        // for the entry point with the index of the permutation appended
+        // to the file name (e.g. `shader.spv` becomes `shader-0.spv`, ...)
+        //
+        SlangResult result = SLANG_OK;
+        for (auto targetReq : linkage->targets)
+        {
+            Index entryPointCount = program->getEntryPointCount();
+            for (Index ee = 0; ee < entryPointCount; ++ee)
+            {
+                List<ComPtr<IArtifact>> artifacts;
+                if (SLANG_FAILED(program->generateEntryPointPermutations(
+                    ee,
+                    targetReq,
+                    permutations,
+                    getSink(),
+                    artifacts)))
+                {
+                    result = SLANG_FAIL;
+                }
+
+                if (!m_isCommandLineCompile)
+                    continue;
+
+                const auto path = _getEntryPointPath(targetReq, ee);
+                for (Index pp = 0; pp < artifacts.getCount(); ++pp)
+                {
+                    if (!artifacts[pp])
+                        continue;
+
+                    String permutationPath;
+                    if (path.getLength() != 0)
+                    {
+                        StringBuilder builder;
+                        builder << Path::getPathWithoutExt(path) << "-" << pp;
+                        auto ext = Path::getPathExt(path);
+                        if (ext.getLength() != 0)
+                            builder << "." << ext;
+                        permutationPath = builder.produceString();
+                    }
+                    _maybeWriteArtifact(permutationPath, artifacts[pp]);
+                }
+            }
+        }
+
+        if (m_isCommandLineCompile)
+            _writeDependencyFile(this);
+
+        return result;
+    }
+
     // Debug logic for dumping intermediate outputs
 
     
@@ -7,6 +7,7 @@
 
 #include "../compiler-core/slang-downstream-compiler.h"
 #include "../compiler-core/slang-downstream-compiler-util.h"
+#include "../compiler-core/slang-slice-allocator.h"
 
 #include "../compiler-core/slang-name.h"
 #include "../compiler-core/slang-include-system.h"
@@ -20,6 +21,7 @@
 #include "../core/slang-command-options.h"
 
 #include "../core/slang-file-system.h"
+#include "../core/slang-thread-pool.h"
 
 #include "slang-com-ptr.h"
 
@@ -32,6 +34,7 @@
 #include "slang-hlsl-to-vulkan-layout-options.h"
 #include "slang-compiler-options.h"
 #include "slang-serialize-ir-types.h"
+#include "slang-memory-report.h"
 
 #include "../compiler-core/slang-artifact-representation-impl.h"
 
@@ -45,8 +48,11 @@ namespace Slang
     class PtrType;
     class TargetProgram;
     class TargetRequest;
+    struct IRInst;
+    struct IRModuleSymbolIndex;
     class TypeLayout;
     class Artifact;
+    class SpvSnippetCache;
 
     enum class CompilerMode
     {
@@ -142,6 +148,13 @@ namespace Slang
         Maximal     = SLANG_DEBUG_INFO_LEVEL_MAXIMAL,
     };
 
+    enum class DebugInfoSourceMode : SlangDebugInfoSourceModeIntegral
+    {
+        Embed       = SLANG_DEBUG_INFO_SOURCE_MODE_EMBED,
+        Path        = SLANG_DEBUG_INFO_SOURCE_MODE_PATH,
+        Hash        = SLANG_DEBUG_INFO_SOURCE_MODE_HASH,
+    };
+
     enum class DebugInfoFormat : SlangDebugInfoFormatIntegral
     {
         Default     = SLANG_DEBUG_INFO_FORMAT_DEFAULT,
@@ -164,6 +177,7 @@ namespace Slang
     };
 
     struct CodeGenContext;
+    class DownstreamCompileQueue;
     class EndToEndCompileRequest;
     class FrontEndCompileRequest;
     class Linkage;
@@ -291,7 +305,7 @@ namespace Slang
         /// Base class for "component types" that represent the pieces a final
         /// shader program gets linked together from.
         ///
-    class ComponentType : public RefObject, public slang::IComponentType
+    class ComponentType : public RefObject, public slang::IComponentType, public slang::IComponentType2
     {
     public:
         //
@@ -355,6 +369,48 @@ namespace Slang
             slang::CompilerOptionEntry* entries,
             ISlangBlob** outDiagnostics) override;
 
+        //
+        // slang::IComponentType2 interface
+        //
+
+        SLANG_NO_THROW SlangResult SLANG_MCALL getEntryPointCodeForPermutations(
+            SlangInt                            entryPointIndex,
+            SlangInt                            targetIndex,
+            slang::PermutationDesc const*       permutations,
+            SlangInt                            permutationCount,
+            slang::IBlob**                      outCodes,
+            slang::IBlob**                      outDiagnostics) SLANG_OVERRIDE;
+
+            /// A variant of a program, as compiled by `generateEntryPointPermutations`.
+        struct Permutation
+        {
+                /// Arguments for the specialization parameters of the linked program
+            List<SpecializationArg> specializationArgs;
+
+                /// Extra components to link in, such as modules defining link-time constants
+            List<RefPtr<ComponentType>> linkTimeComponents;
+        };
+
+            /// Generate code for the entry point at `entryPointIndex` on `target`,
+            /// for each of the variants of this component type in `permutations`.
+            ///
+            /// This component type is composed with its dependencies once, and all the
+            /// variants share the resulting checked modules and their IR. The links of the
+            /// variants share the choices of definitions made for the stdlib and those modules.
+            /// Each variant is still specialized and optimized on its own, one at a time, and
+            /// the downstream compiles of all of the variants are then run together on the
+            /// session's thread pool.
+            ///
+            /// On return `outArtifacts` holds one artifact per permutation, which is
+            /// null for any permutation that failed. Errors are reported to `sink`.
+            ///
+        SlangResult generateEntryPointPermutations(
+            Index                           entryPointIndex,
+            TargetRequest*                  target,
+            List<Permutation> const&        permutations,
+            DiagnosticSink*                 sink,
+            List<ComPtr<IArtifact>>&        outArtifacts);
+
         CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
             /// Get the linkage (aka "session" in the public API) for this component type.
@@ -1292,6 +1348,60 @@ namespace Slang
 
     class SourceFile;
 
+        /// The preprocessor state that the source code of a module was parsed under.
+        ///
+        /// The preprocessor records the name of every macro it looks up, whether or not
+        /// a definition is found. A definition whose name was never looked up cannot
+        /// have affected the tokens of the module, so a module can be reused under any
+        /// set of definitions that agrees with `definitions` on the looked-up names.
+        ///
+    struct PreprocessorFootprint
+    {
+            /// Is there a recorded footprint? Modules that were not parsed from
+            /// source (e.g., deserialized modules) do not have one.
+        bool isRecorded = false;
+
+            /// The language the source was parsed as
+        SourceLanguage sourceLanguage = SourceLanguage::Unknown;
+
+            /// All of the preprocessor definitions that were set on input
+        Dictionary<String, String> definitions;
+
+            /// The names of all macros the preprocessor consulted
+        HashSet<Name*> consultedMacroNames;
+
+            /// Would parsing under `otherDefinitions` produce the same result?
+        bool isCompatibleWith(Dictionary<String, String> const& otherDefinitions, NamePool* namePool) const;
+    };
+
+        /// Digests of the source of a module, used to reuse the IR of functions whose
+        /// bodies have not changed when the module is compiled again after an edit.
+        ///
+        /// The signature digest covers the compile options and every file the module
+        /// depends on, leaving out the text of the function bodies that have an entry
+        /// in `bodyDigests`. If two builds of a module have the same signature digest,
+        /// the IR of a function whose body digest also matches can be taken from the
+        /// earlier build instead of being lowered again.
+        ///
+    struct IRReuseDigests
+    {
+            /// Have the digests been computed (or read)? Modules written by older
+            /// versions do not have them.
+        bool isRecorded = false;
+
+        SHA1::Digest signatureDigest;
+
+            /// The digest of each reusable function body, keyed by the mangled name of the function
+        Dictionary<String, SHA1::Digest> bodyDigests;
+    };
+
+        /// The IR of an earlier build of a module that is being compiled again from source.
+    struct IRReuseSource : public RefObject
+    {
+        IRReuseDigests digests;
+        RefPtr<IRModule> irModule;
+    };
+
         /// A module of code that has been compiled through the front-end
         ///
         /// A module comprises all the code from one translation unit (which
@@ -1525,7 +1635,9 @@ namespace Slang
 
         void setName(String name);
         void setName(Name* name) { m_name = name; }
+        Name* getNameObj() { return m_name; }
         void setPathInfo(PathInfo pathInfo) { m_pathInfo = pathInfo; }
+        PathInfo const& getPathInfo() const { return m_pathInfo; }
 
             /// Set the IR for this module.
             ///
@@ -1554,6 +1666,9 @@ namespace Slang
             /// If not found returns nullptr.
         NodeBase* findExportFromMangledName(const UnownedStringSlice& slice);
 
+            /// Get the pool of mangled names used by `findExportFromMangledName`.
+        const StringSlicePool& getMangledExportPool() const { return m_mangledExportPool; }
+
             /// Get the ASTBuilder
         ASTBuilder* getASTBuilder() { return m_astBuilder; }
 
@@ -1593,6 +1708,25 @@ namespace Slang
         // Gets the files that has been included into the module.
         Dictionary<SourceFile*, FileDecl*>& getIncludedSourceFileMap() { return m_mapSourceFileToFileDecl; }
 
+            /// Get the preprocessor state the source of this module was parsed under
+        PreprocessorFootprint& getPreprocessorFootprint() { return m_preprocessorFootprint; }
+
+            /// Get the digests used to reuse the IR of unchanged functions when this module is
+            /// compiled again. They are computed from the checked AST on first use.
+        IRReuseDigests const& getIRReuseDigests();
+        void setIRReuseDigests(IRReuseDigests const& digests) { m_irReuseDigests = digests; }
+
+            /// Get an estimate of the memory held by this module, in bytes.
+            ///
+            /// This counts the IR, and the AST if the module doesn't share its
+            /// `ASTBuilder` with the linkage.
+        size_t getMemoryUsage();
+
+            /// Get/set when the module was last loaded or imported through its linkage.
+            /// The value is only meaningful relative to other modules of the same linkage.
+        UInt64 getLastUseTick() const { return m_lastUseTick; }
+        void setLastUseTick(UInt64 tick) { m_lastUseTick = tick; }
+
     protected:
         void acceptVisitor(ComponentTypeVisitor* visitor, SpecializationInfo* specializationInfo) SLANG_OVERRIDE;
 
@@ -1656,6 +1790,15 @@ namespace Slang
 
         // Source files that have been pulled into the module with `__include`.
         Dictionary<SourceFile*, FileDecl*> m_mapSourceFileToFileDecl;
+
+        // The preprocessor definitions this module depends on.
+        PreprocessorFootprint m_preprocessorFootprint;
+
+        // Digests used to reuse IR from this module when it is compiled again.
+        IRReuseDigests m_irReuseDigests;
+
+        // When the module was last used, for choosing which modules to unload first.
+        UInt64 m_lastUseTick = 0;
     };
     typedef Module LoadedModule;
 
@@ -1899,7 +2042,7 @@ namespace Slang
     struct SerialContainerDataModule;
 
         /// A context for loading and re-using code modules.
-    class Linkage : public RefObject, public slang::ISession
+    class Linkage : public RefObject, public slang::ISession, public slang::ISessionMemoryUsage
     {
     public:
         SLANG_REF_OBJECT_IUNKNOWN_ALL
@@ -1976,6 +2119,26 @@ namespace Slang
         virtual SLANG_NO_THROW slang::IModule* SLANG_MCALL getLoadedModule(SlangInt index) override;
         virtual SLANG_NO_THROW bool SLANG_MCALL isBinaryModuleUpToDate(const char* modulePath, slang::IBlob* binaryModuleBlob) override;
 
+        // slang::ISessionMemoryUsage interface, implemented in slang-memory-report.cpp
+        virtual SLANG_NO_THROW SlangInt SLANG_MCALL getMemoryUsageEntryCount() override;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsageEntry(
+            SlangInt index,
+            slang::MemoryUsageEntry* outEntry) override;
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getMemoryUsageReport(slang::IBlob** outReport) override;
+
+            /// Measure the memory currently held by the linkage and the modules it has loaded.
+        void collectMemoryUsage(MemoryUsageSnapshot& outSnapshot);
+
+            /// Record the memory held at the end of the phase `phaseName`, if
+            /// `CompilerOptionName::ReportMemory` is set.
+            ///
+            /// `linkedIRModule` is the IR module being linked for code generation, if any.
+            /// It isn't held by the linkage, so it can't be found otherwise.
+        void recordMemoryUsage(const char* phaseName, IRModule* linkedIRModule = nullptr);
+
+            /// Get the memory use recorded by `recordMemoryUsage`.
+        const MemoryReport& getMemoryReport() { return m_memoryReport; }
+
         // Updates the supplied builder with linkage-related information, which includes preprocessor
         // defines, the compiler version, and other compiler options. This is then merged with the hash
         // produced for the program to produce a key that can be used with the shader cache.
@@ -2022,6 +2185,14 @@ namespace Slang
 
         RefPtr<ASTBuilder> m_astBuilder;
 
+            /// Get the builder for the AST nodes created by thread `threadSlot` while function
+            /// bodies are checked in parallel. It shares the `Val` cache of `getASTBuilder()`.
+            /// Should only be called from the thread that owns the linkage.
+        ASTBuilder* getWorkerASTBuilder(Index threadSlot);
+
+            /// Declared after `m_astBuilder` so they are released before it
+        List<RefPtr<ASTBuilder>> m_workerASTBuilders;
+
         // Cache for container types.
         Dictionary<ContainerTypeKey, Type*> m_containerTypes;
 
@@ -2115,6 +2286,10 @@ namespace Slang
 
         SourceFile* loadSourceFile(String pathFrom, String path);
 
+            /// Get the preprocessor definitions that a module `import`ed through this
+            /// linkage would be parsed under, if its source is in `sourceLanguage`.
+        Dictionary<String, String> getImportPreprocessorDefinitions(SourceLanguage sourceLanguage);
+
         void loadParsedModule(
             RefPtr<FrontEndCompileRequest>  compileRequest,
             RefPtr<TranslationUnitRequest>  translationUnit,
@@ -2126,6 +2301,14 @@ namespace Slang
 
         bool isBinaryModuleUpToDate(String fromPath, RiffContainer* container);
 
+            /// Remove and return the IR kept from an out of date binary module for `name`, if any.
+        RefPtr<IRReuseSource> takeIRReuseSource(Name* name);
+
+            /// Get the number of function bodies whose IR was reused from out of date binary modules.
+        Index getReusedFuncBodyCount() const { return m_reusedFuncBodyCount; }
+            /// Add `count` function bodies whose IR was reused when lowering a module.
+        void addReusedFuncBodyCount(Index count) { m_reusedFuncBodyCount += count; }
+
         RefPtr<Module> findOrImportModule(
             Name*               name,
             SourceLoc const&    loc,
@@ -2228,6 +2411,57 @@ namespace Slang
             /// Is the given module in the middle of being imported?
         bool isBeingImported(Module* module);
 
+        // Modules that were parsed under preprocessor definitions that are no longer in
+        // effect for this linkage. They are kept so that a later import under compatible
+        // definitions can reuse them instead of parsing and checking the source again.
+        List<RefPtr<LoadedModule>> m_inactiveModules;
+
+            /// Can `module` be used to satisfy an import under the current preprocessor definitions?
+        bool _isModuleCompatibleWithCurrentDefinitions(Module* module);
+
+            /// Stop using `module` (loaded as `name`) to satisfy imports, but keep it for later reuse.
+        void _deactivateModule(Name* name, Module* module);
+
+            /// Find an inactive module loaded as `name` that is compatible with the current
+            /// preprocessor definitions, and make it active again.
+        Module* _reactivateCompatibleModule(Name* name);
+
+        // The IR of binary modules that were found to be out of date, kept until the module
+        // is compiled from source so that lowering can reuse the functions that haven't changed.
+        Dictionary<Name*, RefPtr<IRReuseSource>> m_irReuseSources;
+
+        // The number of function bodies whose IR was reused from out of date binary modules
+        // instead of being lowered from the AST.
+        Index m_reusedFuncBodyCount = 0;
+
+            /// Keep the IR in the out of date binary module `container` for reuse when `name` is
+            /// compiled from source.
+        void _addIRReuseSource(Name* name, RiffContainer* container, DiagnosticSink* sink);
+
+        // Memory use recorded at the end of each pipeline phase.
+        MemoryReport m_memoryReport;
+
+        // The entries measured by the last call to `getMemoryUsageEntryCount`.
+        List<slang::MemoryUsageEntry> m_memoryUsageEntries;
+
+        // Incremented each time a module is loaded or imported through the public API,
+        // to order modules by how recently they were used.
+        UInt64 m_moduleUseTick = 0;
+
+            /// Record that `module`, and the modules it depends on, were just used.
+        void _noteModuleUse(Module* module);
+
+            /// Can `module` be unloaded without invalidating anything that is still in use?
+            /// `dependentCounts` holds the number of other loaded modules that depend on each module.
+        bool _canUnloadModule(Module* module, Dictionary<Module*, Index> const& dependentCounts);
+
+            /// Remove `module` from every list and map in the linkage, releasing it.
+        void _unloadModule(Module* module);
+
+            /// If the loaded modules use more memory than `CompilerOptionName::ModuleMemoryBudget`
+            /// allows, unload the least recently used modules that can be unloaded.
+        void _enforceModuleMemoryBudget();
+
             /// Diagnose that an error occured in the process of importing a module
         void _diagnoseErrorInImportedModule(
             DiagnosticSink*     sink);
@@ -2420,6 +2654,41 @@ namespace Slang
         void visitChildren(SpecializedComponentType* specialized);
     };
 
+        /// Decisions made when linking the IR of a program for a target, that are the same
+        /// for every entry point of the program, and so can be shared between their links.
+        ///
+        /// Only the choice of definition is kept for each symbol, not the IR cloned for it.
+        /// A link clones into a fresh module that the passes after linking then change in place,
+        /// and what they do to a symbol depends on the entry point: its layout, the values it
+        /// specializes generics with, and which of its callers are inlined. A symbol's cloned IR
+        /// would still have to be cloned again for each link, which is most of the cost of
+        /// linking it from the original module.
+        ///
+    struct IRLinkCache
+    {
+            /// The state of a linked module when the cache was filled in. Modules are identified by
+            /// `IRModule::getUniqueId` rather than by address, so a module that replaces a destroyed
+            /// one can't be mistaken for it.
+        struct ModuleState
+        {
+            uint64_t moduleUniqueId;
+            uint64_t globalModificationCount;
+        };
+
+            /// The modules that choices are cached from. The cache is only used by a link that
+            /// links all of them, unchanged. If it doesn't, the cache is out of date.
+            ///
+            /// A link can also link modules that aren't in the cache (such as the module of a
+            /// specialization, when the cache is shared between the specializations of a program).
+            /// Names with definitions in any of those are not cached.
+        List<ModuleState> moduleStates;
+
+            /// For each mangled name that has been linked, the definition that was chosen
+            /// as best for the target. Keys are names held by the modules in `moduleStates`, and
+            /// are only used while those modules are being linked, and so are still alive.
+        Dictionary<UnownedStringSlice, IRInst*> bestValues;
+    };
+
         /// A `TargetProgram` represents a `ComponentType` specialized for a particular `TargetRequest`
         ///
         /// TODO: This should probably be renamed to `TargetComponentType`.
@@ -2488,9 +2757,17 @@ namespace Slang
             return m_entryPointResults[entryPointIndex];
         }
 
+            /// Make sure there is space for the results of at least `entryPointCount` entry points.
+        void reserveEntryPointResults(Count entryPointCount)
+        {
+            if (entryPointCount > m_entryPointResults.getCount())
+                m_entryPointResults.setCount(entryPointCount);
+        }
+
         IArtifact* _createWholeProgramResult(
             DiagnosticSink*         sink,
-            EndToEndCompileRequest* endToEndReq = nullptr);
+            EndToEndCompileRequest* endToEndReq = nullptr,
+            DownstreamCompileQueue* downstreamCompileQueue = nullptr);
 
             /// Internal helper for `getOrCreateEntryPointResult`.
             ///
@@ -2502,7 +2779,8 @@ namespace Slang
         IArtifact* _createEntryPointResult(
             Int                     entryPointIndex,
             DiagnosticSink*         sink,
-            EndToEndCompileRequest* endToEndReq = nullptr);
+            EndToEndCompileRequest* endToEndReq = nullptr,
+            DownstreamCompileQueue* downstreamCompileQueue = nullptr);
 
         RefPtr<IRModule> getOrCreateIRModuleForLayout(DiagnosticSink* sink);
 
@@ -2511,6 +2789,19 @@ namespace Slang
             return m_irModuleForLayout;
         }
 
+            /// Get the cache that links for different entry points of the program share.
+        IRLinkCache* getLinkCache() { return m_sharedLinkCache ? m_sharedLinkCache : &m_linkCache; }
+
+            /// Make links of this program use `linkCache`, which belongs to the target program of
+            /// a program that this one builds on (and so keeps alive), instead of its own cache.
+        void setSharedLinkCache(IRLinkCache* linkCache) { m_sharedLinkCache = linkCache; }
+
+            /// True if the downstream compiles for this program can be added to a `DownstreamCompileQueue`.
+            ///
+            /// That is the case for targets whose result is the output of the downstream compiler as is.
+            /// Targets whose result is derived from the output (such as disassembly) need it straight away.
+        bool canQueueDownstreamCompiles();
+
         CompilerOptionSet& getOptionSet() { return m_optionSet; }
 
         HLSLToVulkanLayoutOptions* getHLSLToVulkanLayoutOptions() { return m_targetReq->getHLSLToVulkanLayoutOptions(); }
@@ -2541,6 +2832,9 @@ namespace Slang
         List<ComPtr<IArtifact>> m_entryPointResults;
 
         RefPtr<IRModule> m_irModuleForLayout;
+
+        IRLinkCache m_linkCache;
+        IRLinkCache* m_sharedLinkCache = nullptr;
     };
 
         /// A back-end-specific object to track optional feaures/capabilities/extensions
@@ -2573,6 +2867,78 @@ namespace Slang
     public:
     };
 
+        /// A compile by a downstream compiler, along with the storage its options refer to.
+    struct DownstreamCompileJob : public RefObject
+    {
+            /// Compile, setting `artifact`, `result` and `elapsedTime`. Can be called on any thread.
+        void compile();
+            /// If `resultCache` holds the result of the compile, set `artifact` and `result` from it,
+            /// and return true. Can be called on any thread.
+        bool findCachedResult();
+            /// Set the result of a compile that was run elsewhere, and add it to `resultCache`.
+        void setCompileResult(SlangResult compileResult, IArtifact* compiledArtifact, double compileTime);
+            /// Report the diagnostics of the compile to `sink`, and copy over the artifacts associated
+            /// with the source. Returns the artifact if the compile succeeded.
+        SlangResult finish(Session* session, DiagnosticSink* sink, ComPtr<IArtifact>& outArtifact);
+
+        ComPtr<IDownstreamCompiler> compiler;
+        DownstreamCompileOptions options;
+            /// If set, results are looked up in, and added to, the cache.
+        RefPtr<PersistentCache> resultCache;
+
+        // Storage for the data `options` refer to
+        SliceAllocator allocator;
+        ComPtr<IArtifact> sourceArtifact;
+        List<ComPtr<IArtifact>> libraries;
+        List<DownstreamCompileOptions::CapabilityVersion> requiredCapabilityVersions;
+
+        // Set by `compile`
+        ComPtr<IArtifact> artifact;
+        SlangResult result = SLANG_OK;
+        double elapsedTime = 0;
+
+        // Set by `findCachedResult` if the result of the compile should be added to the cache
+        PersistentCache::Key resultCacheKey;
+        bool shouldCacheResult = false;
+    };
+
+        /// Downstream compiles deferred so they can run at the same time.
+        ///
+        /// Code generation for the entry points and targets of a program runs one at a time, but
+        /// once the source for an entry point has been generated, its downstream compile doesn't depend
+        /// on anything else. When a `CodeGenContext` has a queue, the downstream compile is added
+        /// to the queue, and the result is only set once the queue is run.
+    class DownstreamCompileQueue
+    {
+    public:
+            /// Add `job`, with the result written to `outArtifact` when the queue is run.
+            /// `outArtifact` must stay valid until then.
+        void add(DownstreamCompileJob* job, ComPtr<IArtifact>& outArtifact);
+
+            /// Compile all of the jobs, and then write their results and report their diagnostics in
+            /// the order they were added.
+            ///
+            /// Compilers that run in process are run on the session's thread pool, with at most
+            /// `m_maxConcurrentJobs` running at once. Compilers that run as a separate process, such as
+            /// gcc and clang, are run as a pool of at most `m_maxConcurrentJobs` processes, whose output is
+            /// all read on one thread.
+        void run(Session* session, DiagnosticSink* sink);
+
+        Count getCount() const { return m_entries.getCount(); }
+
+        DownstreamCompileQueue(Count maxConcurrentJobs) : m_maxConcurrentJobs(maxConcurrentJobs) {}
+
+    protected:
+        struct Entry
+        {
+            RefPtr<DownstreamCompileJob> job;
+            ComPtr<IArtifact>* outArtifact = nullptr;
+        };
+
+        Count m_maxConcurrentJobs;
+        List<Entry> m_entries;
+    };
+
         /// A context for code generation in the compiler back-end
     struct CodeGenContext
     {
@@ -2586,11 +2952,13 @@ namespace Slang
                 TargetProgram*              targetProgram,
                 EntryPointIndices const&    entryPointIndices,
                 DiagnosticSink*             sink,
-                EndToEndCompileRequest*     endToEndReq)
+                EndToEndCompileRequest*     endToEndReq,
+                DownstreamCompileQueue*     downstreamCompileQueue = nullptr)
                 : targetProgram(targetProgram)
                 , entryPointIndices(entryPointIndices)
                 , sink(sink)
                 , endToEndReq(endToEndReq)
+                , downstreamCompileQueue(downstreamCompileQueue)
             {}
 
 //            Shared(
@@ -2601,6 +2969,8 @@ namespace Slang
             EntryPointIndices       entryPointIndices;
             DiagnosticSink*         sink = nullptr;
             EndToEndCompileRequest* endToEndReq = nullptr;
+                /// If set, downstream compiles that can run concurrently are added to the queue.
+            DownstreamCompileQueue* downstreamCompileQueue = nullptr;
         };
 
         CodeGenContext(
@@ -2692,6 +3062,9 @@ namespace Slang
 
         EndToEndCompileRequest* isPassThroughEnabled();
 
+            /// Get the cache for downstream compile results, or nullptr if results aren't cached.
+        PersistentCache* getDownstreamResultCache();
+
         Count getEntryPointCount()
         {
             return getEntryPointIndices().getCount();
@@ -2927,6 +3300,14 @@ namespace Slang
             /// Source code for the specialization arguments to use for the global specialization parameters of the program.
         List<String> m_globalSpecializationArgStrings;
 
+            /// Arguments for each permutation of the program to generate code for.
+            ///
+            /// Each argument is either source code for a type to use for the next
+            /// specialization parameter of the program, or `<name>=<value>` to give
+            /// a value to a link-time constant.
+            ///
+        List<List<String>> m_permutationArgStrings;
+
         // Are we being driven by the command-line `slangc`, and should act accordingly?
         bool m_isCommandLineCompile = false;
         
@@ -3013,6 +3394,9 @@ namespace Slang
 
         void generateOutput();
 
+            /// Generate output for each of the permutations in `m_permutationArgStrings`.
+        SlangResult generatePermutationOutput();
+
         CompilerOptionSet& getOptionSet() { return m_linkage->m_optionSet; }
     private:
         
@@ -3023,13 +3407,16 @@ namespace Slang
         SlangResult _maybeWriteArtifact(const String& path, IArtifact* artifact);
         SlangResult _writeArtifact(const String& path, IArtifact* artifact);
 
+            /// Create the permutations described by `m_permutationArgStrings` for `program`.
+        SlangResult _createPermutations(ComponentType* program, List<ComponentType::Permutation>& outPermutations);
+
             /// Adds any extra settings to complete a targetRequest
         void _completeTargetRequest(UInt targetIndex);
         
         ISlangUnknown* getInterface(const Guid& guid);
 
         void generateOutput(ComponentType* program);
-        void generateOutput(TargetProgram* targetProgram);
+        void generateOutput(TargetProgram* targetProgram, DownstreamCompileQueue* downstreamCompileQueue = nullptr);
 
         void init();
 
@@ -3193,6 +3580,23 @@ namespace Slang
         ModuleDecl* baseModuleDecl = nullptr;
         List<RefPtr<Module>> stdlibModules;
 
+            /// A copy of the IR of the stdlib modules, with the `__target_switch`es in it
+            /// resolved for a set of target capabilities (see `getStdLibIRModulesForTarget`).
+            ///
+            /// Entries are kept for at most `kMaxTargetStdLibIRCount` sets of capabilities,
+            /// in the order they were last used. The least recently used one is dropped
+            /// when another is needed.
+        struct TargetStdLibIR
+        {
+            CapabilitySet targetCaps;
+                /// The number of links for the capabilities. The copy is only made once it
+                /// has been needed more than once.
+            Index linkCount = 0;
+            List<RefPtr<IRModule>> irModules;
+        };
+        static const Index kMaxTargetStdLibIRCount = 4;
+        List<TargetStdLibIR> m_targetStdLibIRs;
+
         SourceManager   builtinSourceManager;
 
         SourceManager* getBuiltinSourceManager() { return &builtinSourceManager; }
@@ -3242,6 +3646,16 @@ namespace Slang
         }
         RefPtr<SPIRVCoreGrammarInfo> spirvCoreGrammarInfo;
 
+            /// Get the SPIR-V snippets of the stdlib's target intrinsics, parsed when the stdlib was
+            /// compiled, or read back with a saved stdlib. Only changed while the stdlib is set up.
+        SpvSnippetCache* getStdLibSpvSnippets() const { return m_stdLibSpvSnippets; }
+
+            /// Get the number of SPIR-V snippets that emitting code had to parse from their text,
+            /// because they weren't among the stdlib's.
+        Index getParsedSpvSnippetCount() const { return m_parsedSpvSnippetCount; }
+            /// Note that emitting code parsed a SPIR-V snippet from its text.
+        void addParsedSpvSnippet() { m_parsedSpvSnippetCount++; }
+
         //
 
         void _setSharedLibraryLoader(ISlangSharedLibraryLoader* loader);
@@ -3257,6 +3671,10 @@ namespace Slang
             /// Get the built in linkage -> handy to get the stdlibs from
         Linkage* getBuiltinLinkage() const { return m_builtinLinkage; }
 
+            /// Get the worker threads shared by everything compiled with this session.
+            /// The pool is created on first use.
+        ThreadPool* getThreadPool();
+
         Name* getCompletionRequestTokenName() const { return m_completionTokenName; }
 
         void init();
@@ -3289,11 +3707,21 @@ namespace Slang
 
         SlangResult _readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName);
 
+            /// Parse the SPIR-V snippets of the target intrinsics in the builtin modules.
+            /// Snippets that can't be parsed are reported to `sink`, and make this fail.
+        SlangResult _parseStdLibSpvSnippets(DiagnosticSink* sink);
+
         SlangResult _loadRequest(EndToEndCompileRequest* request, const void* data, size_t size);
 
             /// Linkage used for all built-in (stdlib) code.
         RefPtr<Linkage> m_builtinLinkage;
 
+        RefPtr<SpvSnippetCache> m_stdLibSpvSnippets;
+        std::atomic<Index> m_parsedSpvSnippetCount = 0;
+
+        std::mutex m_threadPoolMutex;
+        RefPtr<ThreadPool> m_threadPool;
+
         String m_downstreamCompilerPaths[int(PassThroughMode::CountOf)];         ///< Paths for each pass through
         String m_languagePreludes[int(SourceLanguage::CountOf)];                  ///< Prelude for each source language
         PassThroughMode m_defaultDownstreamCompilers[int(SourceLanguage::CountOf)];
@@ -35,6 +35,9 @@ struct ObjectPool
         m_pool.free(id, 1);
     }
 
+    // The memory held by the pooled containers themselves, not counting their elements.
+    size_t calcMemoryAllocated() const { return m_objects.getCount() * sizeof(T); }
+
     VirtualObjectPool m_pool;
     List<T> m_objects;
 };
@@ -87,6 +90,13 @@ struct ContainerPool
         set->clear();
         m_hashSetPool.freeObject((HashSet<void*>*)set);
     }
+
+    size_t calcMemoryAllocated() const
+    {
+        return m_listPool.calcMemoryAllocated() +
+            m_dictionaryPool.calcMemoryAllocated() +
+            m_hashSetPool.calcMemoryAllocated();
+    }
 };
 }
 
@@ -147,6 +147,7 @@ DIAGNOSTIC(  100, Error, failedToLoadDownstreamCompiler, "failed to load downstr
 DIAGNOSTIC(  101, Error, downstreamCompilerDoesntSupportWholeProgramCompilation, "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(  102, Note,  downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(  103, Note,  performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(  104, Note,  memoryUsageReport, "compiler memory usage in bytes:\n$0")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -656,6 +657,7 @@ DIAGNOSTIC(38025, Error, mismatchSpecializationArguments, "expected $0 specializ
 DIAGNOSTIC(38026, Error, globalTypeArgumentDoesNotConformToInterface, "type argument `$1` for global generic parameter `$0` does not conform to interface `$2`.")
 
 DIAGNOSTIC(38027, Error, mismatchExistentialSlotArgCount, "expected $0 existential slot arguments ($1 provided)")
+DIAGNOSTIC(38028, Error, expectedLinkTimeConstantForPermutation, "'$0' is not a link-time constant that can be given a value for a permutation")
 DIAGNOSTIC(38029, Error, typeArgumentDoesNotConformToInterface, "type argument '$0' does not conform to the required interface '$1'")
 
 DIAGNOSTIC(38031, Error, invalidUseOfNoDiff, "'no_diff' can only be used to decorate a call or a subscript operation")
@@ -108,6 +108,7 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
     m_codeGenContext = desc.codeGenContext;
     m_entryPointStage = desc.entryPointStage;
     m_effectiveProfile = desc.effectiveProfile;
+    m_emitCompactSource = getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::EmitCompactSource);
 }
 
 SlangResult CLikeSourceEmitter::init()
@@ -1109,6 +1110,16 @@ String CLikeSourceEmitter::generateName(IRInst* inst)
         return externCppDecoration->getName();
     }
     
+    // Locals (including parameters) can't be seen outside of the output, so when
+    // emitting compact source they use the short temporary name, whatever their name hint.
+    if (m_emitCompactSource && as<IRBlock>(inst->getParent()))
+    {
+        StringBuilder sb;
+        sb << "_S";
+        sb << Int32(getID(inst));
+        return sb.produceString();
+    }
+
     // If we have a name hint on the instruction, then we will try to use that
     // to provide the basis for the actual name in the output code.
     if(auto nameHintDecoration = inst->findDecoration<IRNameHintDecoration>())
@@ -1288,6 +1299,72 @@ void CLikeSourceEmitter::emitSimpleValueImpl(IRInst* inst)
 
 }
 
+bool CLikeSourceEmitter::_canFoldPastSideEffects(IRInst* inst)
+{
+    switch (inst->getOp())
+    {
+    case kIROp_IntLit:
+    case kIROp_FloatLit:
+    case kIROp_BoolLit:
+        return true;
+
+    case kIROp_Add:
+    case kIROp_Sub:
+    case kIROp_Mul:
+    case kIROp_Lsh:
+    case kIROp_Rsh:
+    case kIROp_Eql:
+    case kIROp_Neq:
+    case kIROp_Greater:
+    case kIROp_Less:
+    case kIROp_Geq:
+    case kIROp_Leq:
+    case kIROp_BitAnd:
+    case kIROp_BitXor:
+    case kIROp_BitOr:
+    case kIROp_And:
+    case kIROp_Or:
+    case kIROp_Neg:
+    case kIROp_Not:
+    case kIROp_BitNot:
+    case kIROp_Select:
+    case kIROp_BitCast:
+    case kIROp_CastFloatToInt:
+    case kIROp_CastIntToFloat:
+    case kIROp_IntCast:
+    case kIROp_FloatCast:
+    case kIROp_MakeVector:
+    case kIROp_MakeVectorFromScalar:
+    case kIROp_MakeMatrix:
+    case kIROp_MakeMatrixFromScalar:
+    case kIROp_MatrixReshape:
+    case kIROp_VectorReshape:
+    case kIROp_swizzle:
+    case kIROp_GetElement:
+    case kIROp_FieldExtract:
+    case kIROp_FieldAddress:
+    case kIROp_GetElementPtr:
+        break;
+
+    default:
+        return false;
+    }
+
+    // An operand that is folded into `inst` is evaluated where `inst` is,
+    // so it must also be computed only from values (a load, for example,
+    // could see a store that comes before the use site).
+    //
+    for (UInt i = 0; i < inst->getOperandCount(); ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (operand->getParent() != inst->getParent())
+            continue;
+        if (shouldFoldInstIntoUseSites(operand) && !_canFoldPastSideEffects(operand))
+            return false;
+    }
+    return true;
+}
+
 bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
 {
     // Certain opcodes should never/always be folded in
@@ -1579,8 +1656,10 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
         }
     }
     
-    // If this is a call to a ResourceType's member function, don't fold for readability.
-    if (auto call = as<IRCall>(inst))
+    // If this is a call to a ResourceType's member function, don't fold for readability,
+    // unless the output is compact.
+    auto call = m_emitCompactSource ? nullptr : as<IRCall>(inst);
+    if (call)
     {
         auto callee = getResolvedInstForDecorations(call->getCallee());
         if (callee->findDecoration<IRTargetIntrinsicDecoration>())
@@ -1626,6 +1705,11 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
     // Now let's look at all the instructions between this instruction
     // and the user. If any of them might have side effects, then lets
     // bail out now.
+    //
+    // When the output is compact, a value that doesn't depend on any
+    // state can be computed at the use site whatever comes in between.
+    //
+    const bool canFoldPastSideEffects = m_emitCompactSource && _canFoldPastSideEffects(inst);
     for(auto ii = inst->getNextInst(); ii != user; ii = ii->getNextInst())
     {
         if(!ii)
@@ -1636,7 +1720,7 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst)
             return false;
         }
 
-        if(ii->mightHaveSideEffects())
+        if(!canFoldPastSideEffects && ii->mightHaveSideEffects())
             return false;
     }
 
@@ -309,6 +309,10 @@ public:
     
     virtual bool shouldFoldInstIntoUseSites(IRInst* inst);
 
+        /// True if `inst`, and everything that is folded into it, is computed only from the
+        /// values of its operands, so that it can be folded past instructions with side effects.
+    bool _canFoldPastSideEffects(IRInst* inst);
+
     void emitOperand(IRInst* inst, EmitOpInfo const& outerPrec) { emitOperandImpl(inst, outerPrec); }
 
     void emitArgs(IRInst* inst);
@@ -580,6 +584,10 @@ public:
     // Where source is written to
     SourceWriter* m_writer;
 
+    // If set, the output is for a downstream compiler rather than a reader, so locals
+    // get short names, and temporaries are folded wherever that gives the same result.
+    bool m_emitCompactSource = false;
+
     UInt m_uniqueIDCounter = 1;
     Dictionary<IRInst*, UInt> m_mapIRValueToID;
 
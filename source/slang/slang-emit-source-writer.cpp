@@ -21,6 +21,29 @@ SourceWriter::SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineD
     m_sourceManager = sourceManager;
 }
 
+String SourceWriter::getContent()
+{
+    if (m_chunks.getCount() == 0)
+    {
+        return m_builder.produceString();
+    }
+
+    StringBuilder buf(m_chunksLength + m_builder.getLength());
+    for (const auto& chunk : m_chunks)
+    {
+        buf.append(chunk);
+    }
+    buf.append(m_builder);
+    return buf.produceString();
+}
+
+void SourceWriter::clearContent()
+{
+    m_chunks.clear();
+    m_chunksLength = 0;
+    m_builder.clear();
+}
+
 String SourceWriter::getContentAndClear()
 {
     String content(getContent());
@@ -28,10 +51,73 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::appendContentChunksAndClear(List<String>& ioChunks)
+{
+    for (auto& chunk : m_chunks)
+    {
+        ioChunks.add(_Move(chunk));
+    }
+    if (m_builder.getLength())
+    {
+        ioChunks.add(m_builder.produceString());
+    }
+    clearContent();
+}
+
+/* static */ComPtr<ISlangBlob> SourceWriter::createContentBlob(const List<String>& chunks)
+{
+    if (chunks.getCount() == 1)
+    {
+        return StringBlob::create(chunks[0]);
+    }
+
+    Index length = 0;
+    for (const auto& chunk : chunks)
+    {
+        length += chunk.getLength();
+    }
+
+    StringBuilder buf(length);
+    for (const auto& chunk : chunks)
+    {
+        buf.append(chunk);
+    }
+    return StringBlob::moveCreate(buf);
+}
+
+void SourceWriter::_finishChunk()
+{
+    // Any location tracking still to be done in the chunk has to be done now, as
+    // only the current chunk is scanned by `_calcLocation`.
+    const Count chunkLength = m_builder.getLength();
+    const Count chunkOffset = m_currentOutputOffset - m_chunksLength;
+    if (chunkOffset >= 0 && chunkOffset < chunkLength)
+    {
+        _advanceLocation(m_builder.getBuffer() + chunkOffset, m_builder.end());
+        m_currentOutputOffset = m_chunksLength + chunkLength;
+    }
+
+    m_chunksLength += chunkLength;
+    m_chunks.add(_Move(m_builder));
+
+    m_builder.ensureCapacity(kChunkSize);
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
+
+    // Rather than grow the current chunk (and so copy all of its contents), start a new one.
+    // A span larger than a chunk just gets a chunk to itself.
+    //
+    // Spans are never split, so multi-byte code points stay within a single chunk.
+    const Index length = m_builder.getLength();
+    if (length && length + len > kChunkSize)
+    {
+        _finishChunk();
+    }
+
     m_builder.append(textBegin, len);
 }
 
@@ -60,7 +146,8 @@ void SourceWriter::_emitTextSpan(char const* textBegin, char const* textEnd)
         // at the start of a line, so we will emit the proper
         // amount of indentation to keep things looking nice.
         m_isAtStartOfLine = false;
-        for (Int ii = 0; ii < m_indentLevel; ++ii)
+        const Int indentLevel = m_isIndentationEnabled ? m_indentLevel : 0;
+        for (Int ii = 0; ii < indentLevel; ++ii)
         {
             char const* indentString = "    ";
             size_t indentStringSize = strlen(indentString);
@@ -539,57 +626,60 @@ void SourceWriter::_emitLineDirective(const HumaneSourceLoc& sourceLocation)
     emitRawText("\n");
 }
 
-void SourceWriter::_calcLocation(Index& outLineIndex, Index& outColumnIndex)
+void SourceWriter::_advanceLocation(const char* cur, const char* end)
 {
-    // If there are move chars we need to update 
-    if (m_currentOutputOffset < m_builder.getLength())
-    {
-        const char* cur = m_builder.getBuffer() + m_currentOutputOffset;
-        const char* end = m_builder.end();
+    const char* start = cur;
 
-        const char* start = cur;
+    while (cur < end)
+    {
+        // Reset start
+        start = cur;
 
-        while (cur < end)
+        // Look for the end of the line
+        while (cur < end && *cur != '\n' && *cur != '\r')
         {
-            // Reset start
-            start = cur;
+            cur++;
+        }
 
-            // Look for the end of the line
-            while (*cur != '\n' && *cur != '\r' && cur < end)
-            {
-                cur++;
-            }
+        // If we are not at the total end then we must have hit a \n or \r
+        if (cur < end)
+        {
+            const auto c = *cur++;
 
-            // If we are not at the total end then we must have hit a \n or \r
+            // Next line
+            ++m_currentLineIndex;
+                
+            // Check the next char to see if it's part of a CR/LF combination
             if (cur < end)
             {
-                const auto c = *cur++;
-
-                // Next line
-                ++m_currentLineIndex;
-                
-                // Check the next char to see if it's part of a CR/LF combination
-                if (cur < end)
-                {
-                    const auto d = *cur;
-                    // If it is combination skip the next byte
-                    cur += ((c ^ d) == ('\r' ^ '\n'));
-                }
-
-                // Calculate the offset to the start of this line
-                m_currentColumnIndex = 0;
-                start = cur;
+                const auto d = *cur;
+                // If it is combination skip the next byte
+                cur += ((c ^ d) == ('\r' ^ '\n'));
             }
+
+            // Calculate the offset to the start of this line
+            m_currentColumnIndex = 0;
+            start = cur;
         }
+    }
 
-        // Set the current offset to the end
-        m_currentOutputOffset = m_builder.getLength();
+    // Get the bytes remaining on this line (which may not be complete)
+    const UnownedStringSlice lineRemaining(start, end);
+
+    // Offset the column index in codepoints 
+    m_currentColumnIndex += UTF8Util::calcCodePointCount(lineRemaining);
+}
 
-        // Get the bytes remaining on this line (which may not be complete)
-        const UnownedStringSlice lineRemaining(start, m_builder.end());
+void SourceWriter::_calcLocation(Index& outLineIndex, Index& outColumnIndex)
+{
+    // If there are move chars we need to update 
+    const Count chunkOffset = m_currentOutputOffset - m_chunksLength;
+    if (chunkOffset >= 0 && chunkOffset < m_builder.getLength())
+    {
+        _advanceLocation(m_builder.getBuffer() + chunkOffset, m_builder.end());
 
-        // Offset the column index in codepoints 
-        m_currentColumnIndex += UTF8Util::calcCodePointCount(lineRemaining);
+        // Set the current offset to the end
+        m_currentOutputOffset = m_chunksLength + m_builder.getLength();
     }
 
     // Output the position
@@ -54,6 +54,9 @@ public:
     void supressLineDirective() { m_supressLineDirective = true; }
     void resumeLineDirective() { m_supressLineDirective = false; }
 
+        /// Set if indentation is output. If not, indent/dedent have no effect on the output.
+    void setIndentationEnabled(bool enabled) { m_isIndentationEnabled = enabled; }
+
         /// Indent the text
     void indent();
         /// Dedent (the opposite of indenting) the text
@@ -65,11 +68,17 @@ public:
     void advanceToSourceLocationIfValid(const SourceLoc& sourceLocation);
 
         /// Get the content as a string
-    String getContent() { return m_builder.produceString(); }
+    String getContent();
         /// Clear the content
-    void clearContent() { m_builder.clear(); }
+    void clearContent();
         /// Get the content as a string and clear the internal representation
     String getContentAndClear();
+        /// Append the chunks that hold the content to ioChunks, and clear the internal representation.
+        /// The text is not copied.
+    void appendContentChunksAndClear(List<String>& ioChunks);
+
+        /// Create a blob holding the concatenation of chunks. The text is copied once, into a buffer of the final size.
+    static ComPtr<ISlangBlob> createContentBlob(const List<String>& chunks);
 
         /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
@@ -101,12 +110,22 @@ protected:
 
         /// Calculate the current location in the ouput
     void _calcLocation(Index& outLineIndex, Index& outColumnIndex);
-
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+        /// Advance the current line and column over the text between cur and end
+    void _advanceLocation(const char* cur, const char* end);
+        /// Move the current chunk onto m_chunks, and start a new one
+    void _finishChunk();
+
+    // The size chunks are allocated with. Text that doesn't fit in the remaining space of the
+    // current chunk goes into a new one, so the text is never moved as it grows.
+    static const Index kChunkSize = 64 * 1024;
+
+    // The chunks of code that are full, in order
+    List<String> m_chunks;
+    // The total length of the text in m_chunks
+    Count m_chunksLength = 0;
+
+    // The chunk of code currently being appended to.
+    // NOTE! Looking at the current contents of the output when debugging requires looking at m_chunks too.
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
@@ -118,6 +137,7 @@ protected:
     // Used to determine the current location in the output for outputting the source map
     // This is separate from m_loc, because m_loc doesn't appear to track the line/column directly 
     // in the output stream - for example when #line emits a "raw" emit takes place.
+    // The offset is into the whole output, across all of the chunks.
     Count m_currentOutputOffset = 0;
     Index m_currentLineIndex = 0;
     Index m_currentColumnIndex = 0;
@@ -133,6 +153,9 @@ protected:
     // How far are we indented?
     Int m_indentLevel = 0;
 
+    // If false, no indentation is output, whatever the indent level
+    bool m_isIndentationEnabled = true;
+
     SourceManager* m_sourceManager = nullptr;
 
     // For GLSL output, we can't emit traditional `#line` directives
@@ -14,6 +14,7 @@
 #include "slang-lookup-spirv.h"
 #include "spirv/unified1/spirv.h"
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-stable-hash.h"
 #include <type_traits>
 
 namespace Slang
@@ -133,8 +134,12 @@ public:
         /// Add an instruction to the end of the list of children
     void addInst(SpvInst* inst);
 
-        /// Dump all children, recursively, to a flattened list of SPIR-V words
-    void dumpTo(List<SpvWord>& ioWords);
+        /// Get the number of SPIR-V words that all children take, recursively
+    Index calcWordCount() const;
+
+        /// Write all children, recursively, to the flattened SPIR-V words starting at `dst`.
+        /// Returns the position after the last word written.
+    SpvWord* writeTo(SpvWord* dst) const;
 
         /// The first child, if any.
     SpvInst* m_firstChild = nullptr;
@@ -208,8 +213,16 @@ struct SpvInst : SpvInstParent
         /// The result <id> produced by this instruction, or zero if it has no result.
     SpvWord id = 0;
 
-        /// Dump the instruction (and any children, recursively) into the flat array of SPIR-V words.
-    void dumpTo(List<SpvWord>& ioWords)
+        /// Get the number of words the instruction (and any children, recursively) takes.
+    Index calcWordCount() const
+    {
+        return 1 + Index(operandWordsCount) + SpvInstParent::calcWordCount();
+    }
+
+        /// Write the instruction (and any children, recursively) to the flat array of SPIR-V
+        /// words starting at `dst`, which must have room for `calcWordCount()` words.
+        /// Returns the position after the last word written.
+    SpvWord* writeTo(SpvWord* dst) const
     {
         // [2.2: Terms]
         //
@@ -224,11 +237,15 @@ struct SpvInst : SpvInstParent
         // > Opcode: The 16 high-order bits are the WordCount of the instruction.
         // >         The 16 low-order bits are the opcode enumerant.
         //
-        ioWords.add(wordCount << 16 | opcode);
+        *dst++ = wordCount << 16 | opcode;
 
         // The operand words simply follow the opcode word.
         //
-        ioWords.addRange(operandWords, operandWordsCount);
+        if (operandWordsCount)
+        {
+            ::memcpy(dst, operandWords, operandWordsCount * sizeof(SpvWord));
+            dst += operandWordsCount;
+        }
         
         // In our representation choice, the children of a
         // parent instruction will always follow the encoded
@@ -237,7 +254,7 @@ struct SpvInst : SpvInstParent
         // * The instructions inside a function always follow the `OpFunction`
         // * The instructions inside a block always follow the `OpLabel`
         //
-        SpvInstParent::dumpTo(ioWords);
+        return SpvInstParent::writeTo(dst);
     }
 
     void removeFromParent()
@@ -307,12 +324,23 @@ void SpvInstParent::addInst(SpvInst* inst)
     m_lastChild = inst;
 }
 
-void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
+Index SpvInstParent::calcWordCount() const
+{
+    Index wordCount = 0;
+    for( auto child = m_firstChild; child; child = child->nextSibling )
+    {
+        wordCount += child->calcWordCount();
+    }
+    return wordCount;
+}
+
+SpvWord* SpvInstParent::writeTo(SpvWord* dst) const
 {
     for( auto child = m_firstChild; child; child = child->nextSibling )
     {
-        child->dumpTo(ioWords);
+        dst = child->writeTo(dst);
     }
+    return dst;
 }
 
 /// The context for inlining a SPV assembly snippet.
@@ -500,31 +528,44 @@ struct SPIRVEmitContext
     }
 
     // At the end of emission we need a single linear stream of words,
-    // so we will eventually flatten `m_sections` into a single array.
-
-        /// The final array of SPIR-V words that defines the encoded module
-    List<SpvWord> m_words;
+    // so we will flatten `m_sections` into the output.
 
         /// Emit the concrete words that make up the binary SPIR-V module.
         ///
-        /// This function fills in `m_words` based on the data in `m_sections`.
+        /// This function appends the words for the data in `m_sections` to `ioSpirv`.
         /// This function should only be called once.
         ///
-    void emitPhysicalLayout()
+    void emitPhysicalLayout(List<uint8_t>& ioSpirv)
     {
+        // The size of every instruction is known by now, so we size the output once
+        // and write the words straight into it, rather than growing an intermediate
+        // list of words that then has to be copied.
+        //
+        const Index kHeaderWordCount = 5;
+        Index wordCount = kHeaderWordCount;
+        for( int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii )
+        {
+            wordCount += m_sections[ii].calcWordCount();
+        }
+
+        const Index startOffset = ioSpirv.getCount();
+        SLANG_ASSERT(startOffset % Index(sizeof(SpvWord)) == 0);
+        ioSpirv.setCount(startOffset + wordCount * Index(sizeof(SpvWord)));
+        SpvWord* const words = reinterpret_cast<SpvWord*>(ioSpirv.getBuffer() + startOffset);
+
         // [2.3: Physical Layout of a SPIR-V Module and Instruction]
         //
         // > Magic Number
         //
-        m_words.add(SpvMagicNumber);
+        words[0] = SpvMagicNumber;
 
         // > Version nuumber
         //
-        m_words.add(m_spvVersion);
+        words[1] = m_spvVersion;
 
         // > Generator's magic number.
         //
-        m_words.add(kSPIRVSlangCompilerId);
+        words[2] = kSPIRVSlangCompilerId;
 
         // > Bound
         //
@@ -532,11 +573,11 @@ struct SPIRVEmitContext
         // <id>s, so its value when we are done emitting code
         // can serve as the bound.
         //
-        m_words.add(m_nextID);
+        words[3] = m_nextID;
 
         // > 0 (Reserved for instruction schema, if needed.)
         //
-        m_words.add(0);
+        words[4] = 0;
 
         // > First word of instruction stream
         // > All remaining words are a linear sequence of instructions.
@@ -544,10 +585,12 @@ struct SPIRVEmitContext
         // Once we are done emitting the header, we emit all
         // the instructions in our logical sections.
         // 
+        SpvWord* cursor = words + kHeaderWordCount;
         for( int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii )
         {
-            m_sections[ii].dumpTo(m_words);
+            cursor = m_sections[ii].writeTo(cursor);
         }
+        SLANG_ASSERT(cursor == words + wordCount);
     }
 
     // We will often need to refer to an instrcition by its
@@ -1325,6 +1368,16 @@ struct SPIRVEmitContext
 
     IRInst* m_defaultDebugSource = nullptr;
 
+    // The OpDebugSource emitted for each source, keyed by the string literals of its file
+    // name and text, so a source that appears in several linked modules is only described once.
+    // String literals are deduplicated in the IR module, so equal strings have the same literal.
+    Dictionary<KeyValuePair<IRStringLit*, IRStringLit*>, SpvInst*> m_debugSources;
+
+    // The OpString emitted for each piece of source text, keyed by the literal holding the
+    // text and the offset of the piece in it, so identical text under different file names
+    // is only stored once.
+    Dictionary<KeyValuePair<IRStringLit*, Index>, SpvInst*> m_debugSourceStrings;
+
     Dictionary<UnownedStringSlice, SpvInst*> m_extensionInsts;
     SpvInst* ensureExtensionDeclaration(UnownedStringSlice name)
     {
@@ -1727,48 +1780,81 @@ struct SPIRVEmitContext
             {
                 ensureExtensionDeclaration(UnownedStringSlice("SPV_KHR_non_semantic_info"));
                 auto debugSource = as<IRDebugSource>(inst);
-                auto sourceStr = as<IRStringLit>(debugSource->getSource())->getStringSlice();
+                auto sourceLit = as<IRStringLit>(debugSource->getSource());
+                auto sourceStr = sourceLit->getStringSlice();
+
+                String hashText;
+                switch (m_targetProgram->getOptionSet().getEnumOption<DebugInfoSourceMode>(CompilerOptionName::DebugInformationSource))
+                {
+                    case DebugInfoSourceMode::Path:
+                    {
+                        sourceStr = UnownedStringSlice();
+                        break;
+                    }
+                    case DebugInfoSourceMode::Hash:
+                    {
+                        if (sourceStr.getLength())
+                        {
+                            StringBuilder buf;
+                            buf << "// source hash: ";
+                            buf.append(getStableHashCode64(sourceStr.begin(), sourceStr.getLength()).hash, 16);
+                            hashText = buf.produceString();
+                            sourceStr = hashText.getUnownedSlice();
+                        }
+                        break;
+                    }
+                    default: break;
+                }
+
+                // If the same file with the same text has already been described, use that.
+                // When only the path is output the text doesn't tell sources apart.
+                const KeyValuePair<IRStringLit*, IRStringLit*> debugSourceKey(
+                    as<IRStringLit>(debugSource->getFileName()),
+                    sourceStr.getLength() ? sourceLit : nullptr);
+                if (auto existing = m_debugSources.tryGetValue(debugSourceKey))
+                {
+                    registerInst(inst, *existing);
+                    if (!m_defaultDebugSource)
+                        m_defaultDebugSource = debugSource;
+                    return *existing;
+                }
+
+                SpvInst* result = nullptr;
                 // If source content is empty, skip the content operand.
                 if (sourceStr.getLength() == 0)
                 {
-                    return emitOpDebugSource(
+                    result = emitOpDebugSource(
                         getSection(SpvLogicalSectionID::ConstantsAndTypes),
                         inst,
                         inst->getFullType(),
                         getNonSemanticDebugInfoExtInst(),
                         debugSource->getFileName());
                 }
-                // SPIRV does not allow string lits longer than 65535, so we need to split the source string
-                // in OpDebugSourceContinued instructions.
-                auto sourceStrHead = sourceStr.getLength() > 65535 ? sourceStr.head(65535) : sourceStr;
-                auto spvStrHead = emitInst(
-                    getSection(SpvLogicalSectionID::DebugStringsAndSource),
-                    nullptr,
-                    SpvOpString,
-                    kResultID,
-                    SpvLiteralBits::fromUnownedStringSlice(sourceStrHead));
+                else
+                {
+                    // SPIRV does not allow string lits longer than 65535, so we need to split the source string
+                    // in OpDebugSourceContinued instructions.
+                    auto sourceStrHead = sourceStr.getLength() > 65535 ? sourceStr.head(65535) : sourceStr;
+                    auto spvStrHead = _emitDebugSourceString(sourceLit, 0, sourceStrHead);
 
-                auto result = emitOpDebugSource(
-                    getSection(SpvLogicalSectionID::ConstantsAndTypes),
-                    inst,
-                    inst->getFullType(),
-                    getNonSemanticDebugInfoExtInst(),
-                    debugSource->getFileName(),
-                    spvStrHead);
+                    result = emitOpDebugSource(
+                        getSection(SpvLogicalSectionID::ConstantsAndTypes),
+                        inst,
+                        inst->getFullType(),
+                        getNonSemanticDebugInfoExtInst(),
+                        debugSource->getFileName(),
+                        spvStrHead);
 
-                for (Index start = 65535; start < sourceStr.getLength(); start += 65535)
-                {
-                    auto slice = sourceStr.tail(start);
-                    slice = slice.getLength() > 65535 ? slice.head(65535) : slice;
-                    auto sliceSpvStr = emitInst(
-                        getSection(SpvLogicalSectionID::DebugStringsAndSource),
-                        nullptr,
-                        SpvOpString,
-                        kResultID,
-                        SpvLiteralBits::fromUnownedStringSlice(slice));
-                    emitOpDebugSourceContinued(getSection(SpvLogicalSectionID::ConstantsAndTypes),
-                        nullptr, m_voidType, getNonSemanticDebugInfoExtInst(), sliceSpvStr);
+                    for (Index start = 65535; start < sourceStr.getLength(); start += 65535)
+                    {
+                        auto slice = sourceStr.tail(start);
+                        slice = slice.getLength() > 65535 ? slice.head(65535) : slice;
+                        auto sliceSpvStr = _emitDebugSourceString(sourceLit, start, slice);
+                        emitOpDebugSourceContinued(getSection(SpvLogicalSectionID::ConstantsAndTypes),
+                            nullptr, m_voidType, getNonSemanticDebugInfoExtInst(), sliceSpvStr);
+                    }
                 }
+                m_debugSources.add(debugSourceKey, result);
 
                 auto moduleInst = inst->getModule()->getModuleInst();
                 if (!m_defaultDebugSource)
@@ -5820,9 +5906,34 @@ struct SPIRVEmitContext
             debugLine->getColEnd());
     }
 
+        /// Emit an OpString holding `text`, the piece of the source in `sourceLit` (or output in its place)
+        /// that starts at `offset`, or return the one already emitted for it.
+    SpvInst* _emitDebugSourceString(IRStringLit* sourceLit, Index offset, const UnownedStringSlice& text)
+    {
+        const KeyValuePair<IRStringLit*, Index> key(sourceLit, offset);
+        if (auto existing = m_debugSourceStrings.tryGetValue(key))
+            return *existing;
+        auto spvStr = emitInst(
+            getSection(SpvLogicalSectionID::DebugStringsAndSource),
+            nullptr,
+            SpvOpString,
+            kResultID,
+            SpvLiteralBits::fromUnownedStringSlice(text));
+        m_debugSourceStrings.add(key, spvStr);
+        return spvStr;
+    }
+
+        /// True if only line tables should be output, so variables aren't described.
+    bool _isLineTablesOnly()
+    {
+        return m_targetProgram->getOptionSet().getBoolOption(CompilerOptionName::DebugInformationLineTablesOnly);
+    }
+
     SpvInst* emitDebugVar(SpvInstParent* parent, IRDebugVar* debugVar)
     {
         SLANG_UNUSED(parent);
+        if (_isLineTablesOnly())
+            return nullptr;
         auto scope = findDebugScope(debugVar);
         if (!scope)
             return nullptr;
@@ -5850,6 +5961,8 @@ struct SPIRVEmitContext
 
     SpvInst* emitDebugValue(SpvInstParent* parent, IRDebugValue* debugValue)
     {
+        if (_isLineTablesOnly())
+            return nullptr;
         IRBuilder builder(debugValue);
 
         List<SpvInst*> accessChain;
@@ -6761,11 +6874,7 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
-    context.emitPhysicalLayout();
-
-    spirvOut.addRange(
-        (uint8_t const*) context.m_words.getBuffer(),
-        context.m_words.getCount() * Index(sizeof(context.m_words[0])));
+    context.emitPhysicalLayout(spirvOut);
 
     return SLANG_OK;
 }
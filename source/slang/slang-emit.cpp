@@ -104,6 +104,7 @@
 #include "slang-emit-cuda.h"
 #include "slang-emit-torch.h"
 
+#include "slang-spirv-post-optimize.h"
 #include "slang-spirv-val.h"
 #include "../compiler-core/slang-artifact-desc-util.h"
 #include "../compiler-core/slang-artifact-util.h"
@@ -442,6 +443,8 @@ Result linkAndOptimizeIR(
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
 
+    codeGenContext->getLinkage()->recordMemoryUsage("link IR", irModule);
+
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
 #endif
@@ -1460,6 +1463,10 @@ Result linkAndOptimizeIR(
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
         checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
 
+    // The passes leave the memory of the instructions they replace in the
+    // module's arena, so this is where the module is at its largest.
+    codeGenContext->getLinkage()->recordMemoryUsage("optimize IR", irModule);
+
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
@@ -1488,6 +1495,14 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         lineDirectiveMode = LineDirectiveMode::GLSL;
     }
 
+    // Compact source is output without line directives. A source map is still produced
+    // if one has been asked for, as it doesn't add anything to the source itself.
+    const bool emitCompactSource = targetProgram->getOptionSet().getBoolOption(CompilerOptionName::EmitCompactSource);
+    if (emitCompactSource && lineDirectiveMode != LineDirectiveMode::SourceMap)
+    {
+        lineDirectiveMode = LineDirectiveMode::None;
+    }
+
     ComPtr<IBoxValue<SourceMap>> sourceMap;
 
     // If SourceMap is enabled, we create one and associate it with the sourceWriter
@@ -1497,6 +1512,7 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
     }
 
     SourceWriter sourceWriter(sourceManager, lineDirectiveMode, sourceMap );
+    sourceWriter.setIndentationEnabled(!emitCompactSource);
 
     CLikeSourceEmitter::Desc desc;
 
@@ -1605,8 +1621,10 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    // The code is held as the chunks the source writer built it in, so that it isn't copied
+    // until the final output is put together.
+    List<String> codeChunks;
+    sourceWriter.appendContentChunksAndClear(codeChunks);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -1662,19 +1680,20 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
     // Get the content built so far from the front matter/prelude/preModule
     // By getting in this way, the content is no longer referenced by the sourceWriter.
-    String finalResult = sourceWriter.getContentAndClear();
+    List<String> finalChunks;
+    sourceWriter.appendContentChunksAndClear(finalChunks);
 
     // Append the modules output code
-    finalResult.append(code);
+    finalChunks.addRange(codeChunks);
 
     // Append all content that should be at the end of a module
     sourceEmitter->emitPostModule();
-    finalResult.append(sourceWriter.getContentAndClear());
+    sourceWriter.appendContentChunksAndClear(finalChunks);
 
-    // Write out the result
+    // Write out the result. This is the only place the text is copied, into a blob of the final size.
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(target));
-    artifact->addRepresentationUnknown(StringBlob::moveCreate(finalResult));
+    artifact->addRepresentationUnknown(SourceWriter::createContentBlob(finalChunks));
 
     ArtifactUtil::addAssociated(artifact, metadata);
 
@@ -1715,6 +1734,18 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     List<uint8_t> spirv, outSpirv;
     emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
 
+    auto& optionSet = codeGenContext->getTargetProgram()->getOptionSet();
+    const auto optimizationLevel = optionSet.getEnumOption<OptimizationLevel>(CompilerOptionName::Optimization);
+
+    // The in process clean up is cheap enough to always run, and is all the optimization
+    // done at -O0 and -O1. If it can't parse the SPIR-V it leaves it alone, and any problem
+    // is left for validation to report.
+    {
+        SPIRVPostOptimizeOptions postOptimizeOptions;
+        postOptimizeOptions.stripNames = optionSet.getBoolOption(CompilerOptionName::Obfuscate);
+        postOptimizeSPIRV(codeGenContext->getSession()->getSPIRVCoreGrammarInfo(), postOptimizeOptions, spirv);
+    }
+
 #if 0
     String optErr;
     if (SLANG_FAILED(optimizeSPIRV(spirv, optErr, outSpirv)))
@@ -1733,53 +1764,68 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     printf("%s", dis.begin());
 #endif
 
-    IDownstreamCompiler* compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
-        PassThroughMode::SpirvOpt, codeGenContext->getSink());
+    bool shouldValidate = false;
+    if (!codeGenContext->shouldSkipSPIRVValidation())
+    {
+        StringBuilder runSpirvValEnvVar;
+        PlatformUtil::getEnvironmentVariable(UnownedStringSlice("SLANG_RUN_SPIRV_VALIDATION"), runSpirvValEnvVar);
+        shouldValidate = runSpirvValEnvVar.getUnownedSlice() == "1";
+    }
+
+    // `spirv-opt` is slow compared to the clean up above, so it is only run at -O2 and
+    // above, and otherwise only loaded when there is validation to do.
+    const bool shouldRunSpirvOpt = optimizationLevel >= OptimizationLevel::High;
+    IDownstreamCompiler* compiler = nullptr;
+    if (shouldValidate || shouldRunSpirvOpt)
+    {
+        compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
+            PassThroughMode::SpirvOpt, codeGenContext->getSink());
+    }
     if (compiler)
     {
-        if (!codeGenContext->shouldSkipSPIRVValidation())
+        if (shouldValidate)
         {
-            StringBuilder runSpirvValEnvVar;
-            PlatformUtil::getEnvironmentVariable(UnownedStringSlice("SLANG_RUN_SPIRV_VALIDATION"), runSpirvValEnvVar);
-            if (runSpirvValEnvVar.getUnownedSlice() == "1")
+            if (SLANG_FAILED(compiler->validate((uint32_t*)spirv.getBuffer(), int(spirv.getCount()/4))))
             {
-                if (SLANG_FAILED(compiler->validate((uint32_t*)spirv.getBuffer(), int(spirv.getCount()/4))))
-                {
-                    String err;
-                    String dis;
-                    disassembleSPIRV(spirv, err, dis);
-                    codeGenContext->getSink()->diagnoseWithoutSourceView(
-                        SourceLoc{},
-                        Diagnostics::spirvValidationFailed,
-                        dis
-                    );
-                }
+                String err;
+                String dis;
+                disassembleSPIRV(spirv, err, dis);
+                codeGenContext->getSink()->diagnoseWithoutSourceView(
+                    SourceLoc{},
+                    Diagnostics::spirvValidationFailed,
+                    dis
+                );
             }
         }
 
-        ComPtr<IArtifact> optimizedArtifact;
-        DownstreamCompileOptions downstreamOptions;
-        downstreamOptions.sourceArtifacts = makeSlice(artifact.readRef(), 1);
-        downstreamOptions.targetType = SLANG_SPIRV;
-        downstreamOptions.sourceLanguage = SLANG_SOURCE_LANGUAGE_SPIRV;
-        switch (codeGenContext->getTargetProgram()->getOptionSet().getEnumOption<OptimizationLevel>(CompilerOptionName::Optimization))
-        {
-        case OptimizationLevel::None:       downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::None; break;
-        case OptimizationLevel::Default:    downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Default;  break;
-        case OptimizationLevel::High:       downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::High;  break;
-        case OptimizationLevel::Maximal:    downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;  break;
-        default: SLANG_ASSERT(!"Unhandled optimization level"); break;
-        }
-        auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+        if (shouldRunSpirvOpt)
         {
-            artifact = _Move(optimizedArtifact);
-        }
-        auto downstreamElapsedTime =
-            (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
-        codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
+            ComPtr<IArtifact> optimizedArtifact;
+            DownstreamCompileOptions downstreamOptions;
+            downstreamOptions.sourceArtifacts = makeSlice(artifact.readRef(), 1);
+            downstreamOptions.targetType = SLANG_SPIRV;
+            downstreamOptions.sourceLanguage = SLANG_SOURCE_LANGUAGE_SPIRV;
+            switch (optimizationLevel)
+            {
+            case OptimizationLevel::High:       downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::High;  break;
+            case OptimizationLevel::Maximal:    downstreamOptions.optimizationLevel = DownstreamCompileOptions::OptimizationLevel::Maximal;  break;
+            default: SLANG_ASSERT(!"Unhandled optimization level"); break;
+            }
+            auto downstreamStartTime = std::chrono::high_resolution_clock::now();
+            if (SLANG_SUCCEEDED(DownstreamCompilerUtil::compileWithCache(
+                compiler,
+                downstreamOptions,
+                codeGenContext->getDownstreamResultCache(),
+                optimizedArtifact.writeRef())))
+            {
+                artifact = _Move(optimizedArtifact);
+            }
+            auto downstreamElapsedTime =
+                (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
+            codeGenContext->getSession()->addDownstreamCompileTime(downstreamElapsedTime);
 
-        SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+            SLANG_RETURN_ON_FAIL(passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, artifact));
+        }
     }
 
     ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
@@ -11,6 +11,7 @@
 #include "slang-ir-specialize-target-switch.h"
 #include "slang-ir-layout.h"
 #include "slang-module-library.h"
+#include "slang-serialize-ir.h"
 
 #include "../core/slang-performance-profiler.h"
 #include "../compiler-core/slang-artifact.h"
@@ -52,12 +53,31 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule>   module;
 
-    // A map from mangled symbol names to zero or
+    // The symbol indices of the *original* modules being
+    // linked, in the order the modules are linked.
+    List<IRModuleSymbolIndex*> moduleSymbolIndices;
+
+    // A map from mangled symbol names to one or
     // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+    // in the *original* modules.
+    //
+    // Entries are created on demand from `moduleSymbolIndices`
+    // the first time a name is looked up, and are keyed by
+    // the name stored in one of the original modules.
+    typedef Dictionary<UnownedStringSlice, RefPtr<IRSpecSymbol>> SymbolDictionary;
     SymbolDictionary symbols;
 
+    bool tryGetSymbol(UnownedStringSlice const& mangledName, RefPtr<IRSpecSymbol>& outSym);
+
+    // Which definition was chosen for each symbol by earlier links of
+    // the same program for the same target, if any.
+    IRLinkCache* linkCache = nullptr;
+
+    // The unique ids of the modules that `linkCache` holds choices from.
+    HashSet<uint64_t> linkCacheModuleIds;
+
+    bool canUseLinkCache(IRSpecSymbol* sym);
+
     IRBuilder builderStorage;
 
     // The "global" specialization environment.
@@ -72,7 +92,10 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    bool tryGetSymbol(UnownedStringSlice const& mangledName, RefPtr<IRSpecSymbol>& outSym)
+    {
+        return getShared()->tryGetSymbol(mangledName, outSym);
+    }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -708,6 +731,10 @@ void cloneGlobalValueWithCodeCommon(
     IRBuilder* builder = &builderStorage;
     builder->setInsertInto(clonedValue);
 
+    // The body of a value from a deserialized module might not have been decoded yet.
+    if (auto originalModule = originalValue->getModule())
+        originalModule->materializeDeferredBody(originalValue);
+
     cloneDecorations(context, clonedValue, originalValue);
     cloneExtraDecorations(context, clonedValue, originalValues);
     clonedValue->setFullType((IRType*)cloneValue(context, originalValue->getFullType()));
@@ -921,11 +948,11 @@ IRFunc* specializeIRForEntryPoint(
     // not the same as the mangled name of the decl.
     //
     RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().tryGetValue(mangledName, sym))
+    if (!context->tryGetSymbol(mangledName.getUnownedSlice(), sym))
     {
         String hashedName = getHashedName(mangledName.getUnownedSlice());
 
-        if (!context->getSymbols().tryGetValue(hashedName, sym))
+        if (!context->tryGetSymbol(hashedName.getUnownedSlice(), sym))
         {
             SLANG_UNEXPECTED("no matching IR symbol");
             return nullptr;
@@ -1308,9 +1335,9 @@ IRInst* cloneGlobalValueWithLinkage(
     // with the same mangled name as `originalVal` and try
     // to pick the "best" one for our target.
 
-    auto mangledName = String(originalLinkage->getMangledName());
+    auto mangledName = originalLinkage->getMangledName();
     RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().tryGetValue(mangledName, sym) )
+    if( !context->tryGetSymbol(mangledName, sym) )
     {
         if(!originalVal)
             return nullptr;
@@ -1326,10 +1353,34 @@ IRInst* cloneGlobalValueWithLinkage(
     // more specialized for the chosen target. Otherwise, we simply favor
     // definitions over declarations.
     //
+    // When many modules are linked together, the same definition (such as a specialization
+    // or a function from the stdlib) can be in several of them. A candidate whose body
+    // hasn't been decoded yet, and has the same content hash as one we have already
+    // looked at, is identical to it, so we skip it rather than decode it again.
+    //
+    List<uint64_t> seenContentHashes;
     IRInst* bestVal = nullptr;
-    for(IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName )
+    auto linkCache = context->getShared()->canUseLinkCache(sym) ? context->getShared()->linkCache : nullptr;
+    if (linkCache)
+        linkCache->bestValues.tryGetValue(mangledName, bestVal);
+    for(IRSpecSymbol* ss = bestVal ? nullptr : sym.get(); ss; ss = ss->nextWithSameName )
     {
         IRInst* newVal = ss->irGlobalValue;
+        auto newValModule = newVal->getModule();
+
+        uint64_t contentHash = 0;
+        if (newValModule && newValModule->findDeferredBodyContentHash(newVal, contentHash))
+        {
+            if (seenContentHashes.contains(contentHash))
+                continue;
+            seenContentHashes.add(contentHash);
+        }
+
+        // Whether a candidate is a definition (and the capabilities of a generic) depend
+        // on its body, so it must be decoded before candidates are compared.
+        if (newValModule)
+            newValModule->materializeDeferredBody(newVal);
+
         if (isBetterForTarget(context, newVal, bestVal))
             bestVal = newVal;
     }
@@ -1338,6 +1389,8 @@ IRInst* cloneGlobalValueWithLinkage(
     {
         return nullptr;
     }
+    if (linkCache)
+        linkCache->bestValues[bestVal->findDecoration<IRLinkageDecoration>()->getMangledName()] = bestVal;
 
     // Check if we've already cloned this value, for the case where
     // we didn't have an original value (just a name), but we've
@@ -1367,46 +1420,143 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+static bool _isHLSLExported(IRInst* inst)
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
+    for (auto decoration : inst->getDecorations())
+    {
+        const auto op = decoration->getOp();
+        if (op == kIROp_HLSLExportDecoration)
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
+IRModuleSymbolIndex* getLinkSymbolIndex(IRModule* module)
+{
+    const auto modificationCount = module->getGlobalModificationCount();
 
-    auto mangledName = String(linkage->getMangledName());
+    if (auto existingIndex = module->getSymbolIndex())
+    {
+        if (existingIndex->globalModificationCount == modificationCount)
+        {
+            return existingIndex;
+        }
+    }
 
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
+    RefPtr<IRModuleSymbolIndex> index = new IRModuleSymbolIndex();
+    index->globalModificationCount = modificationCount;
+    index->moduleUniqueId = module->getUniqueId();
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.tryGetValue(mangledName, prev))
+    Dictionary<UnownedStringSlice, Index> lastEntryForName;
+    for (auto inst : module->getGlobalInsts())
     {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
+        // Global values with linkage are registered under their mangled name,
+        // so that the linker can find every declaration/definition of a symbol.
+        //
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            auto mangledName = linkage->getMangledName();
+
+            const Index entryIndex = index->entries.getCount();
+            IRModuleSymbolIndex::Entry entry;
+            entry.inst = inst;
+            index->entries.add(entry);
+
+            if (auto lastEntryIndex = lastEntryForName.tryGetValue(mangledName))
+            {
+                index->entries[*lastEntryIndex].nextWithSameName = entryIndex;
+                *lastEntryIndex = entryIndex;
+            }
+            else
+            {
+                index->firstEntryForName.add(mangledName, entryIndex);
+                lastEntryForName.add(mangledName, entryIndex);
+            }
+        }
+
+        if (as<IRBindGlobalGenericParam>(inst))
+        {
+            index->globalGenericParamBindings.add(inst);
+        }
+        else if (_isHLSLExported(inst) || as<IRGlobalParam>(inst))
+        {
+            index->exportedValuesAndGlobalParams.add(inst);
+        }
+        else if (auto hashedStringLits = as<IRGlobalHashedStringLiterals>(inst))
+        {
+            for (UInt i = 0; i < hashedStringLits->getOperandCount(); ++i)
+            {
+                auto stringLit = as<IRStringLit>(hashedStringLits->getOperand(i));
+                index->hashedStringLiterals.add(stringLit->getStringSlice());
+            }
+        }
     }
-    else
+
+    module->setSymbolIndex(index);
+    return index;
+}
+
+bool IRSharedSpecContext::tryGetSymbol(UnownedStringSlice const& mangledName, RefPtr<IRSpecSymbol>& outSym)
+{
+    if (symbols.tryGetValue(mangledName, outSym))
+        return true;
+
+    // Gather the values with this name from every module being linked,
+    // in link order.
+    //
+    ShortList<IRInst*, 4> values;
+    for (auto index : moduleSymbolIndices)
+    {
+        for (Index i = index->findFirstEntry(mangledName); i >= 0; i = index->entries[i].nextWithSameName)
+            values.add(index->entries[i].inst);
+    }
+    if (values.getCount() == 0)
+        return false;
+
+    // Symbols with the same name are chained as: the first value
+    // found, followed by the rest in reverse order. This is the order
+    // that inserting each value after the head of the chain produces,
+    // which is what earlier versions of the linker did, and is kept
+    // because it decides between equally good candidates.
+    //
+    RefPtr<IRSpecSymbol> head = new IRSpecSymbol();
+    head->irGlobalValue = values[0];
+    for (Index i = 1; i < values.getCount(); ++i)
     {
-        sharedContext->symbols.add(mangledName, sym);
+        RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+        sym->irGlobalValue = values[i];
+        sym->nextWithSameName = head->nextWithSameName;
+        head->nextWithSameName = sym;
     }
+
+    // The dictionary key must outlive the link operation, so we use the
+    // copy of the name stored in the module of the first value.
+    //
+    auto linkage = values[0]->findDecoration<IRLinkageDecoration>();
+    symbols.add(linkage->getMangledName(), head);
+
+    outSym = head;
+    return true;
 }
 
-void insertGlobalValueSymbols(
-    IRSharedSpecContext*    sharedContext,
-    IRModule*               originalModule)
+bool IRSharedSpecContext::canUseLinkCache(IRSpecSymbol* sym)
 {
-    if (!originalModule)
-        return;
+    if (!linkCache)
+        return false;
 
-    for(auto ii : originalModule->getGlobalInsts())
+    // The choice for a name can only be cached if all of its definitions are
+    // in modules the cache covers, so that it is the same for every link the
+    // cache is used for.
+    //
+    for (IRSpecSymbol* ss = sym; ss; ss = ss->nextWithSameName)
     {
-        insertGlobalValueSymbol(sharedContext, ii);
+        auto module = ss->irGlobalValue->getModule();
+        if (!module || !linkCacheModuleIds.contains(module->getUniqueId()))
+            return false;
     }
+    return true;
 }
 
 void initializeSharedSpecContext(
@@ -1456,19 +1606,6 @@ struct IRSpecializationState
     }
 };
 
-static bool _isHLSLExported(IRInst* inst)
-{
-    for (auto decoration : inst->getDecorations())
-    {
-        const auto op = decoration->getOp();
-        if (op == kIROp_HLSLExportDecoration)
-        {
-            return true;
-        }
-    }
-    return false;
-}
-
 static bool doesFuncHaveDefinition(IRFunc* func)
 {
     if (func->getFirstBlock() != nullptr)
@@ -1699,6 +1836,109 @@ void GLSLReplaceAtomicUint(IRSpecContext* context, TargetProgram* targetProgram,
     convertAtomicToStorageBuffer(context, bindingToInstMapUnsorted);
 }
 
+void getStdLibIRModulesForTarget(Session* session, TargetRequest* targetReq, List<IRModule*>& outModules, Count linkCount)
+{
+    auto& stdlibModules = session->stdlibModules;
+
+    // The entries are kept in the order they were last used, so that the least
+    // recently used one is dropped once there are too many.
+    //
+    auto& entries = session->m_targetStdLibIRs;
+    Index entryIndex = -1;
+    for (Index i = 0; i < entries.getCount(); ++i)
+    {
+        if (entries[i].targetCaps == targetReq->getTargetCaps())
+        {
+            entryIndex = i;
+            break;
+        }
+    }
+    if (entryIndex < 0)
+    {
+        Session::TargetStdLibIR entry;
+        entry.targetCaps = targetReq->getTargetCaps();
+        entries.add(_Move(entry));
+    }
+    else if (entryIndex != entries.getCount() - 1)
+    {
+        Session::TargetStdLibIR entry = _Move(entries[entryIndex]);
+        entries.removeAt(entryIndex);
+        entries.add(_Move(entry));
+    }
+    if (entries.getCount() > Session::kMaxTargetStdLibIRCount)
+        entries.removeAt(0);
+
+    Session::TargetStdLibIR* targetStdLibIR = &entries.getLast();
+
+    // The copy is out of date if the stdlib modules have changed since it was made.
+    if (targetStdLibIR->irModules.getCount() && targetStdLibIR->irModules.getCount() != stdlibModules.getCount())
+        targetStdLibIR->irModules.clear();
+
+    // Making the copy costs about as much as resolving the `__target_switch`es in the
+    // stdlib functions a few links use, so it is only done once a second link needs it.
+    targetStdLibIR->linkCount += linkCount;
+    if (targetStdLibIR->irModules.getCount() == 0 && targetStdLibIR->linkCount > 1)
+    {
+        List<RefPtr<IRModule>> irModules;
+        for (auto& m : stdlibModules)
+        {
+            // Serializing the module and reading it back is the simplest way to make an
+            // independent copy of it. The source locations are kept as they are, as they
+            // refer to the same source manager.
+            IRSerialData serialData;
+            IRSerialWriter writer;
+            RefPtr<IRModule> irModule;
+            IRSerialReader reader;
+            if (SLANG_FAILED(writer.write(m->getIRModule(), nullptr, SerialOptionFlag::RawSourceLocation, &serialData)) ||
+                SLANG_FAILED(reader.read(serialData, session, nullptr, irModule)))
+            {
+                irModules.clear();
+                break;
+            }
+            specializeTargetSwitchWhereValid(targetReq, irModule);
+            irModules.add(irModule);
+        }
+        targetStdLibIR->irModules = _Move(irModules);
+    }
+
+    if (targetStdLibIR->irModules.getCount())
+    {
+        for (auto& irModule : targetStdLibIR->irModules)
+            outModules.add(irModule);
+    }
+    else
+    {
+        for (auto& m : stdlibModules)
+            outModules.add(m->getIRModule());
+    }
+}
+
+void initializeSharedLinkCache(
+    IRLinkCache*    linkCache,
+    Session*        session,
+    TargetRequest*  targetReq,
+    ComponentType*  program,
+    Count           linkCount)
+{
+    // The stdlib modules are requested for all of the links up front, so that
+    // they all get the same modules.
+    //
+    List<IRModule*> irModules;
+    getStdLibIRModulesForTarget(session, targetReq, irModules, linkCount);
+    program->enumerateIRModules([&](IRModule* irModule)
+    {
+        irModules.add(irModule);
+    });
+
+    linkCache->bestValues.clear();
+    linkCache->moduleStates.clear();
+    for (IRModule* irModule : irModules)
+    {
+        auto index = getLinkSymbolIndex(irModule);
+        linkCache->moduleStates.add(IRLinkCache::ModuleState{ index->moduleUniqueId, index->globalModificationCount });
+    }
+}
+
 LinkedIR linkIR(
     CodeGenContext* codeGenContext)
 {
@@ -1735,16 +1975,15 @@ LinkedIR linkIR(
 
     // We need to be able to look up IR definitions for any symbols in
     // modules that the program depends on (transitively). To
-    // accelerate lookup, we will create a symbol table for looking
-    // up IR definitions by their mangled name.
+    // accelerate lookup, each module has a symbol index for looking
+    // up IR definitions by their mangled name, which is built the
+    // first time the module is linked and reused after that.
     //
 
     List<IRModule*> irModules;
 
     // Link stdlib modules.
-    auto& stdlibModules = static_cast<Session*>(linkage->getGlobalSession())->stdlibModules;
-    for (auto& m : stdlibModules)
-        irModules.add(m->getIRModule());
+    getStdLibIRModulesForTarget(static_cast<Session*>(linkage->getGlobalSession()), targetReq, irModules);
 
     // Link modules in the program.
     program->enumerateIRModules([&](IRModule* irModule)
@@ -1753,27 +1992,68 @@ LinkedIR linkIR(
     });
 
     // Add any modules that were loaded as libraries
+    List<IRModuleSymbolIndex*> irModuleSymbolIndices;
     for (IRModule* irModule : irModules)
     {
-        insertGlobalValueSymbols(sharedContext, irModule);
+        irModuleSymbolIndices.add(getLinkSymbolIndex(irModule));
     }
+    sharedContext->moduleSymbolIndices.addRange(irModuleSymbolIndices);
 
-    // We will also insert the IR global symbols from the IR module
+    // We will also look up IR global symbols in the IR module
     // attached to the `TargetProgram`, since this module is
     // responsible for associating layout information to those
     // global symbols via decorations.
     //
     auto irModuleForLayout = targetProgram->getExistingIRModuleForLayout();
-    insertGlobalValueSymbols(sharedContext, irModuleForLayout);
+    if (irModuleForLayout)
+        sharedContext->moduleSymbolIndices.add(getLinkSymbolIndex(irModuleForLayout));
+
+    // The definition chosen for each symbol only depends on the modules being linked and
+    // the target, so links for the other entry points of the program can reuse the choices
+    // made by this one. If any of the modules have changed since, or aren't linked this
+    // time, the choices are discarded.
+    //
+    {
+        auto linkCache = targetProgram->getLinkCache();
+
+        List<IRLinkCache::ModuleState> moduleStates;
+        for (auto index : sharedContext->moduleSymbolIndices)
+            moduleStates.add(IRLinkCache::ModuleState{ index->moduleUniqueId, index->globalModificationCount });
+
+        bool isUpToDate = linkCache->moduleStates.getCount() != 0;
+        for (Index i = 0; isUpToDate && i < linkCache->moduleStates.getCount(); ++i)
+        {
+            auto const& cachedState = linkCache->moduleStates[i];
+
+            isUpToDate = false;
+            for (auto const& state : moduleStates)
+            {
+                if (state.moduleUniqueId == cachedState.moduleUniqueId)
+                {
+                    isUpToDate = state.globalModificationCount == cachedState.globalModificationCount;
+                    break;
+                }
+            }
+        }
+        if (!isUpToDate)
+        {
+            linkCache->bestValues.clear();
+            linkCache->moduleStates = _Move(moduleStates);
+        }
+        for (auto const& cachedState : linkCache->moduleStates)
+            sharedContext->linkCacheModuleIds.add(cachedState.moduleUniqueId);
+        sharedContext->linkCache = linkCache;
+    }
 
     auto context = state->getContext();
 
     // Combine all of the contents of IRGlobalHashedStringLiterals
     {
         StringSlicePool pool(StringSlicePool::Style::Empty);
-        for (IRModule* irModule : irModules)
+        for (auto index : irModuleSymbolIndices)
         {
-            findGlobalHashedStringLiterals(irModule, pool);
+            for (auto& stringLiteral : index->hashedStringLiterals)
+                pool.add(stringLiteral);
         }
         addGlobalHashedStringLiterals(pool, state->irModule);
     }
@@ -1829,26 +2109,21 @@ LinkedIR linkIR(
     // TODO: We should change these to decorations, akin to how
     // `[bindExistentialSlots(...)]` works, so that they can be attached
     // to the relevant parameters and cloned via `cloneExtraDecorations`.
-    // In the long run we do not want to *ever* iterate over all the
-    // instructions in all the input modules.
     //
     
-    for (IRModule* irModule : irModules)
+    for (auto index : irModuleSymbolIndices)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        for (auto bindInst : index->globalGenericParamBindings)
         {
-            if (auto bindInst = as<IRBindGlobalGenericParam>(inst))
-            {
-                cloneValue(context, bindInst);
-            }
+            cloneValue(context, bindInst);
         }
     }
 
     bool shouldCopyGlobalParams = linkage->m_optionSet.getBoolOption(CompilerOptionName::PreserveParameters);
 
-    for (IRModule* irModule : irModules)
+    for (auto index : irModuleSymbolIndices)
     {
-        for (auto inst : irModule->getGlobalInsts())
+        for (auto inst : index->exportedValuesAndGlobalParams)
         {
             // We need to copy over exported symbols,
             // and any global parameters if preserve-params option is set.
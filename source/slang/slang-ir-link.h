@@ -17,6 +17,33 @@ namespace Slang
         ComPtr<IArtifactPostEmitMetadata>   metadata;
     };
 
+        /// Get the index of the global instructions in `module` that linking
+        /// needs to find, building (or rebuilding) it if needed.
+        ///
+    IRModuleSymbolIndex* getLinkSymbolIndex(IRModule* module);
+
+        /// Get the IR modules of the stdlib to link against for `targetReq`.
+        ///
+        /// Once the stdlib has been linked more than once for the same target capabilities,
+        /// this is a copy of the stdlib IR that the session keeps, in which `__target_switch`es
+        /// have already been resolved for those capabilities.
+        ///
+        /// `linkCount` is the number of links the modules will be used for.
+        ///
+    void getStdLibIRModulesForTarget(Session* session, TargetRequest* targetReq, List<IRModule*>& outModules, Count linkCount = 1);
+
+        /// Set up `linkCache` to be shared by the links of `linkCount` programs that build on
+        /// `program`, such as its specializations, for `targetReq`.
+        ///
+        /// Only the choices between definitions in the stdlib and the IR modules of `program`
+        /// are cached, as those are the same for all of the links.
+        ///
+    void initializeSharedLinkCache(
+        IRLinkCache*    linkCache,
+        Session*        session,
+        TargetRequest*  targetReq,
+        ComponentType*  program,
+        Count           linkCount);
 
     // Clone the IR values reachable from the given entry point
     // into the IR module associated with the specialization state.
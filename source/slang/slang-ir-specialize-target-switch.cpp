@@ -7,6 +7,45 @@
 
 namespace Slang
 {
+    // Find the block to branch to in place of `targetSwitch` for the target, or nullptr if there is none.
+    // `outFailedImplies` is set if a case for the target was rejected, because the target's capabilities
+    // don't imply it.
+    static IRBlock* _findTargetSwitchCase(TargetRequest* target, IRTargetSwitch* targetSwitch, bool& outFailedImplies)
+    {
+        outFailedImplies = false;
+
+        bool isEqual;
+        CapabilitySet bestCapSet = CapabilitySet::makeInvalid();
+        IRBlock* targetBlock = nullptr;
+        CapabilitySet::ImpliesReturnFlags impliesReturnType = CapabilitySet::ImpliesReturnFlags::NotImplied;
+        for (UInt i = 0; i < targetSwitch->getCaseCount(); i++)
+        {
+            auto cap = (CapabilityName)getIntVal(targetSwitch->getCaseValue(i));
+            if (target->getTargetCaps().isIncompatibleWith(cap))
+                continue;
+            CapabilitySet capSet;
+            if (cap == CapabilityName::Invalid) // `default` case
+                capSet = CapabilitySet::makeEmpty();
+            else
+                capSet = CapabilitySet(cap);
+            bool isBetterForTarget = capSet.isBetterForTarget(bestCapSet, target->getTargetCaps(), isEqual);
+            if (isBetterForTarget)
+            {
+                impliesReturnType = target->getTargetCaps().atLeastOneSetImpliedInOther(capSet);
+                bool targetImpliesCapSet = ((int)impliesReturnType & (int)CapabilitySet::ImpliesReturnFlags::Implied || capSet.isEmpty());
+                if (targetImpliesCapSet)
+                {
+                    // Now check if bestCapSet contains targetCaps. If it does not then this is an invalid target
+                    targetBlock = targetSwitch->getCaseBlock(i);
+                    bestCapSet = capSet;
+                }
+                else
+                    outFailedImplies = true;
+            }
+        }
+        return targetBlock;
+    }
+
     void specializeTargetSwitch(TargetRequest* target, IRGlobalValueWithCode* code, DiagnosticSink* sink)
     {
         if (auto gen = as<IRGeneric>(code))
@@ -22,38 +61,10 @@ namespace Slang
         bool changed = false;
         for (auto block : code->getBlocks())
         {
-            bool failedImplies = false;
             if (auto targetSwitch = as<IRTargetSwitch>(block->getTerminator()))
             {
-                bool isEqual;
-                CapabilitySet bestCapSet = CapabilitySet::makeInvalid();
-                IRBlock* targetBlock = nullptr;
-                CapabilitySet::ImpliesReturnFlags impliesReturnType = CapabilitySet::ImpliesReturnFlags::NotImplied;
-                for (UInt i = 0; i < targetSwitch->getCaseCount(); i++)
-                {
-                    auto cap = (CapabilityName)getIntVal(targetSwitch->getCaseValue(i));
-                    if (target->getTargetCaps().isIncompatibleWith(cap))
-                        continue;
-                    CapabilitySet capSet;
-                    if (cap == CapabilityName::Invalid) // `default` case
-                        capSet = CapabilitySet::makeEmpty();
-                    else
-                        capSet = CapabilitySet(cap);
-                    bool isBetterForTarget = capSet.isBetterForTarget(bestCapSet, target->getTargetCaps(), isEqual);
-                    if (isBetterForTarget)
-                    {
-                        impliesReturnType = target->getTargetCaps().atLeastOneSetImpliedInOther(capSet);
-                        bool targetImpliesCapSet = ((int)impliesReturnType & (int)CapabilitySet::ImpliesReturnFlags::Implied || capSet.isEmpty());
-                        if (targetImpliesCapSet)
-                        {
-                            // Now check if bestCapSet contains targetCaps. If it does not then this is an invalid target
-                            targetBlock = targetSwitch->getCaseBlock(i);
-                            bestCapSet = capSet;
-                        }
-                        else
-                            failedImplies = true;
-                    }
-                }
+                bool failedImplies = false;
+                IRBlock* targetBlock = _findTargetSwitchCase(target, targetSwitch, failedImplies);
                 IRBuilder builder(targetSwitch);
                 builder.setInsertBefore(targetSwitch);
                 if (targetBlock)
@@ -90,4 +101,38 @@ namespace Slang
         }
     }
 
+    // Returns true if specializing the target switches in `code` for `target` won't report an error.
+    static bool _canSpecializeTargetSwitchWithoutError(TargetRequest* target, IRGlobalValueWithCode* code)
+    {
+        if (auto gen = as<IRGeneric>(code))
+        {
+            auto innerCode = as<IRGlobalValueWithCode>(findGenericReturnVal(gen));
+            return innerCode ? _canSpecializeTargetSwitchWithoutError(target, innerCode) : true;
+        }
+
+        for (auto block : code->getBlocks())
+        {
+            if (auto targetSwitch = as<IRTargetSwitch>(block->getTerminator()))
+            {
+                bool failedImplies = false;
+                if (!_findTargetSwitchCase(target, targetSwitch, failedImplies) && failedImplies)
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    void specializeTargetSwitchWhereValid(TargetRequest* target, IRModule* module)
+    {
+        DiagnosticSink sink;
+        for (auto globalInst : module->getGlobalInsts())
+        {
+            if (auto code = as<IRGlobalValueWithCode>(globalInst))
+            {
+                if (_canSpecializeTargetSwitchWithoutError(target, code))
+                    specializeTargetSwitch(target, code, &sink);
+            }
+        }
+    }
+
 }
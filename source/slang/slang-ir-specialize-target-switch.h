@@ -11,6 +11,12 @@ namespace Slang
     //
     void specializeTargetSwitch(TargetRequest* target, IRModule* module, DiagnosticSink* sink);
 
+    // Replace the target_switch insts in the functions of `module` for which this can be done
+    // without reporting an error. This is used to prepare a copy of the stdlib for a target,
+    // where functions that would report an error are left for when they are used.
+    //
+    void specializeTargetSwitchWhereValid(TargetRequest* target, IRModule* module);
+
 }
 
 #endif
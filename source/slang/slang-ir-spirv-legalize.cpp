@@ -1906,6 +1906,12 @@ struct SPIRVLegalizationContext : public SourceEmitterBase
         }
     }
 
+        /// True if the debug information for the target only has line tables, so doesn't describe variables.
+    bool isLineTablesOnly()
+    {
+        return m_sharedContext->m_targetProgram->getOptionSet().getBoolOption(CompilerOptionName::DebugInformationLineTablesOnly);
+    }
+
     List<IRInst*> m_instsToRemove;
     void processWorkList()
     {
@@ -2020,12 +2026,14 @@ struct SPIRVLegalizationContext : public SourceEmitterBase
             case kIROp_SPIRVAsm:
                 processSPIRVAsm(as<IRSPIRVAsm>(inst));
                 break;
+            // Variables aren't described when only line tables are output, so the
+            // values stored to them would be dead weight for the rest of the passes.
             case kIROp_DebugValue:
-                if (!isSimpleDataType(as<IRDebugValue>(inst)->getDebugVar()->getDataType()))
+                if (isLineTablesOnly() || !isSimpleDataType(as<IRDebugValue>(inst)->getDebugVar()->getDataType()))
                     inst->removeAndDeallocate();
                 break;
             case kIROp_DebugVar:
-                if (!isSimpleDataType(as<IRDebugVar>(inst)->getDataType()))
+                if (isLineTablesOnly() || !isSimpleDataType(as<IRDebugVar>(inst)->getDataType()))
                 {
                     inst->removeFromParent();
                     m_instsToRemove.add(inst);
@@ -2352,7 +2360,18 @@ SpvSnippet* SPIRVEmitSharedContext::getParsedSpvSnippet(IRTargetIntrinsicDecorat
     {
         return snippet.Ptr();
     }
+    // The stdlib's snippets were parsed when it was compiled.
+    if (auto stdLibSnippets = m_irModule->getSession()->getStdLibSpvSnippets())
+    {
+        snippet = stdLibSnippets->find(intrinsic->getDefinition());
+        if (snippet)
+        {
+            m_parsedSpvSnippets[intrinsic] = snippet;
+            return snippet;
+        }
+    }
     snippet = SpvSnippet::parse(*m_grammarInfo, intrinsic->getDefinition());
+    m_irModule->getSession()->addParsedSpvSnippet();
     if(!snippet)
     {
         m_sink->diagnose(intrinsic, Diagnostics::snippetParsingFailed, intrinsic->getDefinition());
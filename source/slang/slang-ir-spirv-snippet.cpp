@@ -299,7 +299,8 @@ RefPtr<SpvSnippet> SpvSnippet::parse(
                         }
                         else
                         {
-                            SLANG_UNEXPECTED(("Invalid SPV ASM operand: \"" + identifier + "\"").getBuffer());
+                            throw Misc::TextFormatException(
+                                "Text parsing error: Invalid SPV ASM operand: \"" + identifier + "\"");
                         }
                     }
                     break;
@@ -318,5 +319,195 @@ RefPtr<SpvSnippet> SpvSnippet::parse(
     return snippet;
 }
 
+// The binary form written by `SpvSnippetCache::write` is a sequence of words: a
+// version, the number of snippets, then for each snippet its definition (length
+// followed by the characters, padded to a word), result storage class, used
+// storage classes, constants and instructions, each list preceded by its count.
+static const SpvWord kSpvSnippetCacheVersion = 1;
+
+static void _writeWords(List<uint8_t>& out, const void* words, Index wordCount)
+{
+    out.addRange((const uint8_t*)words, wordCount * sizeof(SpvWord));
+}
+
+static void _writeWord(List<uint8_t>& out, SpvWord word)
+{
+    _writeWords(out, &word, 1);
+}
+
+namespace { // anonymous
+
+struct SpvSnippetCacheReader
+{
+    bool readWords(void* outWords, Index wordCount)
+    {
+        const size_t size = wordCount * sizeof(SpvWord);
+        if (size > size_t(end - cursor))
+            return false;
+        memcpy(outWords, cursor, size);
+        cursor += size;
+        return true;
+    }
+    bool readWord(SpvWord& outWord) { return readWords(&outWord, 1); }
+
+    const uint8_t* cursor;
+    const uint8_t* end;
+};
+
+} // anonymous
+
+SpvSnippet* SpvSnippetCache::find(UnownedStringSlice definition) const
+{
+    const Index index = m_definitions.findIndex(definition);
+    return index >= 0 ? m_snippets[index].Ptr() : nullptr;
+}
+
+SlangResult SpvSnippetCache::addParsed(const SPIRVCoreGrammarInfo& spirvGrammar, UnownedStringSlice definition)
+{
+    if (m_definitions.has(definition))
+        return SLANG_OK;
+    RefPtr<SpvSnippet> snippet = SpvSnippet::parse(spirvGrammar, definition);
+    if (!snippet)
+        return SLANG_FAIL;
+    _add(definition, snippet);
+    return SLANG_OK;
+}
+
+void SpvSnippetCache::_add(UnownedStringSlice definition, SpvSnippet* snippet)
+{
+    StringSlicePool::Handle handle;
+    if (m_definitions.findOrAdd(definition, handle))
+        return;
+    SLANG_ASSERT(StringSlicePool::asIndex(handle) == m_snippets.getCount());
+    m_snippets.add(snippet);
+}
+
+void SpvSnippetCache::write(List<uint8_t>& outData) const
+{
+    outData.clear();
+    _writeWord(outData, kSpvSnippetCacheVersion);
+    _writeWord(outData, SpvWord(m_snippets.getCount()));
+    for (Index i = 0; i < m_snippets.getCount(); ++i)
+    {
+        const auto definition = m_definitions.getSlice(StringSlicePool::Handle(i));
+        const SpvWord definitionLength = SpvWord(definition.getLength());
+        _writeWord(outData, definitionLength);
+        outData.addRange((const uint8_t*)definition.begin(), definitionLength);
+        for (auto padding = definitionLength; padding % sizeof(SpvWord); ++padding)
+            outData.add(0);
+
+        const auto snippet = m_snippets[i];
+        _writeWord(outData, SpvWord(snippet->resultStorageClass));
+
+        _writeWord(outData, SpvWord(snippet->usedPtrResultTypeStorageClasses.getCount()));
+        for (auto storageClass : snippet->usedPtrResultTypeStorageClasses)
+            _writeWord(outData, SpvWord(storageClass));
+
+        _writeWord(outData, SpvWord(snippet->constants.getCount()));
+        for (const auto& constant : snippet->constants)
+        {
+            _writeWord(outData, SpvWord(constant.type));
+            _writeWords(outData, constant.intValues, 4);
+            _writeWords(outData, constant.floatValues, 4);
+        }
+
+        _writeWord(outData, SpvWord(snippet->instructions.getCount()));
+        for (const auto& inst : snippet->instructions)
+        {
+            _writeWord(outData, inst.opCode);
+            _writeWord(outData, SpvWord(inst.operands.getCount()));
+            for (const auto& operand : inst.operands)
+            {
+                _writeWord(outData, SpvWord(operand.type));
+                _writeWord(outData, operand.content);
+                _writeWord(outData, operand.content2);
+                _writeWord(outData, operand.content3);
+            }
+        }
+    }
+}
+
+SlangResult SpvSnippetCache::read(const void* data, size_t size)
+{
+    SpvSnippetCacheReader reader;
+    reader.cursor = (const uint8_t*)data;
+    reader.end = reader.cursor + size;
+
+    SpvWord version = 0;
+    SpvWord snippetCount = 0;
+    if (!reader.readWord(version) || version != kSpvSnippetCacheVersion || !reader.readWord(snippetCount))
+        return SLANG_FAIL;
+
+    List<char> definition;
+    for (SpvWord i = 0; i < snippetCount; ++i)
+    {
+        SpvWord definitionLength = 0;
+        if (!reader.readWord(definitionLength))
+            return SLANG_FAIL;
+        const SpvWord definitionWordCount = (definitionLength + sizeof(SpvWord) - 1) / sizeof(SpvWord);
+        definition.setCount(definitionWordCount * sizeof(SpvWord));
+        if (!reader.readWords(definition.getBuffer(), definitionWordCount))
+            return SLANG_FAIL;
+
+        RefPtr<SpvSnippet> snippet = new SpvSnippet();
+        SpvWord value = 0;
+        if (!reader.readWord(value))
+            return SLANG_FAIL;
+        snippet->resultStorageClass = SpvStorageClass(value);
+
+        SpvWord count = 0;
+        if (!reader.readWord(count))
+            return SLANG_FAIL;
+        for (SpvWord j = 0; j < count; ++j)
+        {
+            if (!reader.readWord(value))
+                return SLANG_FAIL;
+            snippet->usedPtrResultTypeStorageClasses.add(SpvStorageClass(value));
+        }
+
+        if (!reader.readWord(count))
+            return SLANG_FAIL;
+        for (SpvWord j = 0; j < count; ++j)
+        {
+            SpvSnippet::ASMConstant constant;
+            if (!reader.readWord(value)
+                || !reader.readWords(constant.intValues, 4)
+                || !reader.readWords(constant.floatValues, 4))
+            {
+                return SLANG_FAIL;
+            }
+            constant.type = SpvSnippet::ASMType(value);
+            snippet->constants.add(constant);
+        }
+
+        if (!reader.readWord(count))
+            return SLANG_FAIL;
+        for (SpvWord j = 0; j < count; ++j)
+        {
+            SpvSnippet::ASMInst inst;
+            SpvWord operandCount = 0;
+            if (!reader.readWord(inst.opCode) || !reader.readWord(operandCount))
+                return SLANG_FAIL;
+            for (SpvWord k = 0; k < operandCount; ++k)
+            {
+                SpvSnippet::ASMOperand operand;
+                if (!reader.readWord(value)
+                    || !reader.readWord(operand.content)
+                    || !reader.readWord(operand.content2)
+                    || !reader.readWord(operand.content3))
+                {
+                    return SLANG_FAIL;
+                }
+                operand.type = SpvSnippet::ASMOperandType(value);
+                inst.operands.add(operand);
+            }
+            snippet->instructions.add(inst);
+        }
+
+        _add(UnownedStringSlice(definition.getBuffer(), definitionLength), snippet);
+    }
+    return SLANG_OK;
+}
+
 
 }
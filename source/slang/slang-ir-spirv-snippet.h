@@ -1,6 +1,7 @@
 // slang-ir-spirv-legalize.h
 #pragma once
 #include "../core/slang-basic.h"
+#include "../core/slang-string-slice-pool.h"
 #include "spirv/unified1/spirv.h"
 
 namespace Slang
@@ -143,5 +144,35 @@ struct SpvSnippet : public RefObject
     static RefPtr<SpvSnippet> parse(const SPIRVCoreGrammarInfo& spirvGrammar, UnownedStringSlice definition);
 };
 
+/// Snippets parsed ahead of time, keyed by the text of their definitions.
+///
+/// The stdlib's snippets are parsed when it is compiled, and saved with it, so that
+/// emitting SPIR-V doesn't have to parse their text again in each compile.
+class SpvSnippetCache : public RefObject
+{
+public:
+    /// Get the snippet parsed from `definition`, or nullptr if there isn't one.
+    SpvSnippet* find(UnownedStringSlice definition) const;
+
+    /// Parse `definition` and add the result. Returns a failure, and adds nothing, if it can't be parsed.
+    SlangResult addParsed(const SPIRVCoreGrammarInfo& spirvGrammar, UnownedStringSlice definition);
+
+    /// Get the number of snippets.
+    Index getCount() const { return m_snippets.getCount(); }
+
+    /// Write the snippets to `outData` in a binary form that `read` can load.
+    void write(List<uint8_t>& outData) const;
+
+    /// Add the snippets in `data`, as produced by `write`.
+    SlangResult read(const void* data, size_t size);
+
+private:
+    void _add(UnownedStringSlice definition, SpvSnippet* snippet);
+
+    // The definitions, with the handle of each being the index of its snippet.
+    StringSlicePool m_definitions = StringSlicePool(StringSlicePool::Style::Empty);
+    List<RefPtr<SpvSnippet>> m_snippets;
+};
+
 
 }
@@ -10,6 +10,8 @@
 
 #include "slang-mangle.h"
 
+#include <atomic>
+
 namespace Slang
 {
     struct IRSpecContext;
@@ -4400,7 +4402,10 @@ namespace Slang
 
     RefPtr<IRModule> IRModule::create(Session* session)
     {
+        static std::atomic<uint64_t> s_nextUniqueId{1};
+
         RefPtr<IRModule> module = new IRModule(session);
+        module->m_uniqueId = s_nextUniqueId++;
 
         auto moduleInst = module->_allocateInst<IRModuleInst>(kIROp_Module, 0);
 
@@ -4410,6 +4415,25 @@ namespace Slang
         return module;
     }
 
+    void IRModule::_materializeDeferredBody(IRInst* inst)
+    {
+        m_deferredBodyLoader->materializeBody(inst);
+
+        // Once every body has been decoded, the loader (and the serialized data
+        // it holds on to) is no longer needed.
+        if (!m_deferredBodyLoader->hasDeferredBodies())
+            m_deferredBodyLoader = nullptr;
+    }
+
+    void IRModule::materializeAllDeferredBodies()
+    {
+        if (m_deferredBodyLoader)
+        {
+            m_deferredBodyLoader->materializeAllBodies();
+            m_deferredBodyLoader = nullptr;
+        }
+    }
+
     IRDominatorTree* IRModule::findOrCreateDominatorTree(IRGlobalValueWithCode* func)
     {
         IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
@@ -8088,6 +8112,19 @@ namespace Slang
         insertAtStart(p);
     }
 
+    // If `inst` is a global instruction or a decoration of one, with `parent` as its
+    // parent, note that the global instructions of the module have changed.
+    static void _noteGlobalModification(IRInst* inst, IRInst* parent)
+    {
+        if (as<IRDecoration>(inst))
+            parent = parent->getParent();
+        if (auto moduleInst = as<IRModuleInst>(parent))
+        {
+            if (moduleInst->module)
+                moduleInst->module->_noteGlobalModification();
+        }
+    }
+
     void IRInst::_insertAt(IRInst* inPrev, IRInst* inNext, IRInst* inParent)
     {
         // Make sure this instruction has been removed from any previous parent
@@ -8118,6 +8155,8 @@ namespace Slang
         this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        _noteGlobalModification(this, inParent);
         
 #if _DEBUG
         validateIRInstOperands(this);
@@ -8205,6 +8244,8 @@ namespace Slang
         prev = nullptr;
         next = nullptr;
         parent = nullptr;
+
+        _noteGlobalModification(this, oldParent);
     }
 
     void IRInst::removeArguments()
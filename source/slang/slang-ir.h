@@ -2319,6 +2319,77 @@ struct IRAnalysis
     IRDominatorTree* getDominatorTree();
 };
 
+    /// An index of the global instructions of an IR module that IR linking needs to find.
+    ///
+    /// The index is built the first time the module is linked against, and then reused
+    /// (without modification) by every later link, so that the global instructions of
+    /// a module are only scanned once rather than once per target and entry point.
+    ///
+    /// Names in the index refer to strings owned by the module, so an index must not
+    /// outlive its module.
+    ///
+struct IRModuleSymbolIndex : RefObject
+{
+        /// A global value with linkage
+    struct Entry
+    {
+        IRInst* inst = nullptr;
+
+            /// Index of the next entry with the same mangled name, or -1
+        Index nextWithSameName = -1;
+    };
+
+        /// Get the index of the first entry with `mangledName`, or -1 if there is none.
+    Index findFirstEntry(UnownedStringSlice const& mangledName) const
+    {
+        if (auto found = firstEntryForName.tryGetValue(mangledName))
+            return *found;
+        return -1;
+    }
+
+        /// Global values with linkage, in module order
+    List<Entry> entries;
+
+        /// Map from a mangled name to the first entry with that name
+    Dictionary<UnownedStringSlice, Index> firstEntryForName;
+
+        /// Global generic parameter bindings, which are always linked
+    List<IRInst*> globalGenericParamBindings;
+
+        /// Exported values and global shader parameters, which are linked
+        /// (exported values always, parameters when they are preserved)
+    List<IRInst*> exportedValuesAndGlobalParams;
+
+        /// Contents of the hashed string literals instructions
+    List<UnownedStringSlice> hashedStringLiterals;
+
+        /// The `IRModule::getGlobalModificationCount` of the module when the index was built
+    uint64_t globalModificationCount = 0;
+
+        /// The `IRModule::getUniqueId` of the module the index was built for
+    uint64_t moduleUniqueId = 0;
+};
+
+    /// Decodes the bodies of global values that were left undecoded when a module
+    /// was deserialized.
+    ///
+    /// Until its body is materialized, such a global value has its decorations but
+    /// no children, and so looks like a declaration.
+    ///
+class IRDeferredBodyLoader : public RefObject
+{
+public:
+        /// Decode the body of `globalValue` if it is still deferred.
+    virtual void materializeBody(IRInst* globalValue) = 0;
+        /// Decode every body that is still deferred.
+    virtual void materializeAllBodies() = 0;
+        /// True if there are bodies that have not been decoded yet.
+    virtual bool hasDeferredBodies() = 0;
+        /// If the body of `globalValue` is still deferred and has a content hash, set `outHash` and return true.
+        /// Global values with the same mangled name and content hash are interchangeable, even across modules.
+    virtual bool findBodyContentHash(IRInst* globalValue, uint64_t& outHash) = 0;
+};
+
 struct IRModule : RefObject
 {
 public:
@@ -2338,6 +2409,10 @@ public:
 
     IRDeduplicationContext* getDeduplicationContext() const { return &m_deduplicationContext; }
 
+        /// Get an id that no other module created by the process has. Unlike the address of the module,
+        /// it can't be shared with a module created after this one is destroyed.
+    uint64_t getUniqueId() const { return m_uniqueId; }
+
     IRDominatorTree* findDominatorTree(IRGlobalValueWithCode* func)
     {
         IRAnalysis* analysis = m_mapInstToAnalysis.tryGetValue(func);
@@ -2392,7 +2467,39 @@ public:
 
     // TODO: make a map with lookup by target?
     ComPtr<ISlangBlob> precompiledDXIL;
+
+        /// Get a count that changes whenever a global instruction, or a decoration of a global
+        /// instruction, is added to or removed from the module. State derived from the global
+        /// instructions (such as the symbol index) is out of date if the count has changed.
+    uint64_t getGlobalModificationCount() const { return m_globalModificationCount; }
+        /// Called by `IRInst` when it is inserted or removed, see `getGlobalModificationCount`.
+    void _noteGlobalModification() { m_globalModificationCount++; }
+
+        /// Get the symbol index built for linking against this module, if any.
+        /// See `getLinkSymbolIndex` in `slang-ir-link.h`.
+    IRModuleSymbolIndex* getSymbolIndex() const { return m_symbolIndex; }
+    void setSymbolIndex(IRModuleSymbolIndex* index) { m_symbolIndex = index; }
+
+        /// Make sure the body of the global value `inst` has been decoded, for a module
+        /// that was deserialized with deferred bodies. Does nothing otherwise.
+    void materializeDeferredBody(IRInst* inst)
+    {
+        if (m_deferredBodyLoader)
+            _materializeDeferredBody(inst);
+    }
+        /// Decode all deferred bodies. Must be called before any code that walks
+        /// the whole module (other than through the linker) when it may have been deserialized.
+    void materializeAllDeferredBodies();
+        /// Get the content hash of the deferred body of `inst` (see `IRDeferredBodyLoader::findBodyContentHash`).
+    bool findDeferredBodyContentHash(IRInst* inst, uint64_t& outHash)
+    {
+        return m_deferredBodyLoader && m_deferredBodyLoader->findBodyContentHash(inst, outHash);
+    }
+
+    void setDeferredBodyLoader(IRDeferredBodyLoader* loader) { m_deferredBodyLoader = loader; }
 private:
+    void _materializeDeferredBody(IRInst* inst);
+
     IRModule() = delete;
 
         /// Ctor
@@ -2430,6 +2537,15 @@ private:
 
     Dictionary<IRInst*, IRAnalysis> m_mapInstToAnalysis;
 
+        /// Index of the global instructions used when linking against this module
+    RefPtr<IRModuleSymbolIndex> m_symbolIndex;
+
+    uint64_t m_globalModificationCount = 0;
+
+    uint64_t m_uniqueId = 0;
+
+        /// Decodes function bodies on demand when the module was deserialized lazily
+    RefPtr<IRDeferredBodyLoader> m_deferredBodyLoader;
 };
 
 
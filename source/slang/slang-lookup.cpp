@@ -387,106 +387,137 @@ static void _lookUpMembersInSuperType(
     _lookUpMembersInSuperTypeImpl(astBuilder, name, leafType, superType, leafIsSuperWitness, request, ioResult, &breadcrumb);
 }
 
-static void _lookupMembersInSuperTypeFacets(ASTBuilder* astBuilder,
+    /// Look up members by `name` in a single `facet` of `selfType`.
+static void _lookUpMembersInFacet(ASTBuilder* astBuilder,
     Name* name,
     Type* selfType,
-    InheritanceInfo const& inheritanceInfo,
+    Facet facet,
     LookupRequest const& request,
     LookupResult& ioResult,
     BreadcrumbInfo* inBreadcrumbs)
 {
-    
+    auto containerDeclRef = facet->getDeclRef().as<ContainerDecl>();
+    if (!containerDeclRef)
+        return;
 
-    for (auto facet : inheritanceInfo.facets)
+    // Check for cases where we should skip this facet for lookup.
+    //
+    // If the facet doesn't correspond to a type, we can't lookup.
+    if (!facet->getType() || !facet->subtypeWitness)
     {
-        auto containerDeclRef = facet->getDeclRef().as<ContainerDecl>();
-        if (!containerDeclRef)
-            continue;
+        return;
+    }
+
+    auto extensionFacet = as<ExtensionDecl>(facet.getImpl()->getDeclRef().getDecl());
+    // If we are looking up in an interface, and the lookup request told us
+    // to skip interfaces, we should do so here.
+    if (auto baseInterfaceDeclRef = containerDeclRef.as<InterfaceDecl>())
+    {
+        if (int(request.options) & int(LookupOptions::IgnoreBaseInterfaces))
+            return;
+    }
+    // If we are looking up only immediate members, ignore non "Self" facets or extension to "Self"
+    else if (int(request.options) & int(LookupOptions::IgnoreInheritance)
+        && (facet.getImpl()->directness != Facet::Directness::Self
+            && (!extensionFacet || !extensionFacet->targetType.type->equals(selfType))
+            ))
+    {
+        return;
+    }
+
+    // Some things that are syntactically `InheritanceDecl`s don't actually
+    // represent a subtype/supertype relationship, and thus we shouldn't
+    // include members from the base type when doing lookup in the
+    // derived type.
+    //
+    // TODO: this check currently only works when the facet is a direct
+    // basee type of the type we are looking up in. This is OK because the
+    // only case where we use `IgnoreForLookupModifier` is for skipping the
+    // underlying int type of an enum type. We should either makes this
+    // check more general, or just explicitly detect this case here without
+    // relying on the modifier.
+    if (auto declaredSubtypeWitness = as<DeclaredSubtypeWitness>(facet->subtypeWitness))
+    {
+        auto inheritanceDeclRef = declaredSubtypeWitness->getDeclRef();
+        if (inheritanceDeclRef.getDecl()->hasModifier<IgnoreForLookupModifier>())
+            return;
+    }
+
+    // We are now going to lookup in the facet.
 
-        // Check for cases where we should skip this facet for lookup.
+    BreadcrumbInfo* newBreadcrumbs = inBreadcrumbs;
+    BreadcrumbInfo subtypeInfo;
+    auto parentDeclRef = containerDeclRef;
+    if (facet->directness != Facet::Directness::Self)
+    {
+        // Depending on the type of the facet, we may want to specialize the
+        // declRef that we are going to lookup in. If the facet represents
+        // an extension, we should just lookup in the extension decl.
+        // 
+        // If the facet is an extension to an interface type, we should
+        // specialize the interface declRef to the concrete type that this
+        // extension applied to.
+        //
+        // If the facet represents an implementation of interface type,
+        // we should also specialize the interface declRef with the concrete
+        // type info.
         //
-        // If the facet doesn't correspond to a type, we can't lookup.
-        if (!facet->getType() || !facet->subtypeWitness)
+        parentDeclRef = _maybeSpecializeSuperTypeDeclRef(
+            astBuilder, containerDeclRef, facet->getType(), facet->subtypeWitness)
+            .as<ContainerDecl>();
+        if (as<ThisTypeDecl>(parentDeclRef.getDecl()) && getUnownedStringSliceText(name) == toSlice("This"))
         {
-            continue;
+            // If we are going looking for `This` in a `ThisType`, we just need to return the declRef itself.
+            AddToLookupResult(ioResult, CreateLookupResultItem(parentDeclRef, inBreadcrumbs));
+            return;
         }
 
-        auto extensionFacet = as<ExtensionDecl>(facet.getImpl()->getDeclRef().getDecl());
-        // If we are looking up in an interface, and the lookup request told us
-        // to skip interfaces, we should do so here.
-        if (auto baseInterfaceDeclRef = containerDeclRef.as<InterfaceDecl>())
+        // If we are looking up in a base type, we also need to make sure
+        // to create a breadcrumb to track the sub to super indirection.
+        if (facet->kind == Facet::Kind::Type)
         {
-            if (int(request.options) & int(LookupOptions::IgnoreBaseInterfaces))
-                continue;
-        }
-        // If we are looking up only immediate members, ignore non "Self" facets or extension to "Self"
-        else if (int(request.options) & int(LookupOptions::IgnoreInheritance)
-            && (facet.getImpl()->directness != Facet::Directness::Self
-                && (!extensionFacet || !extensionFacet->targetType.type->equals(selfType))
-                ))
-        {
-            continue;
+            subtypeInfo.kind = LookupResultItem_Breadcrumb::Kind::SuperType;
+            subtypeInfo.val = facet->subtypeWitness;
+            subtypeInfo.prev = inBreadcrumbs;
+            subtypeInfo.declRef = facet->getDeclRef();
+            newBreadcrumbs = &subtypeInfo;
         }
+    }
+    _lookUpDirectAndTransparentMembers(astBuilder, name, containerDeclRef.getDecl(), parentDeclRef, request, ioResult, newBreadcrumbs);
+}
 
-        // Some things that are syntactically `InheritanceDecl`s don't actually
-        // represent a subtype/supertype relationship, and thus we shouldn't
-        // include members from the base type when doing lookup in the
-        // derived type.
+static void _lookupMembersInSuperTypeFacets(ASTBuilder* astBuilder,
+    Name* name,
+    Type* selfType,
+    InheritanceInfo const& inheritanceInfo,
+    LookupRequest const& request,
+    LookupResult& ioResult,
+    BreadcrumbInfo* inBreadcrumbs)
+{
+    // When we know the name we are looking for, we can use the member index
+    // for the facets to only visit the facets that can contribute a result.
+    //
+    // Looking up `This` is special-cased per-facet rather than found through
+    // member dictionaries, so it always goes through all the facets.
+    //
+    auto memberIndex = inheritanceInfo.memberIndex.get();
+    if (memberIndex && !request.isCompletionRequest() && getUnownedStringSliceText(name) != toSlice("This"))
+    {
+        // Lookup in a facet may trigger semantic checking that causes the
+        // index to be rebuilt, so we take a copy of the facets to visit.
         //
-        // TODO: this check currently only works when the facet is a direct
-        // basee type of the type we are looking up in. This is OK because the
-        // only case where we use `IgnoreForLookupModifier` is for skipping the
-        // underlying int type of an enum type. We should either makes this
-        // check more general, or just explicitly detect this case here without
-        // relying on the modifier.
-        if (auto declaredSubtypeWitness = as<DeclaredSubtypeWitness>(facet->subtypeWitness))
-        {
-            auto inheritanceDeclRef = declaredSubtypeWitness->getDeclRef();
-            if (inheritanceDeclRef.getDecl()->hasModifier<IgnoreForLookupModifier>())
-                continue;
-        }
+        ShortList<Facet, 16> facetsToVisit;
+        for (auto facetIndex : memberIndex->getFacetsForName(name))
+            facetsToVisit.add(memberIndex->getFacet(facetIndex));
 
-        // We are now going to lookup in the facet.
-
-        BreadcrumbInfo* newBreadcrumbs = inBreadcrumbs;
-        BreadcrumbInfo subtypeInfo;
-        auto parentDeclRef = containerDeclRef;
-        if (facet->directness != Facet::Directness::Self)
-        {
-            // Depending on the type of the facet, we may want to specialize the
-            // declRef that we are going to lookup in. If the facet represents
-            // an extension, we should just lookup in the extension decl.
-            // 
-            // If the facet is an extension to an interface type, we should
-            // specialize the interface declRef to the concrete type that this
-            // extension applied to.
-            //
-            // If the facet represents an implementation of interface type,
-            // we should also specialize the interface declRef with the concrete
-            // type info.
-            //
-            parentDeclRef = _maybeSpecializeSuperTypeDeclRef(
-                astBuilder, containerDeclRef, facet->getType(), facet->subtypeWitness)
-                .as<ContainerDecl>();
-            if (as<ThisTypeDecl>(parentDeclRef.getDecl()) && getText(name) == "This")
-            {
-                // If we are going looking for `This` in a `ThisType`, we just need to return the declRef itself.
-                AddToLookupResult(ioResult, CreateLookupResultItem(parentDeclRef, inBreadcrumbs));
-                continue;
-            }
+        for (auto facet : facetsToVisit)
+            _lookUpMembersInFacet(astBuilder, name, selfType, facet, request, ioResult, inBreadcrumbs);
+        return;
+    }
 
-            // If we are looking up in a base type, we also need to make sure
-            // to create a breadcrumb to track the sub to super indirection.
-            if (facet->kind == Facet::Kind::Type)
-            {
-                subtypeInfo.kind = LookupResultItem_Breadcrumb::Kind::SuperType;
-                subtypeInfo.val = facet->subtypeWitness;
-                subtypeInfo.prev = inBreadcrumbs;
-                subtypeInfo.declRef = facet->getDeclRef();
-                newBreadcrumbs = &subtypeInfo;
-            }
-        }
-        _lookUpDirectAndTransparentMembers(astBuilder, name, containerDeclRef.getDecl(), parentDeclRef, request, ioResult, newBreadcrumbs);
+    for (auto facet : inheritanceInfo.facets)
+    {
+        _lookUpMembersInFacet(astBuilder, name, selfType, facet, request, ioResult, inBreadcrumbs);
     }
 }
 
@@ -499,7 +530,7 @@ static void _lookUpMembersInSuperTypeDeclImpl(
     BreadcrumbInfo* inBreadcrumbs)
 {
     auto semantics = request.semantics;
-    if (!as<InterfaceDecl>(declRef.getDecl()) && getText(name) == "This")
+    if (!as<InterfaceDecl>(declRef.getDecl()) && getUnownedStringSliceText(name) == toSlice("This"))
     {
         // If we are looking for `This` in anything other than an InterfaceDecl,
         // we just need to return the declRef itself.
@@ -472,6 +472,26 @@ struct IRGenEnv
     IRGenEnv*   outer = nullptr;
 };
 
+// State used to reuse the IR of function bodies from an earlier build of the module
+// being lowered (see `tryReuseFuncBody`).
+struct FuncBodyReuseState
+{
+    // The IR and digests of the earlier build.
+    RefPtr<IRReuseSource> source;
+
+    // The digests of the module being lowered.
+    IRReuseDigests const* digests = nullptr;
+
+    // The modules to search for the declaration of a global value in the earlier IR.
+    List<Module*> modules;
+
+    // The functions with bodies in the earlier IR, by mangled name.
+    Dictionary<UnownedStringSlice, IRFunc*> oldFuncs;
+
+    // The number of bodies cloned from the earlier IR so far.
+    Index reusedBodyCount = 0;
+};
+
 struct SharedIRGenContext
 {
     
@@ -525,6 +545,10 @@ struct SharedIRGenContext
     ModuleDecl*     m_mainModuleDecl = nullptr;
     Linkage*        m_linkage = nullptr;
 
+    // If set, function bodies that haven't changed since an earlier
+    // build of the module are cloned from its IR.
+    FuncBodyReuseState* m_funcBodyReuse = nullptr;
+
     // List of all string literals used in user code, regardless
     // of how they were used (i.e., whether or not they were hashed).
     //
@@ -7444,6 +7468,305 @@ top:
     }
 }
 
+// When a module is compiled again after an edit, most of its function bodies are
+// usually unchanged. If the binary module from the earlier build is available, and
+// the digests of the two builds show that neither a function's body nor anything
+// outside of the function bodies has changed, we clone the body from the earlier IR
+// instead of lowering it from the AST again.
+//
+// The earlier IR has already been through the mandatory passes that run after
+// lowering, and running them again over a cloned body is harmless.
+
+    /// Clones the body of a function from the IR of an earlier build into the
+    /// module being lowered.
+struct FuncBodyReuser
+{
+    IRGenContext* context;
+    FuncBodyReuseState* state;
+    IRFunc* oldFunc;
+    IRBuilder builder;
+    IRCloneEnv env;
+
+    FuncBodyReuser(IRGenContext* inContext, IRFunc* inOldFunc)
+        : context(inContext)
+        , state(inContext->shared->m_funcBodyReuse)
+        , oldFunc(inOldFunc)
+        , builder(inContext->irBuilder->getModule())
+    {
+        builder.setInsertInto(builder.getModule()->getModuleInst());
+    }
+
+        /// Clone the body of the old function into `newFunc`, the IR for `decl`.
+        ///
+        /// Returns false, leaving `newFunc` untouched, if something the body refers
+        /// to has no known counterpart in the module being lowered.
+        ///
+    bool cloneBodyInto(FunctionDeclBase* decl, IRFunc* newFunc)
+    {
+        // The signature of the function has to lower to the same type as before.
+        if (mapOuterValue(oldFunc->getFullType()) != newFunc->getFullType())
+            return false;
+
+        // A recursive call in the old body refers to the new function.
+        env.mapOldValToNew[oldFunc] = newFunc;
+
+        for (auto block : oldFunc->getBlocks())
+        {
+            if (!_mapOuterValuesRec(block))
+                return false;
+        }
+
+        // The decorations on the function itself were already added when lowering its
+        // declaration. Registering them in the environment keeps them from being cloned.
+        for (auto decoration : oldFunc->getDecorations())
+            env.mapOldValToNew[decoration] = decoration;
+
+        cloneInstDecorationsAndChildren(&env, builder.getModule(), oldFunc, newFunc);
+
+        _setSourceLocs(decl, newFunc);
+        return true;
+    }
+
+        /// Is `inst` the old function, or nested inside it?
+    bool isInOldFunc(IRInst* inst)
+    {
+        for (auto ii = inst; ii; ii = ii->getParent())
+        {
+            if (ii == oldFunc)
+                return true;
+        }
+        return false;
+    }
+
+        /// Find the counterpart of `oldInst`, a global value in the earlier IR, in the module
+        /// being lowered. Returns null if there is no counterpart we can be sure of.
+        ///
+    IRInst* mapOuterValue(IRInst* oldInst)
+    {
+        if (!oldInst)
+            return nullptr;
+        if (auto newInst = lookUp(&env, oldInst))
+            return newInst;
+        auto newInst = _mapOuterValueImpl(oldInst);
+        if (newInst)
+            env.mapOldValToNew[oldInst] = newInst;
+        return newInst;
+    }
+
+    IRInst* _mapOuterValueImpl(IRInst* oldInst)
+    {
+        // Only global values can be mapped. Anything else, such as the parameter
+        // of an enclosing generic, has no counterpart we can find.
+        //
+        if (!as<IRModuleInst>(oldInst->getParent()))
+            return nullptr;
+
+        if (auto linkage = oldInst->findDecoration<IRLinkageDecoration>())
+            return _findLinkedValue(oldInst, linkage->getMangledName());
+
+        switch (oldInst->getOp())
+        {
+        case kIROp_BoolLit:
+            return builder.getBoolValue(as<IRConstant>(oldInst)->value.intVal != 0);
+
+        case kIROp_IntLit:
+            if (auto type = (IRType*)mapOuterValue(oldInst->getDataType()))
+                return builder.getIntValue(type, as<IRConstant>(oldInst)->value.intVal);
+            return nullptr;
+
+        case kIROp_FloatLit:
+            if (auto type = (IRType*)mapOuterValue(oldInst->getDataType()))
+                return builder.getFloatValue(type, as<IRConstant>(oldInst)->value.floatVal);
+            return nullptr;
+
+        case kIROp_StringLit:
+            return builder.getStringValue(as<IRConstant>(oldInst)->getStringSlice());
+
+        case kIROp_PtrLit:
+            if (as<IRConstant>(oldInst)->value.ptrVal)
+                return nullptr;
+            if (auto type = (IRType*)mapOuterValue(oldInst->getFullType()))
+                return builder.getNullPtrValue(type);
+            return nullptr;
+
+        case kIROp_VoidLit:
+            return builder.getVoidValue();
+
+        case kIROp_ResultType:
+            // The earlier IR has been through `lowerErrorHandling`, which changes the
+            // signatures of functions that can throw, while the module being lowered
+            // hasn't. Code that deals with errors is lowered again instead.
+            return nullptr;
+
+        default:
+            break;
+        }
+
+        // Any other global must be a hoistable instruction, which we find or
+        // create from the counterparts of its operands.
+        //
+        if (!getIROpInfo(oldInst->getOp()).isHoistable() || oldInst->getFirstDecorationOrChild())
+            return nullptr;
+
+        IRType* newType = nullptr;
+        if (auto oldType = oldInst->getFullType())
+        {
+            newType = (IRType*)mapOuterValue(oldType);
+            if (!newType)
+                return nullptr;
+        }
+
+        UInt operandCount = oldInst->getOperandCount();
+        ShortList<IRInst*> newOperands;
+        newOperands.setCount(operandCount);
+        for (UInt ii = 0; ii < operandCount; ++ii)
+        {
+            newOperands[ii] = mapOuterValue(oldInst->getOperand(ii));
+            if (!newOperands[ii])
+                return nullptr;
+        }
+        return builder.emitIntrinsicInst(
+            newType,
+            oldInst->getOp(),
+            operandCount,
+            newOperands.getArrayView().getBuffer());
+    }
+
+        /// Find the counterpart of a global value with linkage, by lowering the
+        /// declaration with the same mangled name.
+    IRInst* _findLinkedValue(IRInst* oldInst, UnownedStringSlice mangledName)
+    {
+        Decl* decl = nullptr;
+        for (auto module : state->modules)
+        {
+            decl = as<Decl>(module->findExportFromMangledName(mangledName));
+            if (decl)
+                break;
+        }
+        if (!decl)
+            return nullptr;
+
+        IRInst* newInst = nullptr;
+        if (oldInst->getOp() == kIROp_StructKey)
+            newInst = getInterfaceRequirementKey(context, decl);
+        if (!newInst)
+        {
+            if (auto genericDecl = as<GenericDecl>(decl))
+                decl = genericDecl->inner;
+            auto loweredVal = ensureDecl(context, decl);
+            if (loweredVal.flavor == LoweredValInfo::Flavor::Simple ||
+                loweredVal.flavor == LoweredValInfo::Flavor::Ptr)
+            {
+                newInst = loweredVal.val;
+            }
+        }
+
+        // The declaration must lower to the same kind of value as before.
+        if (!newInst || newInst->getOp() != oldInst->getOp())
+            return nullptr;
+        return newInst;
+    }
+
+        /// Map every value outside of the old function that `inst`, its decorations
+        /// and its children refer to. Returns false if any of them can't be mapped.
+    bool _mapOuterValuesRec(IRInst* inst)
+    {
+        auto mapOperand = [&](IRInst* operand)
+        {
+            if (!operand || isInOldFunc(operand))
+                return true;
+            auto newOperand = mapOuterValue(operand);
+            if (!newOperand)
+                return false;
+
+            // String literals used by code are collected for the module, in the same way
+            // as when lowering a string literal expression.
+            if (as<IRStringLit>(newOperand) && !as<IRDecoration>(inst))
+                context->shared->m_stringLiterals.add(newOperand);
+            return true;
+        };
+
+        if (!mapOperand(inst->getFullType()))
+            return false;
+        for (UInt ii = 0; ii < inst->getOperandCount(); ++ii)
+        {
+            if (!mapOperand(inst->getOperand(ii)))
+                return false;
+        }
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (!_mapOuterValuesRec(child))
+                return false;
+        }
+        return true;
+    }
+
+        /// Set the source locations of the cloned instructions.
+        ///
+        /// The text of the function is the same in both builds, so the location of an
+        /// instruction relative to the function is too. If the earlier IR has no source
+        /// locations, the instructions are given the location of the function.
+        ///
+    void _setSourceLocs(FunctionDeclBase* decl, IRFunc* newFunc)
+    {
+        auto newFuncLoc = newFunc->sourceLoc.isValid() ? newFunc->sourceLoc : decl->loc;
+        auto oldFuncLoc = oldFunc->sourceLoc;
+        SourceView* oldView = nullptr;
+        if (oldFuncLoc.isValid() && newFunc->sourceLoc.isValid())
+            oldView = context->getLinkage()->getSourceManager()->findSourceView(oldFuncLoc);
+
+        List<IRInst*> workList;
+        workList.add(newFunc);
+        while (workList.getCount())
+        {
+            auto inst = workList.getLast();
+            workList.removeLast();
+            for (auto child : inst->getChildren())
+            {
+                auto loc = newFuncLoc;
+                if (oldView && child->sourceLoc.isValid() && oldView->getRange().contains(child->sourceLoc))
+                    loc = newFuncLoc + (Int(child->sourceLoc.getRaw()) - Int(oldFuncLoc.getRaw()));
+                child->sourceLoc = loc;
+                workList.add(child);
+            }
+        }
+    }
+};
+
+    /// Try to fill in the body of `irFunc`, the IR for `decl`, by cloning it from
+    /// an earlier build of the module being lowered.
+    ///
+    /// Returns false if the body needs to be lowered from the AST.
+    ///
+static bool tryReuseFuncBody(IRGenContext* context, FunctionDeclBase* decl, IRFunc* irFunc)
+{
+    auto state = context->shared->m_funcBodyReuse;
+    if (!state)
+        return false;
+
+    // Only functions at global scope are reused. The body of a function nested in
+    // a generic would refer to the parameters of the generic.
+    if (!as<IRModuleInst>(irFunc->getParent()))
+        return false;
+
+    auto mangledName = getMangledName(context->astBuilder, decl);
+    auto bodyDigest = state->digests->bodyDigests.tryGetValue(mangledName);
+    auto oldBodyDigest = state->source->digests.bodyDigests.tryGetValue(mangledName);
+    if (!bodyDigest || !oldBodyDigest || *bodyDigest != *oldBodyDigest)
+        return false;
+
+    IRFunc* oldFunc = nullptr;
+    if (!state->oldFuncs.tryGetValue(mangledName.getUnownedSlice(), oldFunc))
+        return false;
+
+    FuncBodyReuser reuser(context, oldFunc);
+    if (!reuser.cloneBodyInto(decl, irFunc))
+        return false;
+
+    state->reusedBodyCount++;
+    return true;
+}
+
 struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
 {
     IRGenContext*   context;
@@ -9790,6 +10113,11 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         else if (isDeclInDifferentModule(context, decl) && !isForceInlineEarly(decl))
         {
 
+        }
+        else if (emitBody && tryReuseFuncBody(subContext, decl, irFunc))
+        {
+            // The body hasn't changed since an earlier build of the module,
+            // and was cloned from its IR.
         }
         else if (emitBody)
         {
@@ -10987,6 +11315,171 @@ static void ensureAllDeclsRec(
     }
 }
 
+    /// Collect the functions under `decl` whose IR can be reused from an earlier build
+    /// of the module. This visits the same declarations as `ensureAllDeclsRec`, except
+    /// that nothing nested inside a generic or an interface is reused.
+static void _collectReusableFuncsRec(Decl* decl, List<FuncDecl*>& outFuncs)
+{
+    if (auto funcDecl = as<FuncDecl>(decl))
+    {
+        // A `[__unsafeForceInlineEarly]` function is inlined into its callers by the
+        // mandatory passes, so its body is part of theirs. A patch constant function
+        // attribute is handled as part of lowering the body.
+        if (as<BlockStmt>(funcDecl->body) &&
+            !isForceInlineEarly(funcDecl) &&
+            !funcDecl->findModifier<PatchConstantFuncAttribute>())
+        {
+            outFuncs.add(funcDecl);
+        }
+    }
+    else if (as<InterfaceDecl>(decl))
+    {
+    }
+    else if (as<AggTypeDeclBase>(decl) || as<NamespaceDecl>(decl) || as<FileDecl>(decl))
+    {
+        for (auto memberDecl : as<ContainerDecl>(decl)->members)
+            _collectReusableFuncsRec(memberDecl, outFuncs);
+    }
+}
+
+void computeIRReuseDigests(Module* module, IRReuseDigests& outDigests)
+{
+    outDigests = IRReuseDigests();
+    outDigests.isRecorded = true;
+
+    auto moduleDecl = module->getModuleDecl();
+    if (!moduleDecl)
+        return;
+
+    List<FuncDecl*> funcs;
+    for (auto memberDecl : moduleDecl->members)
+        _collectReusableFuncsRec(memberDecl, funcs);
+
+    // Find where the body of each function is in its source file.
+    struct BodyRange
+    {
+        Index begin;
+        Index end;
+        FuncDecl* funcDecl;
+    };
+    Dictionary<SourceFile*, List<BodyRange>> bodyRangesPerFile;
+
+    auto sourceManager = module->getLinkage()->getSourceManager();
+    for (auto funcDecl : funcs)
+    {
+        auto body = as<BlockStmt>(funcDecl->body);
+        auto sourceView = sourceManager->findSourceView(body->loc);
+        if (!sourceView)
+            continue;
+        auto range = sourceView->getRange();
+        if (!range.contains(body->closingSourceLoc) || !range.contains(funcDecl->loc) ||
+            funcDecl->loc.getRaw() >= body->loc.getRaw())
+        {
+            continue;
+        }
+        Index begin = range.getOffset(body->loc);
+        Index end = range.getOffset(body->closingSourceLoc) + 1;
+        auto content = sourceView->getContent();
+        if (begin >= end || end > content.getLength() || content[begin] != '{' || content[end - 1] != '}')
+            continue;
+
+        // A body that contains preprocessor directives, or depends on where it is in the
+        // file, can't be told apart from the text around it.
+        auto bodyText = content.subString(begin, end - begin);
+        if (bodyText.indexOf('#') != -1 || bodyText.indexOf(toSlice("__LINE__")) != -1)
+            continue;
+
+        bodyRangesPerFile[sourceView->getSourceFile()].add(BodyRange{ begin, end, funcDecl });
+    }
+
+    DigestBuilder<SHA1> digestBuilder;
+    digestBuilder.append(String(getBuildTagString()));
+
+    // Whether binary modules are checked for being up to date doesn't change the IR,
+    // and is usually only set for the build that finds the binary module out of date.
+    // Neither does how many modules the linkage keeps loaded.
+    CompilerOptionSet optionSet = module->getOptionSet();
+    optionSet.options.remove(CompilerOptionName::UseUpToDateBinaryModule);
+    optionSet.options.remove(CompilerOptionName::ModuleMemoryBudget);
+    optionSet.buildHash(digestBuilder);
+
+    for (auto file : module->getFileDependencies())
+    {
+        auto bodyRanges = bodyRangesPerFile.tryGetValue(file);
+        if (!bodyRanges)
+        {
+            digestBuilder.append(file->getDigest());
+            continue;
+        }
+
+        // Bodies that overlap come from the same text, such as a macro that is expanded
+        // more than once, and are left out.
+        bodyRanges->sort([](BodyRange const& a, BodyRange const& b) { return a.begin < b.begin; });
+        List<bool> isReusable;
+        isReusable.setCount(bodyRanges->getCount());
+        for (Index i = 0; i < bodyRanges->getCount(); ++i)
+            isReusable[i] = true;
+        for (Index i = 1; i < bodyRanges->getCount(); ++i)
+        {
+            if ((*bodyRanges)[i].begin < (*bodyRanges)[i - 1].end)
+            {
+                isReusable[i] = false;
+                isReusable[i - 1] = false;
+            }
+        }
+
+        // The signature covers all of the text of the file except the reusable bodies.
+        auto content = file->getContent();
+        Index offset = 0;
+        for (Index i = 0; i < bodyRanges->getCount(); ++i)
+        {
+            if (!isReusable[i])
+                continue;
+            auto const& bodyRange = (*bodyRanges)[i];
+            auto bodyText = content.subString(bodyRange.begin, bodyRange.end - bodyRange.begin);
+            outDigests.bodyDigests[getMangledName(module->getASTBuilder(), bodyRange.funcDecl)] =
+                SHA1::compute(bodyText.begin(), bodyText.getLength());
+
+            digestBuilder.append(content.subString(offset, bodyRange.begin - offset));
+            digestBuilder.append(toSlice("{}"));
+            offset = bodyRange.end;
+        }
+        digestBuilder.append(content.subString(offset, content.getLength() - offset));
+    }
+    outDigests.signatureDigest = digestBuilder.finalize();
+}
+
+    /// Set up `outState` to reuse function bodies from `reuseSource` while lowering `module`,
+    /// if the two builds agree on everything outside of the function bodies.
+static bool _initFuncBodyReuseState(
+    Module* module,
+    RefPtr<IRReuseSource> reuseSource,
+    FuncBodyReuseState& outState)
+{
+    auto& digests = module->getIRReuseDigests();
+    if (digests.signatureDigest != reuseSource->digests.signatureDigest)
+        return false;
+
+    outState.source = reuseSource;
+    outState.digests = &digests;
+
+    outState.modules.add(module);
+    for (auto dependency : module->getModuleDependencyList())
+        outState.modules.add(dependency);
+    for (auto stdlibModule : module->getLinkage()->getSessionImpl()->stdlibModules)
+        outState.modules.add(stdlibModule);
+
+    for (auto inst : reuseSource->irModule->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->getFirstBlock())
+            continue;
+        if (auto linkage = func->findDecoration<IRExportDecoration>())
+            outState.oldFuncs[linkage->getMangledName()] = func;
+    }
+    return true;
+}
+
 RefPtr<IRModule> generateIRForTranslationUnit(
     ASTBuilder* astBuilder,
     TranslationUnitRequest* translationUnit)
@@ -11017,6 +11510,24 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     context->irBuilder = builder;
     context->includeDebugInfo = compileRequest->getLinkage()->m_optionSet.getDebugInfoLevel() != DebugInfoLevel::None;
 
+    // If an out of date binary module was found for this module, reuse the function
+    // bodies in it that haven't changed. Debug information and obfuscated names in the
+    // earlier IR can't be matched up with the module being lowered, so those builds
+    // always lower every body.
+    FuncBodyReuseState funcBodyReuseState;
+    if (auto translationUnitModule = translationUnit->getModule())
+    {
+        if (auto reuseSource = linkage->takeIRReuseSource(translationUnitModule->getNameObj()))
+        {
+            if (!context->includeDebugInfo &&
+                !sharedContext->m_obfuscateCode &&
+                _initFuncBodyReuseState(translationUnitModule, reuseSource, funcBodyReuseState))
+            {
+                sharedContext->m_funcBodyReuse = &funcBodyReuseState;
+            }
+        }
+    }
+
     // We need to emit IR for all public/exported symbols
     // in the translation unit.
     //
@@ -11053,6 +11564,8 @@ RefPtr<IRModule> generateIRForTranslationUnit(
         ensureAllDeclsRec(context, decl);
     }
 
+    linkage->addReusedFuncBodyCount(funcBodyReuseState.reusedBodyCount);
+
     // Build a global instruction to hold all the string
     // literals used in the module.
     {
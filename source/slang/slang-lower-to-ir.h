@@ -30,6 +30,11 @@ namespace Slang
         ASTBuilder*             astBuilder,
         TranslationUnitRequest* translationUnit);
 
+        /// Compute the digests used to reuse the IR of unchanged functions when `module`
+        /// is compiled again, from its checked AST and source files.
+        ///
+    void computeIRReuseDigests(Module* module, IRReuseDigests& outDigests);
+
         /// Generate an IR module to represent the specializations applied by `componentType`.
         ///
         /// The generated IR will encode how `componentType` specializes global or
@@ -0,0 +1,231 @@
+// slang-memory-report.cpp
+#include "slang-memory-report.h"
+
+#include "slang-compiler.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+const char* getMemoryCategoryName(MemoryCategory category)
+{
+    switch (category)
+    {
+        case MemoryCategory::ASTBuilder:        return "ASTBuilder";
+        case MemoryCategory::IRModule:          return "IRModule";
+        case MemoryCategory::ContainerPool:     return "ContainerPool";
+        case MemoryCategory::NamePool:          return "NamePool";
+        case MemoryCategory::StringSlicePool:   return "StringSlicePool";
+        case MemoryCategory::SourceManager:     return "SourceManager";
+        case MemoryCategory::LinkageCaches:     return "LinkageCaches";
+        case MemoryCategory::GlobalASTBuilder:  return "GlobalASTBuilder";
+        case MemoryCategory::GlobalIRModule:    return "GlobalIRModule";
+        case MemoryCategory::LinkedIRModule:    return "LinkedIRModule";
+        default:                                return "unknown";
+    }
+}
+
+template<typename K, typename V>
+static size_t _estimateDictionaryBytes(const Dictionary<K, V>& dictionary)
+{
+    return size_t(dictionary.getCount()) * (sizeof(K) + sizeof(V));
+}
+
+static void _addIRModuleUsage(IRModule* irModule, MemoryUsageSnapshot& ioSnapshot)
+{
+    if (!irModule)
+        return;
+    ioSnapshot[MemoryCategory::IRModule].addArena(irModule->getMemoryArena());
+    ioSnapshot[MemoryCategory::ContainerPool].addBytes(irModule->getContainerPool().calcMemoryAllocated());
+}
+
+    /// Add the memory held by the global session, which is shared by all of its sessions.
+static void _addGlobalSessionUsage(Session* session, MemoryUsageSnapshot& ioSnapshot)
+{
+    HashSet<ASTBuilder*> astBuilders;
+    auto addASTBuilder = [&](ASTBuilder* astBuilder)
+    {
+        if (astBuilder && astBuilders.add(astBuilder))
+            ioSnapshot[MemoryCategory::GlobalASTBuilder].addArena(astBuilder->getArena());
+    };
+    addASTBuilder(session->m_sharedASTBuilder->getInnerASTBuilder());
+    addASTBuilder(session->getBuiltinLinkage()->getASTBuilder());
+
+    auto& irUsage = ioSnapshot[MemoryCategory::GlobalIRModule];
+    for (auto& stdlibModule : session->stdlibModules)
+    {
+        addASTBuilder(stdlibModule->getASTBuilder());
+        if (auto irModule = stdlibModule->getIRModule())
+            irUsage.addArena(irModule->getMemoryArena());
+    }
+    for (auto& targetStdLibIR : session->m_targetStdLibIRs)
+    {
+        for (auto& irModule : targetStdLibIR.irModules)
+            irUsage.addArena(irModule->getMemoryArena());
+    }
+
+    ioSnapshot[MemoryCategory::NamePool].addBytes(session->getRootNamePool()->calcMemoryUsage());
+}
+
+void Linkage::collectMemoryUsage(MemoryUsageSnapshot& outSnapshot)
+{
+    outSnapshot = MemoryUsageSnapshot();
+
+    // Modules usually share the linkage's ASTBuilder, which must only be counted once.
+    HashSet<ASTBuilder*> astBuilders;
+    auto addASTBuilder = [&](ASTBuilder* astBuilder)
+    {
+        if (astBuilder && astBuilders.add(astBuilder))
+            outSnapshot[MemoryCategory::ASTBuilder].addArena(astBuilder->getArena());
+    };
+    addASTBuilder(getASTBuilder());
+
+    auto addModule = [&](Module* module)
+    {
+        addASTBuilder(module->getASTBuilder());
+        _addIRModuleUsage(module->getIRModule(), outSnapshot);
+        outSnapshot[MemoryCategory::StringSlicePool].addArena(module->getMangledExportPool().getArena());
+    };
+    for (auto& loadedModule : loadedModulesList)
+        addModule(loadedModule);
+    for (auto& inactiveModule : m_inactiveModules)
+        addModule(inactiveModule);
+
+    for (auto& compiledModule : compiledModules)
+        _addIRModuleUsage(compiledModule, outSnapshot);
+    for (auto& [_, reuseSource] : m_irReuseSources)
+        _addIRModuleUsage(reuseSource->irModule, outSnapshot);
+
+    _addGlobalSessionUsage(getSessionImpl(), outSnapshot);
+
+    for (auto sourceFile : getSourceManager()->getSourceFiles())
+        outSnapshot[MemoryCategory::SourceManager].addBytes(sourceFile->getContentSize());
+
+    auto& cacheUsage = outSnapshot[MemoryCategory::LinkageCaches];
+    cacheUsage.addBytes(_estimateDictionaryBytes(m_containerTypes));
+    cacheUsage.addBytes(_estimateDictionaryBytes(mapPathToLoadedModule));
+    cacheUsage.addBytes(_estimateDictionaryBytes(mapNameToLoadedModules));
+    cacheUsage.addBytes(_estimateDictionaryBytes(mapMangledNameToRTTIObjectIndex));
+    cacheUsage.addBytes(_estimateDictionaryBytes(mapInterfaceMangledNameToSequentialIDCounters));
+}
+
+void Linkage::recordMemoryUsage(const char* phaseName, IRModule* linkedIRModule)
+{
+    if (!m_optionSet.getBoolOption(CompilerOptionName::ReportMemory))
+        return;
+
+    MemoryUsageSnapshot snapshot;
+    collectMemoryUsage(snapshot);
+    if (linkedIRModule)
+        snapshot[MemoryCategory::LinkedIRModule].addArena(linkedIRModule->getMemoryArena());
+    m_memoryReport.addPhase(phaseName, snapshot);
+}
+
+SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getMemoryUsageEntryCount()
+{
+    m_memoryUsageEntries.clear();
+    auto addEntries = [&](const char* phaseName, const MemoryUsageSnapshot& snapshot)
+    {
+        for (Index i = 0; i < Index(MemoryCategory::CountOf); ++i)
+        {
+            slang::MemoryUsageEntry entry;
+            entry.phase = phaseName;
+            entry.category = getMemoryCategoryName(MemoryCategory(i));
+            entry.reservedBytes = snapshot.usages[i].reserved;
+            entry.usedBytes = snapshot.usages[i].used;
+            m_memoryUsageEntries.add(entry);
+        }
+    };
+
+    for (const auto& phase : m_memoryReport.getPhases())
+        addEntries(phase.name.getBuffer(), phase.snapshot);
+    if (m_memoryReport.getPhases().getCount())
+        addEntries("peak", m_memoryReport.getPeak());
+
+    MemoryUsageSnapshot current;
+    collectMemoryUsage(current);
+    addEntries("current", current);
+
+    return m_memoryUsageEntries.getCount();
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getMemoryUsageEntry(
+    SlangInt index,
+    slang::MemoryUsageEntry* outEntry)
+{
+    if (!outEntry || index < 0 || index >= m_memoryUsageEntries.getCount())
+        return SLANG_E_INVALID_ARG;
+    *outEntry = m_memoryUsageEntries[Index(index)];
+    return SLANG_OK;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::getMemoryUsageReport(slang::IBlob** outReport)
+{
+    if (!outReport)
+        return SLANG_E_INVALID_ARG;
+
+    MemoryUsageSnapshot current;
+    collectMemoryUsage(current);
+
+    StringBuilder report;
+    m_memoryReport.writeText(current, report);
+    *outReport = StringBlob::moveCreate(report).detach();
+    return SLANG_OK;
+}
+
+void MemoryReport::addPhase(const char* name, const MemoryUsageSnapshot& snapshot)
+{
+    for (Index i = 0; i < Index(MemoryCategory::CountOf); ++i)
+    {
+        auto& peak = m_peak.usages[i];
+        peak.reserved = Math::Max(peak.reserved, snapshot.usages[i].reserved);
+        peak.used = Math::Max(peak.used, snapshot.usages[i].used);
+    }
+
+    // Phases run many times over the life of a session, so only the most recent
+    // run of each is kept.
+    for (auto& phase : m_phases)
+    {
+        if (phase.name == name)
+        {
+            phase.snapshot = snapshot;
+            return;
+        }
+    }
+    Phase phase;
+    phase.name = name;
+    phase.snapshot = snapshot;
+    m_phases.add(phase);
+}
+
+static void _writeSnapshotText(const char* name, const MemoryUsageSnapshot& snapshot, StringBuilder& out)
+{
+    char buffer[256];
+    size_t totalReserved = 0;
+    size_t totalUsed = 0;
+
+    out << name << ":\n";
+    for (Index i = 0; i < Index(MemoryCategory::CountOf); ++i)
+    {
+        const auto& usage = snapshot.usages[i];
+        totalReserved += usage.reserved;
+        totalUsed += usage.used;
+        snprintf(buffer, sizeof(buffer), "  %-16s %14zu reserved %14zu used\n",
+            getMemoryCategoryName(MemoryCategory(i)), usage.reserved, usage.used);
+        out << buffer;
+    }
+    snprintf(buffer, sizeof(buffer), "  %-16s %14zu reserved %14zu used\n", "total", totalReserved, totalUsed);
+    out << buffer;
+}
+
+void MemoryReport::writeText(const MemoryUsageSnapshot& current, StringBuilder& out) const
+{
+    out << "Estimated memory use in bytes. Memory held outside of arenas is approximated from element counts.\n";
+    for (const auto& phase : m_phases)
+        _writeSnapshotText(phase.name.getBuffer(), phase.snapshot, out);
+    if (m_phases.getCount())
+        _writeSnapshotText("peak", m_peak, out);
+    _writeSnapshotText("current", current, out);
+}
+
+}
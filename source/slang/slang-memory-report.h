@@ -0,0 +1,92 @@
+// slang-memory-report.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+namespace Slang
+{
+        /// The parts of the compiler that memory use is reported for.
+    enum class MemoryCategory
+    {
+        ASTBuilder,         ///< Arenas of the `ASTBuilder`s holding the AST of loaded modules
+        IRModule,           ///< Arenas of loaded, compiled and reusable `IRModule`s
+        ContainerPool,      ///< The `ContainerPool` of each of those `IRModule`s
+        NamePool,           ///< Names in the `RootNamePool` of the global session
+        StringSlicePool,    ///< Pools of the mangled names exported by loaded modules
+        SourceManager,      ///< Contents of the source files loaded by the linkage
+        LinkageCaches,      ///< The lookup dictionaries kept by the linkage
+        GlobalASTBuilder,   ///< Arenas of the global session's `ASTBuilder`s, holding the AST of the builtin modules
+        GlobalIRModule,     ///< Arenas of the IR of the builtin modules, and of its copies for each target
+        LinkedIRModule,     ///< Arena of the IR module linked for code generation, while it exists
+        CountOf,
+    };
+
+        /// Get the name of `category`, as used in reports.
+    const char* getMemoryCategoryName(MemoryCategory category);
+
+        /// An estimate of the bytes of memory reserved and used by one part of the compiler.
+        ///
+        /// Arenas are measured exactly, but allocations made outside of them (such as the
+        /// nodes' own lists) aren't counted. Memory that is held in containers rather than
+        /// arenas is estimated from the number of elements, and reported as both reserved
+        /// and used.
+        ///
+    struct MemoryUsage
+    {
+        void addArena(const MemoryArena& arena)
+        {
+            reserved += arena.calcTotalMemoryAllocated();
+            used += arena.calcTotalMemoryUsed();
+        }
+        void addBytes(size_t bytes)
+        {
+            reserved += bytes;
+            used += bytes;
+        }
+
+        size_t reserved = 0;
+        size_t used = 0;
+    };
+
+        /// The memory use of each `MemoryCategory` at one point in time.
+    struct MemoryUsageSnapshot
+    {
+        MemoryUsage& operator[](MemoryCategory category) { return usages[Index(category)]; }
+        const MemoryUsage& operator[](MemoryCategory category) const { return usages[Index(category)]; }
+
+        MemoryUsage usages[Index(MemoryCategory::CountOf)];
+    };
+
+        /// The memory use of a linkage at the end of the most recent run of each
+        /// pipeline phase, and the peak of each category over every run.
+        ///
+        /// Besides the ends of phases, memory use is also recorded at the points within
+        /// code generation where it is at its highest: once the IR for an entry point has
+        /// been linked, and once it has been optimized, just before it is emitted.
+    class MemoryReport
+    {
+    public:
+        struct Phase
+        {
+            String name;
+            MemoryUsageSnapshot snapshot;
+        };
+
+            /// Record `snapshot` as the memory use at the end of a run of the phase `name`.
+        void addPhase(const char* name, const MemoryUsageSnapshot& snapshot);
+
+            /// Get the recorded phases, in the order they first ran.
+        const List<Phase>& getPhases() const { return m_phases; }
+
+            /// Get the largest use of each category in any recorded phase.
+        const MemoryUsageSnapshot& getPeak() const { return m_peak; }
+
+            /// Write the recorded phases, the peak values and `current` as a table.
+        void writeText(const MemoryUsageSnapshot& current, StringBuilder& out) const;
+
+    private:
+        List<Phase> m_phases;
+        MemoryUsageSnapshot m_peak;
+    };
+}
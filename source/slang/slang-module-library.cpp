@@ -63,6 +63,9 @@ SlangResult loadModuleLibrary(const Byte* inBytes, size_t bytesCount, String pat
         options.sink = req->getSink();
         options.astBuilder = linkage->getASTBuilder();
         options.modulePath = path;
+        // Libraries that are linked together often contain the same definitions, so bodies
+        // are only decoded once the linker has picked which copy of a symbol it will use.
+        options.deferIRFunctionBodies = true;
         SLANG_RETURN_ON_FAIL(SerialContainerUtil::read(&riffContainer, options, nullptr, containerData));
         DiagnosticSink sink;
 
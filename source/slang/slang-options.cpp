@@ -68,6 +68,7 @@ enum class ValueCategory
     HelpStyle,
     OptimizationLevel,
     DebugLevel, 
+    DebugInfoSourceMode,
     FileSystemType,
     VulkanShift,
     SourceEmbedStyle,
@@ -87,6 +88,7 @@ SLANG_GET_VALUE_CATEGORY(FloatingPointMode, FloatingPointMode)
 SLANG_GET_VALUE_CATEGORY(FileSystemType, TypeTextUtil::FileSystemType)
 SLANG_GET_VALUE_CATEGORY(HelpStyle, CommandOptionsWriter::Style)
 SLANG_GET_VALUE_CATEGORY(OptimizationLevel, SlangOptimizationLevel)
+SLANG_GET_VALUE_CATEGORY(DebugInfoSourceMode, SlangDebugInfoSourceMode)
 SLANG_GET_VALUE_CATEGORY(VulkanShift, HLSLToVulkanLayoutOptions::Kind)
 SLANG_GET_VALUE_CATEGORY(SourceEmbedStyle, SourceEmbedUtil::Style)
 SLANG_GET_VALUE_CATEGORY(Language, SourceLanguage)
@@ -147,6 +149,9 @@ void initCommandOptions(CommandOptions& options)
         options.addCategory(CategoryKind::Value, "debug-level", "Debug Level", UserValue(ValueCategory::DebugLevel));
         options.addValues(TypeTextUtil::getDebugLevelInfos());
 
+        options.addCategory(CategoryKind::Value, "debug-info-source-mode", "Debug Info Source Mode", UserValue(ValueCategory::DebugInfoSourceMode));
+        options.addValues(TypeTextUtil::getDebugInfoSourceModeInfos());
+
         options.addCategory(CategoryKind::Value, "file-system-type", "File System Type", UserValue(ValueCategory::FileSystemType));
         options.addValues(TypeTextUtil::getFileSystemTypeInfos());
 
@@ -280,6 +285,16 @@ void initCommandOptions(CommandOptions& options)
         "attributes to detect entry points."},
         { OptionKind::Specialize, "-specialize", "-specialize <typename>",
             "Specialize the last entrypoint with <typename>.\n"},
+        { OptionKind::Permutation, "-permutation", "-permutation <arg>[,<arg>...]",
+            "Add a permutation of the program to generate code for. "
+            "Each <arg> is either a type for the next specialization parameter of the program, "
+            "or <name>=<value> to set the value of the link-time constant <name>.\n"
+            "When any permutations are given, code is generated for each of them instead of for the program itself. "
+            "The output for each permutation is written to the output path with '-<index>' appended to the file name.\n"},
+        { OptionKind::CheckJobs, "-check-jobs", "-check-jobs <count>",
+            "Check the function bodies of a module on up to <count> threads at the same time. "
+            "Diagnostics for the function bodies are then reported after the diagnostics for the other "
+            "declarations of the module, in source order. Defaults to 1.\n"},
         { OptionKind::EmitIr,       "-emit-ir", nullptr, "Emit IR typically as a '.slang-module' when outputting to a container." },
         { OptionKind::Help,         "-h,-help,--help", "-h or -h <help-category>", "Print this message, or help in specified category." },
         { OptionKind::HelpStyle,    "-help-style", "-help-style <help-style>", "Help formatting style" },
@@ -339,6 +354,7 @@ void initCommandOptions(CommandOptions& options)
         { OptionKind::InputFilesRemain, "--", nullptr, "Treat the rest of the command line as input files."},
         { OptionKind::ReportDownstreamTime, "-report-downstream-time", nullptr, "Reports the time spent in the downstream compiler." },
         { OptionKind::ReportPerfBenchmark, "-report-perf-benchmark", nullptr, "Reports compiler performance benchmark results." },
+        { OptionKind::ReportMemory, "-report-memory", nullptr, "Reports the memory held by the compiler at the end of each phase, once the IR for code generation has been linked and optimized, and the peak values." },
         { OptionKind::SkipSPIRVValidation, "-skip-spirv-validation", nullptr, "Skips spirv validation." },
         { OptionKind::SourceEmbedStyle, "-source-embed-style", "-source-embed-style <source-embed-style>",
         "If source embedding is enabled, defines the style used. When enabled (with any style other than `none`), "
@@ -390,6 +406,11 @@ void initCommandOptions(CommandOptions& options)
         "<debug-level> is the amount of information, 0..3, unspecified means 2\n" 
         "<debug-info-format> specifies a debugging info format\n"
         "It is valid to have multiple -g options, such as a <debug-level> and a <debug-info-format>" },
+        { OptionKind::DebugInformationSource, "-debug-info-source", "-debug-info-source <debug-info-source-mode>",
+        "Sets how debug information refers to source files. If not specified the text of each source is embedded." },
+        { OptionKind::DebugInformationLineTablesOnly, "-gline-tables-only", nullptr,
+        "Only include line tables in debug information, so variables aren't described. "
+        "Includes debug information at the standard level if no -g option asks for it." },
         { OptionKind::LineDirectiveMode, "-line-directive-mode", "-line-directive-mode <line-directive-mode>", 
         "Sets how the `#line` directives should be produced. Available options are:\n"
         "If not specified, default behavior is to use C-style `#line` directives "
@@ -397,6 +418,10 @@ void initCommandOptions(CommandOptions& options)
         "for GLSL output." },
         { OptionKind::Optimization, "-O...", "-O<optimization-level>", "Set the optimization level."},
         { OptionKind::Obfuscate, "-obfuscate", nullptr, "Remove all source file information from outputs." },
+        { OptionKind::EmitCompactSource, "-emit-compact-source", nullptr,
+        "Generate source that is faster for a downstream compiler to process. "
+        "Indentation and `#line` directives are not output (unless the line directive mode is `source-map`), "
+        "locals are given short names, and more single use temporaries are folded into expressions." },
         { OptionKind::GLSLForceScalarLayout,
          "-force-glsl-scalar-layout,-fvk-use-scalar-layout", nullptr,
          "Make data accessed through ConstantBuffer, ParameterBlock, StructuredBuffer, ByteAddressBuffer and general pointers follow the 'scalar' layout when targeting GLSL or SPIRV."},
@@ -465,6 +490,14 @@ void initCommandOptions(CommandOptions& options)
         "Pass the input through mostly unmodified to the "
         "existing compiler <compiler>.\n" 
         "These are intended for debugging/testing purposes, when you want to be able to see what these existing compilers do with the \"same\" input and options"},
+        { OptionKind::DownstreamJobs, "-downstream-jobs", "-downstream-jobs <count>",
+        "Run up to <count> downstream compiles at the same time. Code generation for each entry point and "
+        "target still runs one at a time, but the downstream compiles of the generated code are deferred "
+        "until all code has been generated, and are then run concurrently. Defaults to 1."},
+        { OptionKind::DownstreamCache, "-downstream-cache", "-downstream-cache <path>",
+        "Keep the results of downstream compiles in the cache directory <path>. A compile of the same "
+        "generated code with the same compiler version and options reuses the cached result and diagnostics, "
+        "even across runs."},
     };
 
     _addOptions(makeConstArrayView(downstreamOpts), options);
@@ -1110,6 +1143,36 @@ void OptionsParser::setFloatingPointMode(RawTarget* rawTarget, FloatingPointMode
     }
 }
 
+// Split the argument of `-permutation` at commas that aren't nested inside
+// brackets, so that a type argument like `Foo<A, B>` stays in one piece.
+static void _splitPermutationArgs(const UnownedStringSlice& text, List<String>& outArgs)
+{
+    Index depth = 0;
+    const char* start = text.begin();
+    for (const char* cur = text.begin(); cur < text.end(); ++cur)
+    {
+        switch (*cur)
+        {
+        case '<': case '(': case '[':
+            depth++;
+            break;
+        case '>': case ')': case ']':
+            depth--;
+            break;
+        case ',':
+            if (depth == 0)
+            {
+                outArgs.add(UnownedStringSlice(start, cur).trim());
+                start = cur + 1;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    outArgs.add(UnownedStringSlice(start, text.end()).trim());
+}
+
 static SlangResult _loadRepro(const String& path, DiagnosticSink* sink, EndToEndCompileRequest* request)
 {
     List<uint8_t> buffer;
@@ -1721,6 +1784,7 @@ SlangResult OptionsParser::_parse(
             case OptionKind::DumpReproOnError:
             case OptionKind::ReportDownstreamTime:
             case OptionKind::ReportPerfBenchmark:
+            case OptionKind::ReportMemory:
             case OptionKind::SkipSPIRVValidation:
             case OptionKind::DisableSpecialization:
             case OptionKind::DisableDynamicDispatch:
@@ -1742,6 +1806,7 @@ SlangResult OptionsParser::_parse(
             case OptionKind::DisableSourceMap:
             case OptionKind::DefaultImageFormatUnknown:
             case OptionKind::Obfuscate:
+            case OptionKind::EmitCompactSource:
             case OptionKind::OutputIncludes:
             case OptionKind::PreprocessorOutput:
             case OptionKind::DumpAst:
@@ -1770,8 +1835,8 @@ SlangResult OptionsParser::_parse(
                 SLANG_RETURN_ON_FAIL(File::readAllBytes(fileName.value, contents));
                 SLANG_RETURN_ON_FAIL(m_session->loadStdLib(contents.getData(), contents.getSizeInBytes()));
                 
-                // Ensure that the linkage's AST builder is up-to-date.
-                linkage->getASTBuilder()->m_cachedNodes = asInternal(m_session)->getGlobalASTBuilder()->m_cachedNodes;
+                // Ensure that the linkage's AST builder finds the Vals of the loaded stdlib.
+                linkage->getASTBuilder()->m_cachedNodes.setParent(&asInternal(m_session)->getGlobalASTBuilder()->m_cachedNodes);
 
                 break;
             }
@@ -2098,6 +2163,16 @@ SlangResult OptionsParser::_parse(
                 }
                 break;
             }
+            case OptionKind::Permutation:
+            {
+                CommandLineArg arg;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(arg));
+
+                List<String> permutationArgs;
+                _splitPermutationArgs(arg.value.getUnownedSlice(), permutationArgs);
+                m_requestImpl->m_permutationArgStrings.add(permutationArgs);
+                break;
+            }
             case OptionKind::Language:
             {
                 CommandLineArg name;
@@ -2135,6 +2210,27 @@ SlangResult OptionsParser::_parse(
                 m_compileRequest->setPassThrough(passThrough);
                 break;
             }
+            case OptionKind::CheckJobs:
+            {
+                Int jobCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, jobCount));
+                linkage->m_optionSet.set(CompilerOptionName::CheckJobs, (int)jobCount);
+                break;
+            }
+            case OptionKind::DownstreamJobs:
+            {
+                Int jobCount = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, jobCount));
+                linkage->m_optionSet.set(CompilerOptionName::DownstreamJobs, (int)jobCount);
+                break;
+            }
+            case OptionKind::DownstreamCache:
+            {
+                CommandLineArg cacheDirectory;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cacheDirectory));
+                linkage->m_optionSet.set(CompilerOptionName::DownstreamCache, cacheDirectory.value);
+                break;
+            }
             case OptionKind::MacroDefine:
             {
                 // The value to be defined might be part of the same option, as in:
@@ -2243,6 +2339,20 @@ SlangResult OptionsParser::_parse(
                 break;
             }
             case OptionKind::DebugInformation: SLANG_RETURN_ON_FAIL(_parseDebugInformation(arg)); break;
+            case OptionKind::DebugInformationSource:
+            {
+                SlangDebugInfoSourceMode value;
+                SLANG_RETURN_ON_FAIL(_expectValue(value));
+                linkage->m_optionSet.set(CompilerOptionName::DebugInformationSource, DebugInfoSourceMode(value));
+                break;
+            }
+            case OptionKind::DebugInformationLineTablesOnly:
+            {
+                linkage->m_optionSet.set(CompilerOptionName::DebugInformationLineTablesOnly, true);
+                if (linkage->m_optionSet.getDebugInfoLevel() == DebugInfoLevel::None)
+                    m_compileRequest->setDebugInfoLevel(SLANG_DEBUG_INFO_LEVEL_STANDARD);
+                break;
+            }
             case OptionKind::FileSystem:
             {
                 typedef TypeTextUtil::FileSystemType FileSystemType;
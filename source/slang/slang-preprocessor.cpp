@@ -1030,6 +1030,12 @@ struct Preprocessor
         /// Stores macro definition and invocation info for language server.
     PreprocessorContentAssistInfo* contentAssistInfo = nullptr;
 
+        /// Names of all macros that have been looked up, whether or not a definition was found.
+        ///
+        /// A macro definition supplied on input whose name is not in this set cannot
+        /// have influenced the output token stream.
+    HashSet<Name*>                          consultedMacroNames;
+
     NamePool* getNamePool() { return namePool; }
     SourceManager* getSourceManager() { return sourceManager; }
 
@@ -1162,6 +1168,14 @@ static MacroDefinition* LookupMacro(Environment* environment, Name* name)
     return NULL;
 }
 
+// Find the currently-defined macro of the given name, or return NULL,
+// and record that the definition (or absence) of `name` was consulted.
+static MacroDefinition* LookupMacro(Preprocessor* preprocessor, Name* name)
+{
+    preprocessor->consultedMacroNames.add(name);
+    return LookupMacro(&preprocessor->globalEnv, name);
+}
+
 bool MacroInvocation::isBusy(MacroDefinition* macro, MacroInvocation* duringMacroInvocation)
 {
     for(auto busyMacroInvocation = duringMacroInvocation; busyMacroInvocation; busyMacroInvocation = busyMacroInvocation->m_nextBusyMacroInvocation )
@@ -1392,7 +1406,7 @@ void ExpansionInputStream::_maybeBeginMacroInvocation()
         // invocation.
         //
         Name* name = token.getName();
-        MacroDefinition* macro = LookupMacro(&preprocessor->globalEnv, name);
+        MacroDefinition* macro = LookupMacro(preprocessor, name);
         if (!macro)
         {
             return;
@@ -2309,7 +2323,7 @@ static SourceLoc PeekLoc(PreprocessorDirectiveContext* context)
 static MacroDefinition* LookupMacro(PreprocessorDirectiveContext* context, Name* name)
 {
     auto preprocessor = context->m_preprocessor;
-    return LookupMacro(&preprocessor->globalEnv, name);
+    return LookupMacro(preprocessor, name);
 }
 
 // Determine if we have read everything on the directive's line.
@@ -3260,7 +3274,7 @@ static void HandleDefineDirective(PreprocessorDirectiveContext* context)
         return;
     Name* name = nameToken.getName();
 
-    MacroDefinition* oldMacro = LookupMacro(&context->m_preprocessor->globalEnv, name);
+    MacroDefinition* oldMacro = LookupMacro(context->m_preprocessor, name);
     if (oldMacro)
     {
         auto sink = GetSink(context);
@@ -3455,7 +3469,7 @@ static void HandleUndefDirective(PreprocessorDirectiveContext* context)
     Name* name = nameToken.getName();
 
     Environment* env = &context->m_preprocessor->globalEnv;
-    MacroDefinition* macro = LookupMacro(env, name);
+    MacroDefinition* macro = LookupMacro(context->m_preprocessor, name);
     if (macro != NULL)
     {
         // name was defined, so remove it
@@ -4046,7 +4060,7 @@ Result findMacroValue(
     using namespace preprocessor;
 
     auto namePool = preprocessor->namePool;
-    auto macro = LookupMacro(&preprocessor->globalEnv, namePool->getName(macroName));
+    auto macro = LookupMacro(preprocessor, namePool->getName(macroName));
     if(!macro)
         return SLANG_FAIL;
     if(macro->flavor != MacroDefinition::Flavor::ObjectLike)
@@ -4078,6 +4092,12 @@ Result findMacroValue(
     return SLANG_OK;
 }
 
+HashSet<Name*> const& getConsultedMacroNames(
+    Preprocessor*   preprocessor)
+{
+    return preprocessor->consultedMacroNames;
+}
+
 TokenList preprocessSource(
     SourceFile*                         file,
     DiagnosticSink*                     sink,
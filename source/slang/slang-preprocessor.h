@@ -88,6 +88,15 @@ Result findMacroValue(
     String&         outValue,
     SourceLoc&      outLoc);
 
+    /// Get the names of all macros looked up so far, whether or not a definition was found.
+    ///
+    /// This includes names tested with `#ifdef`, `#ifndef` and `defined()`, as well as
+    /// every identifier that was considered for macro expansion. A preprocessor definition
+    /// whose name is not in this set cannot have affected the preprocessed output.
+    ///
+HashSet<Name*> const& getConsultedMacroNames(
+    Preprocessor*   preprocessor);
+
 } // namespace Slang
 
 #endif
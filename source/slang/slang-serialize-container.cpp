@@ -7,12 +7,14 @@
 #include "../core/slang-math.h"
 
 #include "slang-compiler.h"
+#include "slang-check.h"
 #include "slang-serialize-ast.h"
 #include "slang-serialize-ir.h"
 #include "slang-serialize-source-loc.h"
 #include "slang-serialize-factory.h"
 #include "../core/slang-stream.h"
 #include "slang-parser.h"
+#include "../compiler-core/slang-source-file-digest-cache.h"
 
 #include "slang-mangled-lexer.h"
 
@@ -79,6 +81,10 @@ namespace Slang {
             // IR module
             dstModule.irModule = module->getIRModule();
             SLANG_ASSERT(dstModule.irModule);
+
+            // All of the module is written out, so any function bodies that are
+            // still in serialized form need to be decoded first.
+            dstModule.irModule->materializeAllDeferredBodies();
         }
 
         // Here we assume that the first file in the file dependencies is the module's file path.
@@ -140,8 +146,27 @@ namespace Slang {
         }
         Path::getCanonical(linkageRoot, linkageRoot);
 
+        // Record the size and modification time of each file read from the OS file system, so
+        // that a check for whether the module is up to date can skip hashing files that haven't changed.
+        const bool canStatFiles = module->getLinkage() && module->getLinkage()->m_fileSystem == nullptr;
+
         for (auto file : fileDependencies)
         {
+            SerialContainerDataModule::DependentFileState fileState;
+            fileState.digest = file->getDigest();
+            if (canStatFiles && file->getPathInfo().hasFileFoundPath())
+            {
+                // The file may have changed since the module was compiled, so its current stat
+                // only describes the contents that were compiled if they hash the same.
+                SHA1::Digest currentDigest;
+                if (SLANG_FAILED(SourceFileDigestCache::readFile(file->getPathInfo().foundPath, fileState.stat, currentDigest)) ||
+                    currentDigest != fileState.digest)
+                {
+                    fileState.stat = File::Stat();
+                }
+            }
+            dstModule.dependentFileStates.add(fileState);
+
             if (file->getPathInfo().hasFoundPath())
             {
                 String canonicalFilePath = file->getPathInfo().foundPath;
@@ -176,6 +201,12 @@ namespace Slang {
             }
         }
         dstModule.digest = module->computeDigest();
+
+        // The standard library is only ever compiled once, so there is nothing to reuse its IR for.
+        if (module->getModuleDecl() && !isFromStdLib(module->getModuleDecl()))
+        {
+            dstModule.irReuseDigests = module->getIRReuseDigests();
+        }
         outData.modules.add(dstModule);
     }
 
@@ -292,6 +323,8 @@ namespace Slang {
             // The header has:
             // 1) a digest of all compile options and dependent source files.
             // 2) a list of source file paths.
+            // 3) the size, modification time and digest of each source file. This part is optional,
+            //    and not present in modules written by older versions.
             //
             {
                 RiffContainer::ScopeChunk scopeHeader(container, RiffContainer::Chunk::Kind::Data, SerialBinary::kModuleHeaderFourCc);
@@ -303,6 +336,14 @@ namespace Slang {
                 uint32_t fileListLength = (uint32_t)filePathsSB.getLength();
                 headerMemStream.write(&fileListLength, sizeof(uint32_t));
                 headerMemStream.write(filePathsSB.getBuffer(), fileListLength);
+                uint32_t fileStateCount = (uint32_t)module.dependentFileStates.getCount();
+                headerMemStream.write(&fileStateCount, sizeof(uint32_t));
+                for (const auto& fileState : module.dependentFileStates)
+                {
+                    headerMemStream.write(&fileState.stat.size, sizeof(uint64_t));
+                    headerMemStream.write(&fileState.stat.modifiedTime, sizeof(uint64_t));
+                    headerMemStream.write(fileState.digest.data, sizeof(fileState.digest.data));
+                }
                 container->write(headerMemStream.getContents().getBuffer(), headerMemStream.getContents().getCount());
             }
 
@@ -346,6 +387,29 @@ namespace Slang {
                     SLANG_RETURN_ON_FAIL(writer.writeIntoContainer(ASTSerialBinary::kSlangASTModuleDataFourCC, container));
                 }
             }
+
+            // Write the digests used to reuse IR when the module is compiled again. This chunk comes
+            // last, so that older versions, which don't know it, skip over it.
+            //
+            // It holds the signature digest, then a count, then for each reusable function the length
+            // of its mangled name, the name, and the digest of its body.
+            if (module.irReuseDigests.isRecorded)
+            {
+                RiffContainer::ScopeChunk scopeDigests(container, RiffContainer::Chunk::Kind::Data, SerialBinary::kIRReuseDigestsFourCc);
+                OwnedMemoryStream digestsMemStream(FileAccess::Write);
+                const auto& digests = module.irReuseDigests;
+                digestsMemStream.write(digests.signatureDigest.data, sizeof(digests.signatureDigest.data));
+                uint32_t bodyCount = (uint32_t)digests.bodyDigests.getCount();
+                digestsMemStream.write(&bodyCount, sizeof(uint32_t));
+                for (const auto& [mangledName, bodyDigest] : digests.bodyDigests)
+                {
+                    uint32_t nameLength = (uint32_t)mangledName.getLength();
+                    digestsMemStream.write(&nameLength, sizeof(uint32_t));
+                    digestsMemStream.write(mangledName.getBuffer(), nameLength);
+                    digestsMemStream.write(bodyDigest.data, sizeof(bodyDigest.data));
+                }
+                container->write(digestsMemStream.getContents().getBuffer(), digestsMemStream.getContents().getCount());
+            }
         }
 
 	// TODO:
@@ -428,6 +492,41 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
     return entry->candidateExtensions;
 }
 
+static SlangResult _readIRReuseDigests(RiffContainer::DataChunk* chunk, IRReuseDigests& outDigests)
+{
+    MemoryStreamBase memStream(
+        FileAccess::Read,
+        chunk->getSingleData()->getPayload(),
+        chunk->getSingleData()->getSize());
+    size_t readSize = 0;
+    memStream.read(outDigests.signatureDigest.data, sizeof(outDigests.signatureDigest.data), readSize);
+    if (readSize != sizeof(outDigests.signatureDigest.data))
+        return SLANG_FAIL;
+    uint32_t bodyCount = 0;
+    memStream.read(&bodyCount, sizeof(uint32_t), readSize);
+    if (readSize != sizeof(uint32_t))
+        return SLANG_FAIL;
+    List<char> nameBuffer;
+    for (uint32_t i = 0; i < bodyCount; ++i)
+    {
+        uint32_t nameLength = 0;
+        memStream.read(&nameLength, sizeof(uint32_t), readSize);
+        if (readSize != sizeof(uint32_t))
+            return SLANG_FAIL;
+        nameBuffer.setCount(nameLength);
+        memStream.read(nameBuffer.getBuffer(), nameLength, readSize);
+        if (readSize != nameLength)
+            return SLANG_FAIL;
+        SHA1::Digest bodyDigest;
+        memStream.read(bodyDigest.data, sizeof(bodyDigest.data), readSize);
+        if (readSize != sizeof(bodyDigest.data))
+            return SLANG_FAIL;
+        outDigests.bodyDigests[String(UnownedStringSlice(nameBuffer.getBuffer(), nameLength))] = bodyDigest;
+    }
+    outDigests.isRecorded = true;
+    return SLANG_OK;
+}
+
 /* static */Result SerialContainerUtil::read(RiffContainer* container, const ReadOptions& options, const LoadedModuleDictionary* additionalLoadedModules, SerialContainerData& out)
 {
     out.clear();
@@ -528,6 +627,21 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         module.dependentFiles.add(file);
                     }
                 }
+                uint32_t fileStateCount = 0;
+                memStream.read(&fileStateCount, sizeof(uint32_t), readSize);
+                if (readSize == sizeof(uint32_t) && fileStateCount == uint32_t(module.dependentFiles.getCount()))
+                {
+                    module.dependentFileStates.setCount(fileStateCount);
+                    for (auto& fileState : module.dependentFileStates)
+                    {
+                        size_t sizeReadSize = 0, timeReadSize = 0, digestReadSize = 0;
+                        memStream.read(&fileState.stat.size, sizeof(uint64_t), sizeReadSize);
+                        memStream.read(&fileState.stat.modifiedTime, sizeof(uint64_t), timeReadSize);
+                        memStream.read(fileState.digest.data, sizeof(fileState.digest.data), digestReadSize);
+                        if (sizeReadSize + timeReadSize + digestReadSize != 2 * sizeof(uint64_t) + sizeof(fileState.digest.data))
+                            return SLANG_FAIL;
+                    }
+                }
                 // Onto next chunk
                 chunk = chunk->m_next;
             }
@@ -541,7 +655,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
                     // Read IR back from serialData
                     IRSerialReader reader;
-                    SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    if (options.deferIRFunctionBodies)
+                    {
+                        SLANG_RETURN_ON_FAIL(reader.readWithDeferredBodies(serialData, options.session, sourceLocReader, irModule));
+                    }
+                    else
+                    {
+                        SLANG_RETURN_ON_FAIL(reader.read(serialData, options.session, sourceLocReader, irModule));
+                    }
                 }
 
                 // Onto next chunk
@@ -550,7 +671,7 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
 
             if (auto astChunk = as<RiffContainer::ListChunk>(chunk, ASTSerialBinary::kSlangASTModuleFourCC))
             {
-                if (!options.readHeaderOnly)
+                if (!options.readHeaderOnly && !options.skipASTModules)
                 {
                     RiffContainer::Data* astData = astChunk->findContainedData(ASTSerialBinary::kSlangASTModuleDataFourCC);
 
@@ -770,6 +891,14 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                 chunk = chunk->m_next;
             }
 
+            if (auto digestsChunk = as<RiffContainer::DataChunk>(chunk, SerialBinary::kIRReuseDigestsFourCc))
+            {
+                SLANG_RETURN_ON_FAIL(_readIRReuseDigests(digestsChunk, module.irReuseDigests));
+
+                // Onto next chunk
+                chunk = chunk->m_next;
+            }
+
             if (astBuilder || irModule)
             {
                 module.astBuilder = astBuilder;
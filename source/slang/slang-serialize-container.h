@@ -3,9 +3,11 @@
 #define SLANG_SERIALIZE_CONTAINER_H
 
 #include "../core/slang-riff.h"
+#include "../core/slang-io.h"
 #include "slang-serialize-types.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
+#include "slang-compiler.h"
 
 namespace Slang {
 
@@ -37,6 +39,18 @@ struct SerialContainerDataModule
     NodeBase* astRootNode = nullptr;        ///< The module decl
     List<String> dependentFiles;
     SHA1::Digest digest;
+
+        /// The state of a dependent file when the module was compiled
+    struct DependentFileState
+    {
+        File::Stat stat;                    ///< modifiedTime is 0 if not known
+        SHA1::Digest digest;                ///< Digest of the file's contents
+    };
+        /// Either empty (for modules written by older versions), or the state of each file in dependentFiles
+    List<DependentFileState> dependentFileStates;
+
+        /// Digests used to reuse the IR of unchanged functions when the module is compiled again
+    IRReuseDigests irReuseDigests;
 };
 
 /* Struct that holds all the data that can be held in a 'container' */
@@ -97,6 +111,11 @@ struct SerialContainerUtil
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
+            /// If set, the bodies of IR functions are decoded when they are first used by the linker,
+            /// rather than when the module is read.
+        bool deferIRFunctionBodies = false;
+            /// If set, only the header and IR of each module are read.
+        bool skipASTModules = false;
         String modulePath;
     };
 
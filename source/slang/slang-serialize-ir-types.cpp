@@ -40,6 +40,8 @@ bother to check if it's correct, and just casts it.
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kInstFourCc) == 'S');
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kChildRunFourCc) == 'S');
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kExternalOperandsFourCc) == 'S');
+SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kDeferredBodyFourCc) == 'S');
+SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(IRSerialBinary::kDeferredBodyHashFourCc) == 'S');
 
 // Compressed version starts with 's'
 SLANG_COMPILE_TIME_ASSERT(SLANG_FOUR_CC_GET_FIRST_CHAR(SLANG_MAKE_COMPRESSED_FOUR_CC(IRSerialBinary::kInstFourCc)) == 's');
@@ -64,7 +66,9 @@ size_t IRSerialData::calcSizeInBytes() const
         /* Raw source locs */
         _calcArraySize(m_rawSourceLocs) +
         /* Debug */
-        _calcArraySize(m_debugSourceLocRuns);
+        _calcArraySize(m_debugSourceLocRuns) +
+        _calcArraySize(m_deferredBodies) +
+        _calcArraySize(m_deferredBodyHashes);
 }
 
 IRSerialData::IRSerialData()
@@ -85,6 +89,9 @@ void IRSerialData::clear()
     m_stringTable.clear();
     
     m_debugSourceLocRuns.clear();
+
+    m_deferredBodies.clear();
+    m_deferredBodyHashes.clear();
 }
 
 bool IRSerialData::operator==(const ThisType& rhs) const
@@ -96,7 +103,9 @@ bool IRSerialData::operator==(const ThisType& rhs) const
         SerialListUtil::isEqual(m_rawSourceLocs, rhs.m_rawSourceLocs) &&
         SerialListUtil::isEqual(m_stringTable, rhs.m_stringTable) &&
         /* Debug */
-        SerialListUtil::isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns));
+        SerialListUtil::isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns) &&
+        SerialListUtil::isEqual(m_deferredBodies, rhs.m_deferredBodies) &&
+        SerialListUtil::isEqual(m_deferredBodyHashes, rhs.m_deferredBodyHashes));
 }
 
 } // namespace Slang
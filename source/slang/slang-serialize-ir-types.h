@@ -30,6 +30,10 @@ struct IRSerialBinary
     static const FourCC kInstFourCc = SLANG_FOUR_CC('S', 'L', 'i', 'n');
     static const FourCC kChildRunFourCc = SLANG_FOUR_CC('S', 'L', 'c', 'r');
     static const FourCC kExternalOperandsFourCc = SLANG_FOUR_CC('S', 'L', 'e', 'o');
+        /// Table of the global values whose bodies can be decoded on demand
+    static const FourCC kDeferredBodyFourCc = SLANG_FOUR_CC('S', 'L', 'd', 'b');
+        /// Content hash of each entry of the deferred body table
+    static const FourCC kDeferredBodyHashFourCc = SLANG_FOUR_CC('S', 'L', 'd', 'h');
 
     static const FourCC kCompressedInstFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kInstFourCc);
     static const FourCC kCompressedChildRunFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kChildRunFourCc);
@@ -84,6 +88,32 @@ struct IRSerialData
         SizeType m_numInst;                 ///< The number of children
     };
 
+        /// The body of a global function or generic, which can be decoded independently
+        /// of the rest of the module.
+        ///
+        /// The body is all of the instructions below the global value other than its
+        /// decorations. These are always contiguous, because the writer emits each global
+        /// value's subtree before moving on to the next. Only the instructions of the body
+        /// itself refer to instructions in the body.
+    struct DeferredBody
+    {
+        typedef DeferredBody ThisType;
+        SLANG_FORCE_INLINE bool operator==(const ThisType& rhs) const
+        {
+            return m_globalIndex == rhs.m_globalIndex &&
+                m_startInstIndex == rhs.m_startInstIndex &&
+                m_numInsts == rhs.m_numInsts;
+        }
+        SLANG_FORCE_INLINE bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        InstIndex m_globalIndex;            ///< The global value the body belongs to
+        InstIndex m_startInstIndex;         ///< The first instruction of the body (its first child that isn't a decoration)
+        SizeType m_numInsts;                ///< The number of instructions in the body, including all descendants
+    };
+
+    typedef uint64_t ContentHash;
+    static const ContentHash kNoContentHash = 0;
+
     struct PayloadInfo
     {
         uint8_t m_numOperands;
@@ -190,6 +220,12 @@ struct IRSerialData
 
     List<SourceLocRun> m_debugSourceLocRuns;    ///< Runs of instructions that use a source loc
 
+    List<DeferredBody> m_deferredBodies;        ///< Bodies that a reader can choose to decode on demand
+        /// For each of m_deferredBodies, a hash of the global value's decorations and body that doesn't depend on
+        /// the module it is in, or kNoContentHash if it couldn't be computed. Global values with the same mangled
+        /// name and content hash are interchangeable. May be empty.
+    List<ContentHash> m_deferredBodyHashes;
+
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
 
@@ -98,6 +98,291 @@ Result IRSerialWriter::_calcDebugInfo(SerialSourceLocWriter* sourceLocWriter)
     return SLANG_OK;
 }
 
+namespace { // anonymous
+
+// Computes a hash of a global value's decorations and body that doesn't depend on the module
+// it is in, so that identical definitions in different modules have the same hash.
+//
+// Instructions within the global value are hashed by their position in it. Instructions outside
+// of it are hashed by their mangled name if they have linkage, and otherwise by their structure.
+// If an outside instruction can't be identified that way (it has children, or is part of a
+// cycle) no hash is produced.
+struct IRContentHasher
+{
+    typedef IRSerialData::ContentHash ContentHash;
+
+    ContentHash calcHash(IRInst* globalValue)
+    {
+        m_localIndices.clear();
+        List<IRInst*> localInsts;
+        _addLocalInstsRec(globalValue, localInsts);
+
+        m_isHashable = true;
+        ContentHash hash = _hashInst(globalValue);
+        for (auto inst : localInsts)
+        {
+            hash = combineHash(hash, _hashInst(inst));
+        }
+        if (!m_isHashable)
+        {
+            return IRSerialData::kNoContentHash;
+        }
+        return hash == IRSerialData::kNoContentHash ? ContentHash(1) : hash;
+    }
+
+protected:
+    void _addLocalInstsRec(IRInst* inst, List<IRInst*>& outInsts)
+    {
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            m_localIndices.add(child, m_localIndices.getCount());
+            outInsts.add(child);
+            _addLocalInstsRec(child, outInsts);
+        }
+    }
+
+        /// Hash the parts of `inst` that aren't its children
+    ContentHash _hashInst(IRInst* inst)
+    {
+        ContentHash hash = combineHash(getHashCode(int(inst->getOp())), _hashRef(inst->getFullType()));
+        if (auto constant = as<IRConstant>(inst))
+        {
+            hash = combineHash(hash, _hashConstantValue(constant));
+        }
+        const UInt operandCount = inst->getOperandCount();
+        hash = combineHash(hash, getHashCode(operandCount));
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            hash = combineHash(hash, _hashRef(inst->getOperand(i)));
+        }
+        Index childCount = 0;
+        for ([[maybe_unused]] auto child : inst->getDecorationsAndChildren())
+        {
+            childCount++;
+        }
+        return combineHash(hash, getHashCode(childCount));
+    }
+
+    static ContentHash _hashConstantValue(IRConstant* constant)
+    {
+        switch (constant->getOp())
+        {
+            case kIROp_BoolLit:
+            case kIROp_FloatLit:
+            case kIROp_IntLit:
+                return getHashCode(constant->value.intVal);
+            case kIROp_BlobLit:
+            case kIROp_StringLit:
+            {
+                const UnownedStringSlice slice = constant->getStringSlice();
+                return getHashCode(slice.begin(), slice.getLength());
+            }
+            default:
+                return 0;
+        }
+    }
+
+        /// Hash a reference to `inst` from within the global value being hashed
+    ContentHash _hashRef(IRInst* inst)
+    {
+        if (!inst)
+        {
+            return 0;
+        }
+        if (auto localIndex = m_localIndices.tryGetValue(inst))
+        {
+            return combineHash(ContentHash(1), getHashCode(*localIndex));
+        }
+        if (auto hash = m_globalHashes.tryGetValue(inst))
+        {
+            return *hash;
+        }
+        if (m_unhashableInsts.contains(inst))
+        {
+            m_isHashable = false;
+            return 0;
+        }
+
+        ContentHash hash;
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            const auto mangledName = linkage->getMangledName();
+            hash = combineHash(ContentHash(2), getHashCode(mangledName.begin(), mangledName.getLength()));
+        }
+        else if (inst->getFirstDecorationOrChild() || m_inProgress.contains(inst) || as<IRModuleInst>(inst))
+        {
+            m_isHashable = false;
+            return 0;
+        }
+        else
+        {
+            const bool wasHashable = m_isHashable;
+            m_isHashable = true;
+
+            m_inProgress.add(inst);
+            hash = combineHash(ContentHash(3), _hashInst(inst));
+            m_inProgress.remove(inst);
+
+            if (!m_isHashable)
+            {
+                m_unhashableInsts.add(inst);
+                return 0;
+            }
+            m_isHashable = wasHashable;
+        }
+        m_globalHashes.add(inst, hash);
+        return hash;
+    }
+
+    Dictionary<IRInst*, Index> m_localIndices;          ///< Instructions within the global value being hashed
+    Dictionary<IRInst*, ContentHash> m_globalHashes;    ///< Hashes of instructions outside of it
+    HashSet<IRInst*> m_unhashableInsts;                 ///< Instructions outside of it that can't be identified
+    HashSet<IRInst*> m_inProgress;
+    bool m_isHashable = true;
+};
+
+} // anonymous
+
+void IRSerialWriter::_calcDeferredBodies(IRModuleInst* moduleInst)
+{
+    // Find the global functions and generics whose bodies a reader could decode on demand.
+    //
+    // The traversal in `write` adds all of the children of an instruction as a run, and then
+    // completes the subtree of each child before moving on to its previous sibling. So all of
+    // the instructions below a global value form a contiguous range, starting with its children.
+    // Decorations come before other children, so as long as the decorations have no children
+    // themselves, everything after them in the range is the body.
+
+    const Index numInsts = m_insts.getCount();
+
+    List<Ser::DeferredBody> bodies;
+
+    // For each instruction, the index of the body it belongs to, or -1.
+    List<Index> bodyForInst;
+    bodyForInst.setCount(numInsts);
+    for (auto& body : bodyForInst)
+    {
+        body = -1;
+    }
+
+    List<IRInst*> workList;
+    for (auto globalInst : moduleInst->getChildren())
+    {
+        switch (globalInst->getOp())
+        {
+            case kIROp_Func:
+            case kIROp_Generic:
+                break;
+            default:
+                continue;
+        }
+
+        IRInst* firstBodyInst = nullptr;
+        bool isDeferrable = true;
+        for (auto child : globalInst->getDecorationsAndChildren())
+        {
+            if (as<IRDecoration>(child))
+            {
+                isDeferrable = isDeferrable && firstBodyInst == nullptr && child->getFirstDecorationOrChild() == nullptr;
+            }
+            else if (!firstBodyInst)
+            {
+                firstBodyInst = child;
+            }
+        }
+        if (!isDeferrable || !firstBodyInst)
+        {
+            continue;
+        }
+
+        // Count the instructions in the body
+        Index numBodyInsts = 0;
+        workList.clear();
+        for (IRInst* child = firstBodyInst; child; child = child->getNextInst())
+        {
+            workList.add(child);
+        }
+        while (workList.getCount())
+        {
+            IRInst* inst = workList.getLast();
+            workList.removeLast();
+            numBodyInsts++;
+            for (auto child : inst->getDecorationsAndChildren())
+            {
+                workList.add(child);
+            }
+        }
+
+        Ser::DeferredBody body;
+        body.m_globalIndex = getInstIndex(globalInst);
+        body.m_startInstIndex = getInstIndex(firstBodyInst);
+        body.m_numInsts = Ser::SizeType(numBodyInsts);
+
+        const Index bodyIndex = bodies.getCount();
+        bodies.add(body);
+
+        const Index startInstIndex = Index(body.m_startInstIndex);
+        SLANG_ASSERT(startInstIndex + numBodyInsts <= numInsts);
+        for (Index i = 0; i < numBodyInsts; ++i)
+        {
+            bodyForInst[startInstIndex + i] = bodyIndex;
+        }
+    }
+
+    // A body can only be decoded on its own if nothing outside of it refers to an instruction
+    // within it. Instructions in a body that can't be deferred become part of the rest of the
+    // module, so we repeat until no more bodies are ruled out.
+    List<bool> isBodyDeferred;
+    isBodyDeferred.setCount(bodies.getCount());
+    for (auto& isDeferred : isBodyDeferred)
+    {
+        isDeferred = true;
+    }
+
+    bool hasChanged = true;
+    while (hasChanged)
+    {
+        hasChanged = false;
+
+        for (Index i = 1; i < numInsts; ++i)
+        {
+            const Ser::Inst& inst = m_serialData->m_insts[i];
+            const Index instBody = bodyForInst[i];
+
+            const Ser::InstIndex* operands;
+            const int numOperands = m_serialData->getOperands(inst, &operands);
+
+            for (int j = -1; j < numOperands; ++j)
+            {
+                const Index refIndex = Index(j < 0 ? inst.m_resultTypeIndex : operands[j]);
+                const Index refBody = bodyForInst[refIndex];
+                if (refBody < 0 || refBody == instBody)
+                {
+                    continue;
+                }
+
+                const auto& body = bodies[refBody];
+                for (Index k = 0; k < Index(body.m_numInsts); ++k)
+                {
+                    bodyForInst[Index(body.m_startInstIndex) + k] = -1;
+                }
+                isBodyDeferred[refBody] = false;
+                hasChanged = true;
+            }
+        }
+    }
+
+    IRContentHasher contentHasher;
+    for (Index i = 0; i < bodies.getCount(); ++i)
+    {
+        if (isBodyDeferred[i])
+        {
+            m_serialData->m_deferredBodies.add(bodies[i]);
+            m_serialData->m_deferredBodyHashes.add(contentHasher.calcHash(m_insts[Index(bodies[i].m_globalIndex)]));
+        }
+    }
+}
+
 Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocWriter, SerialOptionFlags options, IRSerialData* serialData)
 {
     typedef Ser::Inst::PayloadType PayloadType;
@@ -284,6 +569,8 @@ Result IRSerialWriter::write(IRModule* module, SerialSourceLocWriter* sourceLocW
         }
     }
 
+    _calcDeferredBodies(moduleInst);
+
     // Convert strings into a string table
     {
         SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
@@ -460,6 +747,15 @@ Result _writeInstArrayChunk(SerialCompressionType compressionType, FourCC chunkI
         SerialRiffUtil::writeArrayChunk(compressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, container);
     }
 
+    if (data.m_deferredBodies.getCount())
+    {
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayChunk(compressionType, Bin::kDeferredBodyFourCc, data.m_deferredBodies, container));
+    }
+    if (data.m_deferredBodyHashes.getCount())
+    {
+        SLANG_RETURN_ON_FAIL(SerialRiffUtil::writeArrayUncompressedChunk(Bin::kDeferredBodyHashFourCc, data.m_deferredBodyHashes, container));
+    }
+
     return SLANG_OK;
 }
 
@@ -656,6 +952,17 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
                 SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_debugSourceLocRuns));
                 break;
             }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDeferredBodyFourCc):
+            case Bin::kDeferredBodyFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayChunk(containerCompressionType, dataChunk, outData->m_deferredBodies));
+                break;
+            }
+            case Bin::kDeferredBodyHashFourCc:
+            {
+                SLANG_RETURN_ON_FAIL(SerialRiffUtil::readArrayUncompressedChunk(dataChunk, outData->m_deferredBodyHashes));
+                break;
+            }
             default:
             {
                 break;
@@ -666,83 +973,86 @@ static Result _readInstArrayChunk(SerialCompressionType containerCompressionType
     return SLANG_OK;
 }
 
-Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
-{
-    // Only used in debug builds
-    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
-
-    m_serialData = &data;
+namespace { // anonymous
 
-    auto module = IRModule::create(session);
-    outModule = module;
+// Decodes ranges of the instructions in IRSerialData into an IRModule.
+//
+// Reading a whole module decodes every instruction up front, but the bodies of global values
+// listed in `IRSerialData::m_deferredBodies` can also be decoded later, on their own.
+struct IRSerialInstDecoder
+{
+    typedef IRSerialData Ser;
+
+        /// Allocate the instructions in [start, end)
+    Result allocateInsts(Index start, Index end);
+        /// Set the types and operands of the instructions in [start, end). All of the instructions
+        /// they refer to must have been allocated.
+    void initTypesAndOperands(Index start, Index end);
+        /// Add the children [startChild, endChild) of the run to its parent
+    void addChildren(const Ser::InstRun& run, Index startChild, Index endChild);
+        /// Set the source locations of the instructions in [start, end)
+    void applySourceLocs(Index start, Index end);
+
+        /// Set up for decoding `data` into `module`
+    void init(const IRSerialData* data, const StringSlicePool* stringTable, SerialSourceLocReader* sourceLocReader, IRModule* module);
+
+    const IRSerialData* m_data = nullptr;
+    const StringSlicePool* m_stringTable = nullptr;
+    SerialSourceLocReader* m_sourceLocReader = nullptr;
+    IRModule* m_module = nullptr;
+
+        /// The instruction for each instruction index, or nullptr if not decoded yet
+    List<IRInst*> m_insts;
+
+        /// The debug source loc runs in source location order. Created on first use.
+    List<Ser::SourceLocRun> m_sortedSourceLocRuns;
+};
+
+void IRSerialInstDecoder::init(const IRSerialData* data, const StringSlicePool* stringTable, SerialSourceLocReader* sourceLocReader, IRModule* module)
+{
+    m_data = data;
+    m_stringTable = stringTable;
+    m_sourceLocReader = sourceLocReader;
     m_module = module;
 
-    // Convert m_stringTable into StringSlicePool.
-    SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_stringTable);
-
-    // Each IR instruction has:
-    //
-    // * An opcode
-    // * Zero or more operands
-    // * Zero or more children
-    //
-    // Most instructions are entirely defined by those properties.
-    // 
-    // The instructions that represent simple constants (integers, strings, etc.) are
-    // unique in that they have "payload" data that holds their value, instead of having
-    // any operands.
-    //
-    // The deserialization logic here is set up to handle an arbitrary configuration
-    // of IR instructions, which means it can handle cases where:
-    //
-    // * An instruction earlier in the serialized stream might refer to an instruction
-    //   later in the stream, as one of its operands or (transitive) children.
-    //
-    // * An instruction in the stream transitively depends on itself via operand
-    //   and/or child relationships.
-    //
-    // In order to handle these cases, deserialization proceeds in multiple passes.
-    // In the first pass, `IRInst`s are allocated for each instruction in the stream,
-    // based on their memory requirements (number of operands in the ordinary case
-    // and payload size in the case of simple constants). Subsequent passes then
-    // fill in the operands and/or children.
-    //
-    // Note that as a result of the strategy used here, it is not possible for the
-    // deserialization logic to interact with any systems for deduplication or
-    // simplification of instructions. An alternative version of the deserializer that
-    // uses the `IRBuilder` interface instead might be possible, but would need a
-    // plan for how to handle forward and/or circular references in the IR module.
-
-    // Add all the instructions
-    List<IRInst*> insts;
+    // Only used in debug builds
+    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
 
-    const Index numInsts = data.m_insts.getCount();
+    const Index numInsts = data->m_insts.getCount();
 
-    SLANG_ASSERT(numInsts > 0);
+    SLANG_ASSERT(numInsts > 1);
 
-    insts.setCount(numInsts);
-    insts[0] = nullptr;
+    m_insts.setCount(numInsts);
+    for (auto& inst : m_insts)
+    {
+        inst = nullptr;
+    }
 
     // 0 holds null
     // 1 holds the IRModuleInst
     {
         // Check that insts[1] is the module inst
-        const Ser::Inst& srcInst = data.m_insts[1];
+        const Ser::Inst& srcInst = data->m_insts[1];
         SLANG_RELEASE_ASSERT(srcInst.m_op == kIROp_Module);
         SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
 
         // The root IR instruction for the module will already have
-        // been created as part of creating `module` above.
+        // been created as part of creating `module`.
         //
-        auto moduleInst = module->getModuleInst();
-
-        // Set the IRModuleInst
-        insts[1] = moduleInst; 
+        m_insts[1] = module->getModuleInst();
     }
+}
+
+Result IRSerialInstDecoder::allocateInsts(Index start, Index end)
+{
+    // Only used in debug builds
+    [[maybe_unused]] typedef Ser::Inst::PayloadType PayloadType;
 
-    for (Index i = 2; i < numInsts; ++i)
+    IRModule* module = m_module;
+
+    for (Index i = start; i < end; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
+        const Ser::Inst& srcInst = m_data->m_insts[i];
 
         const IROp op((IROp)srcInst.m_op);
 
@@ -803,7 +1113,7 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
                 {
                     SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
 
-                    const UnownedStringSlice slice = m_stringTable.getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
+                    const UnownedStringSlice slice = m_stringTable->getSlice(StringSlicePool::Handle(srcInst.m_payload.m_stringIndices[0]));
                         
                     const size_t sliceSize = slice.getLength();
                     const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
@@ -826,28 +1136,31 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
                 }
             }
 
-            insts[i] = irConst;
+            m_insts[i] = irConst;
         }
         else
         {
             int numOperands = srcInst.getNumOperands();
-            insts[i] = module->_allocateInst(op, numOperands);
+            m_insts[i] = module->_allocateInst(op, numOperands);
         }
     }
 
-    // Patch up the operands
-    for (Index i = 1; i < numInsts; ++i)
+    return SLANG_OK;
+}
+
+void IRSerialInstDecoder::initTypesAndOperands(Index start, Index end)
+{
+    for (Index i = start; i < end; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-        const IROp op((IROp)srcInst.m_op);
-        SLANG_UNUSED(op);
+        const Ser::Inst& srcInst = m_data->m_insts[i];
 
-        IRInst* dstInst = insts[i];
+        IRInst* dstInst = m_insts[i];
 
         // Set the result type
         if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
         {
-            IRInst* resultInst = insts[int(srcInst.m_resultTypeIndex)];
+            IRInst* resultInst = m_insts[int(srcInst.m_resultTypeIndex)];
+            SLANG_ASSERT(resultInst);
             // NOTE! Counter intuitively the IRType* paramter may not be IRType* derived for example 
             // IRGlobalGenericParam is valid, but isn't IRType* derived
 
@@ -855,65 +1168,70 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
             dstInst->setFullType(static_cast<IRType*>(resultInst));
         }
        
-        //if (!isParentDerived(op))
         {
             const Ser::InstIndex* srcOperandIndices;
-            const int numOperands = data.getOperands(srcInst, &srcOperandIndices);
+            const int numOperands = m_data->getOperands(srcInst, &srcOperandIndices);
 
             auto dstOperands = dstInst->getOperands();
 
             for (int j = 0; j < numOperands; j++)
             {
-                dstOperands[j].init(dstInst, insts[int(srcOperandIndices[j])]);
+                SLANG_ASSERT(srcOperandIndices[j] == Ser::InstIndex(0) || m_insts[int(srcOperandIndices[j])]);
+                dstOperands[j].init(dstInst, m_insts[int(srcOperandIndices[j])]);
             }
         }
     }
-    
-    // Patch up the children
-    {
-        const Index numChildRuns = data.m_childRuns.getCount();
-        for (Index i = 0; i < numChildRuns; i++)
-        {
-            const auto& run = data.m_childRuns[i];
+}
 
-            IRInst* inst = insts[int(run.m_parentIndex)];
+void IRSerialInstDecoder::addChildren(const Ser::InstRun& run, Index startChild, Index endChild)
+{
+    IRInst* inst = m_insts[int(run.m_parentIndex)];
 
-            for (int j = 0; j < int(run.m_numChildren); ++j)
-            {
-                IRInst* child = insts[j + int(run.m_startInstIndex)];
-                SLANG_ASSERT(child->parent == nullptr);
-                child->insertAtEnd(inst);
-            }
-        }
+    for (Index j = startChild; j < endChild; ++j)
+    {
+        IRInst* child = m_insts[j + int(run.m_startInstIndex)];
+        SLANG_ASSERT(child->parent == nullptr);
+        child->insertAtEnd(inst);
     }
+}
 
+void IRSerialInstDecoder::applySourceLocs(Index start, Index end)
+{
     // Re-add source locations, if they are defined
-    if (m_serialData->m_rawSourceLocs.getCount() == numInsts)
+    if (m_data->m_rawSourceLocs.getCount() == m_insts.getCount())
     {
-        const Ser::RawSourceLoc* srcLocs = m_serialData->m_rawSourceLocs.begin();
-        for (Index i = 1; i < numInsts; ++i)
+        const Ser::RawSourceLoc* srcLocs = m_data->m_rawSourceLocs.begin();
+        for (Index i = start; i < end; ++i)
         {
-            IRInst* dstInst = insts[i];
+            IRInst* dstInst = m_insts[i];
             
             dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
         }
     }
 
     // We now need to apply the runs
-    if (sourceLocReader && m_serialData->m_debugSourceLocRuns.getCount())
+    if (m_sourceLocReader && m_data->m_debugSourceLocRuns.getCount())
     {
-        List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-        // They are now in source location order
-        sourceRuns.sort();
+        if (m_sortedSourceLocRuns.getCount() == 0)
+        {
+            m_sortedSourceLocRuns = m_data->m_debugSourceLocRuns;
+            // They are now in source location order
+            m_sortedSourceLocRuns.sort();
+        }
 
         // Just guess initially 0 for the source file that contains the initial run
         SerialSourceLocData::SourceRange range = SerialSourceLocData::SourceRange::getInvalid();
         int fix = 0;
         
-        const Index numRuns = sourceRuns.getCount();
-        for (Index i = 0; i < numRuns; ++i)
+        for (const auto& run : m_sortedSourceLocRuns)
         {
-            const auto& run = sourceRuns[i];
+            // Only the part of the run within [start, end) is written
+            const Index runStart = Math::Max(Index(run.m_startInstIndex), start);
+            const Index runEnd = Math::Min(Index(run.m_startInstIndex) + Index(run.m_numInst), end);
+            if (runStart >= runEnd)
+            {
+                continue;
+            }
 
             // Work out the fixed source location
             SourceLoc sourceLoc;
@@ -921,23 +1239,322 @@ Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSo
             {
                 if (!range.contains(run.m_sourceLoc))
                 {
-                    fix = sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
+                    fix = m_sourceLocReader->calcFixSourceLoc(run.m_sourceLoc, range);
                 }
-                sourceLoc = sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
+                sourceLoc = m_sourceLocReader->calcFixedLoc(run.m_sourceLoc, fix, range);
             }
 
             // Write to all the instructions
-            SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-            IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
-
-            const int runSize = int(run.m_numInst);
-            for (int j = 0; j < runSize; ++j)
+            SLANG_ASSERT(runEnd <= m_insts.getCount());
+            for (Index j = runStart; j < runEnd; ++j)
             {
-                dstInsts[j]->sourceLoc = sourceLoc;
+                m_insts[j]->sourceLoc = sourceLoc;
             }
         }
     }
+}
+
+// Holds on to the serialized data of a module, so that the bodies of its global values can be
+// decoded the first time they are needed (typically when the linker clones them).
+class IRSerialDeferredBodyLoader : public IRDeferredBodyLoader
+{
+public:
+    typedef IRSerialData Ser;
+
+    virtual void materializeBody(IRInst* globalValue) SLANG_OVERRIDE;
+    virtual void materializeAllBodies() SLANG_OVERRIDE;
+    virtual bool hasDeferredBodies() SLANG_OVERRIDE { return m_pendingBodies.getCount() != 0; }
+    virtual bool findBodyContentHash(IRInst* globalValue, uint64_t& outHash) SLANG_OVERRIDE;
+
+    IRSerialDeferredBodyLoader():
+        m_stringTable(StringSlicePool::Style::Default)
+    {
+    }
+
+        /// Decode everything but the deferred bodies of `m_data` into a new module
+    Result init(Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
+
+    IRSerialData m_data;
+
+protected:
+        /// Get the index of the body that holds the instruction at `instIndex`, or -1.
+    Index _findBody(Index instIndex) const;
+    void _materializeBody(Index bodyIndex);
+
+    StringSlicePool m_stringTable;
+    RefPtr<SerialSourceLocReader> m_sourceLocReader;
+
+        /// Deferred bodies, in the order of their instructions
+    List<Ser::DeferredBody> m_bodies;
+        /// The content hash of each of m_bodies
+    List<Ser::ContentHash> m_bodyHashes;
+        /// For each body, the runs of children that are (at least in part) within it
+    List<List<Index>> m_childRunsForBody;
+        /// Map from a global value to its body, for bodies that haven't been decoded yet
+    Dictionary<IRInst*, Index> m_pendingBodies;
+
+    IRSerialInstDecoder m_decoder;
+};
+
+Result IRSerialDeferredBodyLoader::init(Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    auto module = IRModule::create(session);
+    outModule = module;
+
+    SerialStringTableUtil::decodeStringTable(m_data.m_stringTable.getBuffer(), m_data.m_stringTable.getCount(), m_stringTable);
+
+    m_sourceLocReader = sourceLocReader;
+    m_decoder.init(&m_data, &m_stringTable, sourceLocReader, module);
+
+    {
+        const auto& bodies = m_data.m_deferredBodies;
+        const auto& bodyHashes = m_data.m_deferredBodyHashes;
+        const bool hasHashes = bodyHashes.getCount() == bodies.getCount();
+
+        List<Index> order;
+        for (Index i = 0; i < bodies.getCount(); ++i)
+        {
+            order.add(i);
+        }
+        order.sort([&](Index a, Index b) { return bodies[a].m_startInstIndex < bodies[b].m_startInstIndex; });
+
+        for (Index i : order)
+        {
+            m_bodies.add(bodies[i]);
+            m_bodyHashes.add(hasHashes ? bodyHashes[i] : Ser::kNoContentHash);
+        }
+    }
+
+    const Index numInsts = m_data.m_insts.getCount();
+
+    // Decode all of the instructions outside of the bodies
+    {
+        Index start = 2;
+        for (const auto& body : m_bodies)
+        {
+            SLANG_RETURN_ON_FAIL(m_decoder.allocateInsts(start, Index(body.m_startInstIndex)));
+            start = Index(body.m_startInstIndex) + Index(body.m_numInsts);
+        }
+        SLANG_RETURN_ON_FAIL(m_decoder.allocateInsts(start, numInsts));
+    }
+    {
+        Index start = 1;
+        for (const auto& body : m_bodies)
+        {
+            m_decoder.initTypesAndOperands(start, Index(body.m_startInstIndex));
+            m_decoder.applySourceLocs(start, Index(body.m_startInstIndex));
+            start = Index(body.m_startInstIndex) + Index(body.m_numInsts);
+        }
+        m_decoder.initTypesAndOperands(start, numInsts);
+        m_decoder.applySourceLocs(start, numInsts);
+    }
+
+    // Add children outside of the bodies. The run of children of a global value with a deferred
+    // body holds its decorations followed by the start of the body.
+    m_childRunsForBody.setCount(m_bodies.getCount());
+
+    const Index numChildRuns = m_data.m_childRuns.getCount();
+    for (Index i = 0; i < numChildRuns; i++)
+    {
+        const auto& run = m_data.m_childRuns[i];
+
+        const Index parentBodyIndex = _findBody(Index(run.m_parentIndex));
+        if (parentBodyIndex >= 0)
+        {
+            m_childRunsForBody[parentBodyIndex].add(i);
+            continue;
+        }
+
+        const Index lastChildIndex = Index(run.m_startInstIndex) + Index(run.m_numChildren) - 1;
+        const Index childBodyIndex = _findBody(lastChildIndex);
+        if (childBodyIndex >= 0)
+        {
+            const auto& body = m_bodies[childBodyIndex];
+            SLANG_ASSERT(body.m_globalIndex == run.m_parentIndex);
+
+            m_decoder.addChildren(run, 0, Index(body.m_startInstIndex) - Index(run.m_startInstIndex));
+            m_childRunsForBody[childBodyIndex].add(i);
+        }
+        else
+        {
+            m_decoder.addChildren(run, 0, Index(run.m_numChildren));
+        }
+    }
+
+    for (Index i = 0; i < m_bodies.getCount(); ++i)
+    {
+        m_pendingBodies.add(m_decoder.m_insts[Index(m_bodies[i].m_globalIndex)], i);
+    }
+
+    return SLANG_OK;
+}
+
+Index IRSerialDeferredBodyLoader::_findBody(Index instIndex) const
+{
+    // Find the last body that starts at or before instIndex
+    Index lo = 0;
+    Index hi = m_bodies.getCount();
+    while (lo < hi)
+    {
+        const Index mid = (lo + hi) / 2;
+        if (Index(m_bodies[mid].m_startInstIndex) <= instIndex)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0)
+    {
+        return -1;
+    }
+    const auto& body = m_bodies[lo - 1];
+    return (instIndex < Index(body.m_startInstIndex) + Index(body.m_numInsts)) ? lo - 1 : -1;
+}
+
+void IRSerialDeferredBodyLoader::_materializeBody(Index bodyIndex)
+{
+    const auto& body = m_bodies[bodyIndex];
+    const Index start = Index(body.m_startInstIndex);
+    const Index end = start + Index(body.m_numInsts);
+
+    // The writer only defers bodies that can be decoded, so this can only fail on corrupt data
+    // (which would have failed to read all at once as well).
+    [[maybe_unused]] const Result res = m_decoder.allocateInsts(start, end);
+    SLANG_ASSERT(SLANG_SUCCEEDED(res));
+
+    m_decoder.initTypesAndOperands(start, end);
+
+    for (Index runIndex : m_childRunsForBody[bodyIndex])
+    {
+        const auto& run = m_data.m_childRuns[runIndex];
+        const Index startChild = (run.m_parentIndex == body.m_globalIndex) ? start - Index(run.m_startInstIndex) : 0;
+        m_decoder.addChildren(run, startChild, Index(run.m_numChildren));
+    }
+
+    m_decoder.applySourceLocs(start, end);
+}
+
+void IRSerialDeferredBodyLoader::materializeBody(IRInst* globalValue)
+{
+    Index bodyIndex;
+    if (m_pendingBodies.tryGetValue(globalValue, bodyIndex))
+    {
+        m_pendingBodies.remove(globalValue);
+        _materializeBody(bodyIndex);
+    }
+}
+
+bool IRSerialDeferredBodyLoader::findBodyContentHash(IRInst* globalValue, uint64_t& outHash)
+{
+    Index bodyIndex;
+    if (!m_pendingBodies.tryGetValue(globalValue, bodyIndex) || m_bodyHashes[bodyIndex] == Ser::kNoContentHash)
+    {
+        return false;
+    }
+    outHash = m_bodyHashes[bodyIndex];
+    return true;
+}
+
+void IRSerialDeferredBodyLoader::materializeAllBodies()
+{
+    for (Index i = 0; i < m_bodies.getCount(); ++i)
+    {
+        IRInst* globalValue = m_decoder.m_insts[Index(m_bodies[i].m_globalIndex)];
+        if (m_pendingBodies.containsKey(globalValue))
+        {
+            _materializeBody(i);
+        }
+    }
+    m_pendingBodies.clear();
+}
+
+} // anonymous
+
+Result IRSerialReader::read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    m_serialData = &data;
+
+    auto module = IRModule::create(session);
+    outModule = module;
+    m_module = module;
+
+    // Convert m_stringTable into StringSlicePool.
+    SerialStringTableUtil::decodeStringTable(data.m_stringTable.getBuffer(), data.m_stringTable.getCount(), m_stringTable);
+
+    // Each IR instruction has:
+    //
+    // * An opcode
+    // * Zero or more operands
+    // * Zero or more children
+    //
+    // Most instructions are entirely defined by those properties.
+    // 
+    // The instructions that represent simple constants (integers, strings, etc.) are
+    // unique in that they have "payload" data that holds their value, instead of having
+    // any operands.
+    //
+    // The deserialization logic here is set up to handle an arbitrary configuration
+    // of IR instructions, which means it can handle cases where:
+    //
+    // * An instruction earlier in the serialized stream might refer to an instruction
+    //   later in the stream, as one of its operands or (transitive) children.
+    //
+    // * An instruction in the stream transitively depends on itself via operand
+    //   and/or child relationships.
+    //
+    // In order to handle these cases, deserialization proceeds in multiple passes.
+    // In the first pass, `IRInst`s are allocated for each instruction in the stream,
+    // based on their memory requirements (number of operands in the ordinary case
+    // and payload size in the case of simple constants). Subsequent passes then
+    // fill in the operands and/or children.
+    //
+    // Note that as a result of the strategy used here, it is not possible for the
+    // deserialization logic to interact with any systems for deduplication or
+    // simplification of instructions. An alternative version of the deserializer that
+    // uses the `IRBuilder` interface instead might be possible, but would need a
+    // plan for how to handle forward and/or circular references in the IR module.
+
+    IRSerialInstDecoder decoder;
+    decoder.init(&data, &m_stringTable, sourceLocReader, module);
+
+    const Index numInsts = data.m_insts.getCount();
+
+    // Add all the instructions
+    SLANG_RETURN_ON_FAIL(decoder.allocateInsts(2, numInsts));
+
+    // Patch up the operands
+    decoder.initTypesAndOperands(1, numInsts);
+
+    // Patch up the children
+    for (const auto& run : data.m_childRuns)
+    {
+        decoder.addChildren(run, 0, Index(run.m_numChildren));
+    }
+
+    decoder.applySourceLocs(1, numInsts);
+
+    return SLANG_OK;
+}
+
+Result IRSerialReader::readWithDeferredBodies(IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule)
+{
+    if (data.m_deferredBodies.getCount() == 0)
+    {
+        return read(data, session, sourceLocReader, outModule);
+    }
+
+    // The loader keeps the serialized data, for decoding bodies later.
+    RefPtr<IRSerialDeferredBodyLoader> loader = new IRSerialDeferredBodyLoader;
+    loader->m_data = _Move(data);
+    data.clear();
+
+    SLANG_RETURN_ON_FAIL(loader->init(session, sourceLocReader, outModule));
 
+    outModule->setDeferredBodyLoader(loader);
     return SLANG_OK;
 }
 
@@ -52,6 +52,8 @@ protected:
     
     void _addInstruction(IRInst* inst);
     Result _calcDebugInfo(SerialSourceLocWriter* sourceLocWriter);
+        /// Find the bodies of global values that can be decoded independently, and add them to m_deferredBodies
+    void _calcDeferredBodies(IRModuleInst* moduleInst);
     
     List<IRInst*> m_insts;                              ///< Instructions in same order as stored in the 
 
@@ -74,6 +76,12 @@ struct IRSerialReader
         /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
 
+        /// Read a module from serial data, leaving the bodies in data.m_deferredBodies to be decoded
+        /// when they are first needed (see `IRModule::materializeDeferredBody`).
+        ///
+        /// If there are deferred bodies the module keeps the serial data, and `data` is left empty.
+    Result readWithDeferredBodies(IRSerialData& data, Session* session, SerialSourceLocReader* sourceLocReader, RefPtr<IRModule>& outModule);
+
     IRSerialReader():
         m_serialData(nullptr),
         m_module(nullptr),
@@ -147,6 +147,9 @@ struct SerialBinary
         // Module header
     static const FourCC kModuleHeaderFourCc = SLANG_FOUR_CC('S', 'm', 'h', 'd');
 
+        /// Digests used to reuse the IR of unchanged functions when a module is compiled again
+    static const FourCC kIRReuseDigestsFourCc = SLANG_FOUR_CC('S', 'r', 'u', 'd');
+
     struct ContainerHeader
     {
         uint32_t compressionType;         ///< Holds the compression type used (if used at all)
@@ -0,0 +1,619 @@
+// slang-spirv-post-optimize.cpp
+#include "slang-spirv-post-optimize.h"
+
+#include "../core/slang-hash.h"
+#include "slang-com-helper.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+    // How a word in the operands of an instruction is interpreted.
+enum class OperandWordKind
+{
+    Id,             ///< A result id, or a reference to one
+    Literal,        ///< A single word literal or enum value, which is never an id
+    Unknown,        ///< Can't be classified from the grammar, so may or may not be an id
+};
+
+static bool _isDecoration(SpvOp op)
+{
+    switch (op)
+    {
+        case SpvOpDecorate:
+        case SpvOpDecorateId:
+        case SpvOpDecorateString:
+        case SpvOpMemberDecorate:
+        case SpvOpMemberDecorateString:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool _isName(SpvOp op)
+{
+    return op == SpvOpName || op == SpvOpMemberName;
+}
+
+    // Instructions that only say something about the id in their first operand, and so
+    // don't keep it alive by themselves.
+static bool _isAttachment(SpvOp op)
+{
+    return _isDecoration(op) || _isName(op) || op == SpvOpTypeForwardPointer;
+}
+
+struct SPIRVPostOptimizeContext
+{
+    static const Index kHeaderWordCount = 5;
+
+    struct Inst
+    {
+        Index offset = 0;               ///< Offset of the first word in `m_words`
+        Index wordCount = 0;
+        SpvOp op = SpvOpNop;
+        Index functionEnd = -1;         ///< For an `OpFunction`, the index of its `OpFunctionEnd`
+        bool isInFunction = false;
+        bool isRemoved = false;
+    };
+
+    SPIRVPostOptimizeContext(const SPIRVCoreGrammarInfo& grammar, const SPIRVPostOptimizeOptions& options)
+        : m_grammar(grammar)
+        , m_options(options)
+    {
+        for (auto name : { "IdRef", "IdResultType", "IdResult", "IdMemorySemantics", "IdScope" })
+        {
+            if (auto kind = grammar.operandKinds.lookup(UnownedStringSlice(name)))
+                m_idOperandKinds.add(*kind);
+        }
+        // Only kinds that are always a single word, and have no parameters, can be listed here.
+        for (auto name : { "LiteralInteger", "LiteralExtInstInteger", "LiteralSpecConstantOpInteger",
+            "ExecutionModel", "StorageClass", "FunctionControl" })
+        {
+            if (auto kind = grammar.operandKinds.lookup(UnownedStringSlice(name)))
+                m_literalOperandKinds.add(*kind);
+        }
+    }
+
+    SlangResult run(List<uint8_t>& ioSpirv)
+    {
+        SLANG_RETURN_ON_FAIL(_parse(ioSpirv));
+
+        if (m_options.stripNames)
+            _removeNames();
+        _removeDuplicateDecorations();
+        _mergeRedundantAccesses();
+        _removeDeadGlobals();
+
+        _write(ioSpirv);
+        return SLANG_OK;
+    }
+
+private:
+    SlangResult _parse(List<uint8_t>& spirv)
+    {
+        if (spirv.getCount() % sizeof(SpvWord) != 0 || spirv.getCount() < kHeaderWordCount * Index(sizeof(SpvWord)))
+            return SLANG_FAIL;
+
+        m_words = reinterpret_cast<SpvWord*>(spirv.getBuffer());
+        m_wordCount = spirv.getCount() / sizeof(SpvWord);
+        if (m_words[0] != SpvMagicNumber)
+            return SLANG_FAIL;
+        m_idBound = m_words[3];
+
+        Index functionStart = -1;
+        for (Index offset = kHeaderWordCount; offset < m_wordCount; )
+        {
+            Inst inst;
+            inst.offset = offset;
+            inst.wordCount = Index(m_words[offset] >> 16);
+            inst.op = SpvOp(m_words[offset] & SpvOpCodeMask);
+            if (inst.wordCount == 0 || offset + inst.wordCount > m_wordCount)
+                return SLANG_FAIL;
+
+            inst.isInFunction = functionStart != -1;
+            if (inst.op == SpvOpFunction)
+            {
+                if (functionStart != -1)
+                    return SLANG_FAIL;
+                functionStart = m_insts.getCount();
+                inst.isInFunction = true;
+            }
+            else if (inst.op == SpvOpFunctionEnd)
+            {
+                if (functionStart == -1)
+                    return SLANG_FAIL;
+                m_insts[functionStart].functionEnd = m_insts.getCount();
+                functionStart = -1;
+            }
+
+            m_insts.add(inst);
+            offset += inst.wordCount;
+        }
+        return functionStart == -1 ? SLANG_OK : SLANG_FAIL;
+    }
+
+    void _write(List<uint8_t>& ioSpirv)
+    {
+        // Instructions only ever move towards the start, so they can be compacted in place.
+        Index writeOffset = kHeaderWordCount;
+        for (const auto& inst : m_insts)
+        {
+            if (inst.isRemoved)
+                continue;
+            if (writeOffset != inst.offset)
+                ::memmove(m_words + writeOffset, m_words + inst.offset, inst.wordCount * sizeof(SpvWord));
+            writeOffset += inst.wordCount;
+        }
+        ioSpirv.setCount(writeOffset * sizeof(SpvWord));
+    }
+
+    SpvWord* _getWords(const Inst& inst) const { return m_words + inst.offset; }
+
+    UnownedStringSlice _getBytes(const Inst& inst) const
+    {
+        const char* begin = reinterpret_cast<const char*>(_getWords(inst));
+        return UnownedStringSlice(begin, begin + inst.wordCount * sizeof(SpvWord));
+    }
+
+        /// Get the result id of `inst`, or 0 if it doesn't have one.
+    SpvWord _getResultId(const Inst& inst) const
+    {
+        const auto info = m_grammar.opInfos.lookup(inst.op);
+        if (!info || info->resultIdIndex == SPIRVCoreGrammarInfo::OpInfo::kNoResultId)
+            return 0;
+        const Index wordIndex = info->resultIdIndex + 1;
+        return wordIndex < inst.wordCount ? _getWords(inst)[wordIndex] : 0;
+    }
+
+        /// Get the result type id of `inst`, or 0 if it doesn't have one.
+    SpvWord _getResultTypeId(const Inst& inst) const
+    {
+        const auto info = m_grammar.opInfos.lookup(inst.op);
+        if (!info || info->resultTypeIndex == SPIRVCoreGrammarInfo::OpInfo::kNoResultTypeId)
+            return 0;
+        const Index wordIndex = info->resultTypeIndex + 1;
+        return wordIndex < inst.wordCount ? _getWords(inst)[wordIndex] : 0;
+    }
+
+        /// Call `f(wordIndex, kind)` for each operand word of `inst`.
+        ///
+        /// Operands are classified in order until one is met whose size or meaning
+        /// depends on the values before it, such as a string or an enum with
+        /// parameters, and every word from there on is `Unknown`.
+    template<typename F>
+    void _forEachOperandWord(const Inst& inst, const F& f) const
+    {
+        Index wordIndex = 1;
+        const auto info = m_grammar.opInfos.lookup(inst.op);
+        if (info && info->numOperandTypes)
+        {
+            for (Index operandIndex = 0; wordIndex < inst.wordCount; ++operandIndex, ++wordIndex)
+            {
+                // The last operand type repeats for variable length operand lists
+                const auto kind = info->operandTypes[Math::Min(operandIndex, Index(info->numOperandTypes) - 1)];
+                if (m_idOperandKinds.contains(kind))
+                    f(wordIndex, OperandWordKind::Id);
+                else if (m_literalOperandKinds.contains(kind))
+                    f(wordIndex, OperandWordKind::Literal);
+                else
+                    break;
+            }
+        }
+        for (; wordIndex < inst.wordCount; ++wordIndex)
+            f(wordIndex, OperandWordKind::Unknown);
+    }
+
+        /// True if executing `inst` can't change memory, or have any other side effect.
+    bool _isPure(const Inst& inst) const
+    {
+        switch (inst.op)
+        {
+            case SpvOpAccessChain:
+            case SpvOpInBoundsAccessChain:
+            case SpvOpPtrAccessChain:
+            case SpvOpLoad:
+            case SpvOpPhi:
+            case SpvOpSelectionMerge:
+            case SpvOpLoopMerge:
+            case SpvOpLine:
+            case SpvOpNoLine:
+            case SpvOpUndef:
+                return true;
+            default:
+                break;
+        }
+
+        const auto info = m_grammar.opInfos.lookup(inst.op);
+        if (!info)
+            return false;
+        switch (info->class_)
+        {
+            case SPIRVCoreGrammarInfo::OpInfo::Arithmetic:
+            case SPIRVCoreGrammarInfo::OpInfo::Bit:
+            case SPIRVCoreGrammarInfo::OpInfo::Relational_and_Logical:
+            case SPIRVCoreGrammarInfo::OpInfo::Conversion:
+            case SPIRVCoreGrammarInfo::OpInfo::Composite:
+            case SPIRVCoreGrammarInfo::OpInfo::Derivative:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    void _removeNames()
+    {
+        for (auto& inst : m_insts)
+        {
+            if (_isName(inst.op))
+                inst.isRemoved = true;
+        }
+    }
+
+    void _removeDuplicateDecorations()
+    {
+        // Keyed on the words of the whole instruction, which stay in the SPIR-V buffer.
+        HashSet<UnownedStringSlice> decorations;
+        for (auto& inst : m_insts)
+        {
+            if (!inst.isRemoved && _isDecoration(inst.op) && !decorations.add(_getBytes(inst)))
+                inst.isRemoved = true;
+        }
+    }
+
+        /// Within each block, replace each `OpAccessChain` that is identical to an earlier
+        /// one with the earlier one, and likewise each `OpLoad` from a pointer already
+        /// loaded from, as long as nothing between the two loads can write memory.
+    void _mergeRedundantAccesses()
+    {
+        HashSet<SpvWord> decoratedIds;
+        HashSet<SpvWord> volatileIds;
+        bool hasVolatileMembers = false;
+        Dictionary<SpvWord, SpvWord> typeOfIds;
+        Dictionary<SpvWord, SpvWord> storageClassOfPointerTypes;
+        for (const auto& inst : m_insts)
+        {
+            if (inst.isRemoved)
+                continue;
+            const auto words = _getWords(inst);
+            if (_isDecoration(inst.op) && inst.wordCount >= 3)
+            {
+                decoratedIds.add(words[1]);
+                if (inst.op == SpvOpDecorate && words[2] == SpvDecorationVolatile)
+                    volatileIds.add(words[1]);
+                if (inst.op == SpvOpMemberDecorate && inst.wordCount >= 4 && words[3] == SpvDecorationVolatile)
+                    hasVolatileMembers = true;
+            }
+            else if (inst.op == SpvOpTypePointer && inst.wordCount >= 3)
+            {
+                storageClassOfPointerTypes[words[1]] = words[2];
+            }
+            else if (auto resultTypeId = _getResultTypeId(inst))
+            {
+                if (auto resultId = _getResultId(inst))
+                    typeOfIds[resultId] = resultTypeId;
+            }
+        }
+
+        // The id each merged instruction is replaced with, and the instruction itself.
+        Dictionary<SpvWord, SpvWord> replacements;
+        Dictionary<SpvWord, Index> mergedInsts;
+        Dictionary<SpvWord, SpvWord> accessChainBases;
+        auto resolve = [&](SpvWord id)
+        {
+            if (auto replacement = replacements.tryGetValue(id))
+                return *replacement;
+            return id;
+        };
+
+        // Only loads from memory no other invocation can write while the block runs are merged.
+        auto canMergeLoadFrom = [&](SpvWord pointerId)
+        {
+            if (hasVolatileMembers)
+                return false;
+            auto pointerTypeId = typeOfIds.tryGetValue(pointerId);
+            auto storageClass = pointerTypeId ? storageClassOfPointerTypes.tryGetValue(*pointerTypeId) : nullptr;
+            if (!storageClass)
+                return false;
+            switch (*storageClass)
+            {
+                case SpvStorageClassFunction:
+                case SpvStorageClassPrivate:
+                case SpvStorageClassInput:
+                case SpvStorageClassUniform:
+                case SpvStorageClassUniformConstant:
+                case SpvStorageClassPushConstant:
+                    break;
+                default:
+                    return false;
+            }
+            for (SpvWord id = pointerId; id; )
+            {
+                if (volatileIds.contains(id))
+                    return false;
+                auto base = accessChainBases.tryGetValue(id);
+                id = base ? *base : 0;
+            }
+            return true;
+        };
+
+        // Candidates are found by hash, and then compared word by word.
+        Dictionary<HashCode64, List<Index>> accessChains;
+        Dictionary<HashCode64, List<Index>> loads;
+        List<SpvWord> key;
+        List<SpvWord> candidateKey;
+        auto makeKey = [&](const Inst& inst, List<SpvWord>& outKey)
+        {
+            // Everything but the result id, with merged ids replaced.
+            const auto words = _getWords(inst);
+            outKey.clear();
+            outKey.add(words[0]);
+            outKey.add(words[1]);
+            for (Index i = 3; i < inst.wordCount; ++i)
+                outKey.add(resolve(words[i]));
+        };
+        auto findOrAdd = [&](Dictionary<HashCode64, List<Index>>& candidates, Index instIndex) -> Index
+        {
+            makeKey(m_insts[instIndex], key);
+            const auto hash = getHashCode(reinterpret_cast<const char*>(key.getBuffer()), key.getCount() * sizeof(SpvWord));
+            auto& sameHash = candidates[hash];
+            for (auto candidateIndex : sameHash)
+            {
+                makeKey(m_insts[candidateIndex], candidateKey);
+                if (candidateKey == key)
+                    return candidateIndex;
+            }
+            sameHash.add(instIndex);
+            return -1;
+        };
+
+        for (Index i = 0; i < m_insts.getCount(); ++i)
+        {
+            auto& inst = m_insts[i];
+            if (inst.isRemoved || !inst.isInFunction)
+                continue;
+            const auto words = _getWords(inst);
+
+            Dictionary<HashCode64, List<Index>>* candidates = nullptr;
+            switch (inst.op)
+            {
+                case SpvOpLabel:
+                    accessChains.clear();
+                    loads.clear();
+                    continue;
+                case SpvOpAccessChain:
+                case SpvOpInBoundsAccessChain:
+                    if (inst.wordCount < 4)
+                        continue;
+                    accessChainBases[words[2]] = resolve(words[3]);
+                    candidates = &accessChains;
+                    break;
+                case SpvOpLoad:
+                    // Loads with memory operands might be volatile, or need to be made visible
+                    if (inst.wordCount != 4 || !canMergeLoadFrom(resolve(words[3])))
+                        continue;
+                    candidates = &loads;
+                    break;
+                default:
+                    if (!_isPure(inst))
+                        loads.clear();
+                    continue;
+            }
+
+            // A decoration such as `NonUniform` only applies to its own id.
+            const auto resultId = words[2];
+            if (decoratedIds.contains(resultId))
+                continue;
+            const Index existingIndex = findOrAdd(*candidates, i);
+            if (existingIndex < 0)
+                continue;
+            const auto existingId = _getWords(m_insts[existingIndex])[2];
+            if (decoratedIds.contains(existingId))
+                continue;
+
+            replacements[resultId] = existingId;
+            mergedInsts[resultId] = i;
+            inst.isRemoved = true;
+        }
+
+        if (replacements.getCount() == 0)
+            return;
+
+        // A merged id that is used where we can't tell whether a word is an id can't be replaced.
+        List<SpvWord> unreplaceableIds;
+        for (const auto& inst : m_insts)
+        {
+            if (inst.isRemoved)
+                continue;
+            const auto words = _getWords(inst);
+            _forEachOperandWord(inst, [&](Index wordIndex, OperandWordKind kind)
+            {
+                if (kind == OperandWordKind::Unknown && replacements.containsKey(words[wordIndex]))
+                    unreplaceableIds.add(words[wordIndex]);
+            });
+        }
+        for (auto id : unreplaceableIds)
+        {
+            if (auto instIndex = mergedInsts.tryGetValue(id))
+                m_insts[*instIndex].isRemoved = false;
+            replacements.remove(id);
+        }
+
+        for (auto& inst : m_insts)
+        {
+            if (inst.isRemoved)
+                continue;
+            auto words = _getWords(inst);
+            if (_isName(inst.op) && inst.wordCount >= 2 && replacements.containsKey(words[1]))
+            {
+                inst.isRemoved = true;
+                continue;
+            }
+            _forEachOperandWord(inst, [&](Index wordIndex, OperandWordKind kind)
+            {
+                if (kind == OperandWordKind::Id)
+                    words[wordIndex] = resolve(words[wordIndex]);
+            });
+        }
+    }
+
+        /// Remove types, constants and functions whose ids are not referenced from anything
+        /// that is live, along with their decorations and names.
+        ///
+        /// Everything else outside of functions, such as entry points, global variables and
+        /// debug information, is treated as live.
+    void _removeDeadGlobals()
+    {
+        Dictionary<SpvWord, Index> definitions;
+        Dictionary<SpvWord, List<Index>> attachments;
+        List<Index> work;
+        for (Index i = 0; i < m_insts.getCount(); ++i)
+        {
+            const auto& inst = m_insts[i];
+            if (inst.isRemoved)
+                continue;
+            if (inst.isInFunction)
+            {
+                if (inst.op == SpvOpFunction)
+                {
+                    if (auto resultId = _getResultId(inst))
+                        definitions[resultId] = i;
+                }
+                continue;
+            }
+            if (_isAttachment(inst.op))
+            {
+                if (inst.wordCount >= 2)
+                    attachments[_getWords(inst)[1]].add(i);
+                continue;
+            }
+
+            const auto resultId = _getResultId(inst);
+            if (resultId && _isRemovableGlobal(inst))
+                definitions[resultId] = i;
+            else
+                work.add(i);
+        }
+        // Attachments to ids we never remove, such as those of function locals, are always live.
+        for (const auto& [targetId, targetAttachments] : attachments)
+        {
+            if (!definitions.containsKey(targetId))
+                work.addRange(targetAttachments);
+        }
+
+        HashSet<SpvWord> liveIds;
+        List<bool> isProcessed;
+        isProcessed.setCount(m_insts.getCount());
+        for (auto& processed : isProcessed)
+            processed = false;
+
+        auto markLive = [&](SpvWord id)
+        {
+            if (id == 0 || id >= m_idBound || !liveIds.add(id))
+                return;
+            if (auto definition = definitions.tryGetValue(id))
+                work.add(*definition);
+            if (auto idAttachments = attachments.tryGetValue(id))
+                work.addRange(*idAttachments);
+        };
+        auto markOperandsLive = [&](const Inst& inst)
+        {
+            const auto words = _getWords(inst);
+            _forEachOperandWord(inst, [&](Index wordIndex, OperandWordKind kind)
+            {
+                if (kind != OperandWordKind::Literal)
+                    markLive(words[wordIndex]);
+            });
+        };
+
+        while (work.getCount())
+        {
+            const Index instIndex = work.getLast();
+            work.removeLast();
+            if (isProcessed[instIndex])
+                continue;
+            isProcessed[instIndex] = true;
+
+            const auto& inst = m_insts[instIndex];
+            markOperandsLive(inst);
+            if (inst.op == SpvOpFunction)
+            {
+                for (Index i = instIndex + 1; i <= inst.functionEnd; ++i)
+                {
+                    if (!m_insts[i].isRemoved)
+                        markOperandsLive(m_insts[i]);
+                }
+            }
+        }
+
+        // The ids defined in the bodies of removed functions, whose attachments must go too.
+        HashSet<SpvWord> removedLocalIds;
+        for (Index i = 0; i < m_insts.getCount(); ++i)
+        {
+            auto& inst = m_insts[i];
+            if (inst.isRemoved || isProcessed[i] || (inst.isInFunction && inst.op != SpvOpFunction))
+                continue;
+
+            if (_isAttachment(inst.op))
+            {
+                inst.isRemoved = true;
+                continue;
+            }
+            if (definitions.containsKey(_getResultId(inst)))
+            {
+                inst.isRemoved = true;
+                for (Index j = i + 1; j <= inst.functionEnd; ++j)
+                {
+                    m_insts[j].isRemoved = true;
+                    if (auto resultId = _getResultId(m_insts[j]))
+                        removedLocalIds.add(resultId);
+                }
+            }
+        }
+
+        if (removedLocalIds.getCount() == 0)
+            return;
+        for (auto& inst : m_insts)
+        {
+            if (!inst.isRemoved && !inst.isInFunction && _isAttachment(inst.op)
+                && inst.wordCount >= 2 && removedLocalIds.contains(_getWords(inst)[1]))
+            {
+                inst.isRemoved = true;
+            }
+        }
+    }
+
+    bool _isRemovableGlobal(const Inst& inst) const
+    {
+        if (inst.op == SpvOpUndef)
+            return true;
+        const auto info = m_grammar.opInfos.lookup(inst.op);
+        return info && (info->class_ == SPIRVCoreGrammarInfo::OpInfo::TypeDeclaration
+            || info->class_ == SPIRVCoreGrammarInfo::OpInfo::ConstantCreation);
+    }
+
+    const SPIRVCoreGrammarInfo& m_grammar;
+    SPIRVPostOptimizeOptions m_options;
+
+    HashSet<SPIRVCoreGrammarInfo::OperandKind> m_idOperandKinds;
+    HashSet<SPIRVCoreGrammarInfo::OperandKind> m_literalOperandKinds;
+
+    SpvWord* m_words = nullptr;
+    Index m_wordCount = 0;
+    SpvWord m_idBound = 0;
+    List<Inst> m_insts;
+};
+
+} // anonymous
+
+SlangResult postOptimizeSPIRV(
+    const SPIRVCoreGrammarInfo& grammar,
+    const SPIRVPostOptimizeOptions& options,
+    List<uint8_t>& ioSpirv)
+{
+    SPIRVPostOptimizeContext context(grammar, options);
+    return context.run(ioSpirv);
+}
+
+}
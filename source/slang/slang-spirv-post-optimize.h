@@ -0,0 +1,34 @@
+// slang-spirv-post-optimize.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../compiler-core/slang-spirv-core-grammar.h"
+
+namespace Slang
+{
+        /// Options for `postOptimizeSPIRV`.
+    struct SPIRVPostOptimizeOptions
+    {
+            /// Remove `OpName` and `OpMemberName` instructions.
+        bool stripNames = false;
+    };
+
+        /// Run a few cheap clean up passes over the SPIR-V module held in `ioSpirv`, in place.
+        ///
+        /// The passes are:
+        /// * removal of types, constants and functions that nothing live references
+        /// * removal of duplicate decorations
+        /// * merging of identical `OpAccessChain`s, and of `OpLoad`s from the same pointer
+        ///   with nothing that can write memory between them, within a block
+        /// * optionally, removal of debug names
+        ///
+        /// They rely only on the operand kinds in `grammar`, and leave alone anything whose
+        /// operands they can't classify, so they are much faster than running `spirv-opt`,
+        /// and can be used when no optimization is asked for, or `spirv-opt` isn't available.
+        ///
+        /// Returns a failure, and leaves `ioSpirv` unchanged, if the module can't be parsed.
+    SlangResult postOptimizeSPIRV(
+        const SPIRVCoreGrammarInfo& grammar,
+        const SPIRVPostOptimizeOptions& options,
+        List<uint8_t>& ioSpirv);
+}
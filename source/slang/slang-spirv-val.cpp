@@ -14,13 +14,17 @@ SlangResult disassembleSPIRV(const List<uint8_t>& spirv, String& outErr, String&
 
     // If we failed to even start the process, then validation isn't available
     SLANG_RETURN_ON_FAIL(Process::create(commandLine, 0, p));
-    const auto in = p->getStream(StdStreamType::In);
-    const auto out = p->getStream(StdStreamType::Out);
-    const auto err = p->getStream(StdStreamType::ErrorOut);
 
     List<Byte> outData;
     List<Byte> outErrData;
-    SLANG_RETURN_ON_FAIL(StreamUtil::readAndWrite(in, spirv.getArrayView(), out, outData, err, outErrData));
+
+    Process::StreamIO io;
+    io.process = p;
+    io.writeInput = true;
+    io.input = spirv.getArrayView();
+    io.output = &outData;
+    io.errorOutput = &outErrData;
+    SLANG_RETURN_ON_FAIL(Process::pumpStreams(&io, 1));
 
     SLANG_RETURN_ON_FAIL(p->waitForTermination(10));
 
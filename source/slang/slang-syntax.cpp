@@ -323,10 +323,10 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         , m_obj(witnessTable)
     {}
 
-    RefPtr<WitnessTable> RequirementWitness::getWitnessTable()
+    WitnessTable* RequirementWitness::getWitnessTable() const
     {
         SLANG_ASSERT(getFlavor() == Flavor::witnessTable);
-        return m_obj.as<WitnessTable>();
+        return static_cast<WitnessTable*>(m_obj.get());
     }
 
     RefPtr<WitnessTable> WitnessTable::specialize(ASTBuilder* astBuilder, SubstitutionSet const& subst)
@@ -376,10 +376,42 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
         }
     }
 
-    RequirementWitness tryLookUpRequirementWitness(
-        ASTBuilder*     astBuilder,
-        SubtypeWitness* subtypeWitness,
-        Decl*           requirementKey)
+    // Add the substitutions in `substs` that apply to the entries of `witnessTable` to
+    // `ioEntrySubsts`. As in `WitnessTable::specialize`, a substitution that doesn't change
+    // the types the table is for leaves the table, and so its entries, as is.
+    //
+    static void _addWitnessTableEntrySubsts(
+        ASTBuilder*                     astBuilder,
+        WitnessTable*                   witnessTable,
+        List<SubstitutionSet> const&    substs,
+        List<SubstitutionSet>&          ioEntrySubsts)
+    {
+        Val* baseType = witnessTable->baseType;
+        Val* witnessedType = witnessTable->witnessedType;
+        for (auto const& subst : substs)
+        {
+            auto newBaseType = baseType->substitute(astBuilder, subst);
+            auto newWitnessedType = witnessedType->substitute(astBuilder, subst);
+            if (newBaseType == baseType && newWitnessedType == witnessedType)
+                continue;
+            baseType = newBaseType;
+            witnessedType = newWitnessedType;
+            ioEntrySubsts.add(subst);
+        }
+    }
+
+    // Find the witness table entry for `requirementKey`, adding the substitutions that still
+    // have to be applied to it to `outSubsts`, in order.
+    //
+    // Witness tables are owned by their declarations and only looked at through raw pointers
+    // here, as function bodies can be checked on several threads at once (see
+    // `_checkBodiesInParallel`), and reference counts aren't atomic.
+    //
+    static RequirementWitness const* _findRequirementWitness(
+        ASTBuilder*             astBuilder,
+        SubtypeWitness*         subtypeWitness,
+        Decl*                   requirementKey,
+        List<SubstitutionSet>&  outSubsts)
     {
         if(auto declaredSubtypeWitness = as<DeclaredSubtypeWitness>(subtypeWitness))
         {
@@ -388,59 +420,60 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                 // A conformance that was declared as part of an inheritance clause
                 // will have built up a dictionary of the satisfying declarations
                 // for each of its requirements.
-                RequirementWitness requirementWitness;
-                auto witnessTable = inheritanceDeclRef.getDecl()->witnessTable;
-                if(witnessTable && witnessTable->getRequirementDictionary().tryGetValue(requirementKey, requirementWitness))
-                {
-                    // The `inheritanceDeclRef` has substitutions applied to it that
-                    // *aren't* present in the `requirementWitness`, because it was
-                    // derived by the front-end when looking at the `InheritanceDecl` alone.
-                    //
-                    // We need to apply these substitutions here for the result to make sense.
-                    //
-                    // E.g., if we have a case like:
-                    //
-                    //      interface ISidekick { associatedtype Hero; void follow(Hero hero); }
-                    //      struct Sidekick<H> : ISidekick { typedef H Hero; void follow(H hero) {} };
-                    //
-                    //      void followHero<S : ISidekick>(S s, S.Hero h)
-                    //      {
-                    //          s.follow(h);
-                    //      }
-                    //
-                    //      Batman batman;
-                    //      Sidekick<Batman> robin;
-                    //      followHero<Sidekick<Batman>>(robin, batman);
-                    //
-                    // The second argument to `followHero` is `batman`, which has type `Batman`.
-                    // The parameter declaration lists the type `S.Hero`, which is a reference
-                    // to an associated type. The front  end will expand this into something
-                    // like `S.{S:ISidekick}.Hero` - that is, we'll end up with a declaration
-                    // reference to `ISidekick.Hero` with a this-type substitution that references
-                    // the `{S:ISidekick}` declaration as a witness.
-                    //
-                    // The front-end will expand the generic application `followHero<Sidekick<Batman>>`
-                    // to `followHero<Sidekick<Batman>, {Sidekick<H>:ISidekick}[H->Batman]>`
-                    // (that is, the hidden second parameter will reference the inheritance
-                    // clause on `Sidekick<H>`, with a substitution to map `H` to `Batman`.
-                    //
-                    // This step should map the `{S:ISidekick}` declaration over to the
-                    // concrete `{Sidekick<H>:ISidekick}[H->Batman]` inheritance declaration.
-                    // At that point `tryLookupRequirementWitness` might be called, because
-                    // we want to look up the witness for the key `ISidekick.Hero` in the
-                    // inheritance decl-ref that is `{Sidekick<H>:ISidekick}[H->Batman]`.
-                    //
-                    // That lookup will yield us a reference to the typedef `Sidekick<H>.Hero`,
-                    // *without* any substitution for `H` (or rather, with a default one that
-                    // maps `H` to `H`.
-                    //
-                    // So, in order to get the *right* end result, we need to apply
-                    // the substitutions from the inheritance decl-ref to the witness.
-                    //
-                    requirementWitness = requirementWitness.specialize(astBuilder, SubstitutionSet(inheritanceDeclRef));
-
-                    return requirementWitness;
-                }
+                auto witnessTable = inheritanceDeclRef.getDecl()->witnessTable.get();
+                if (!witnessTable)
+                    return nullptr;
+                auto requirementWitness = witnessTable->getRequirementDictionary().tryGetValue(requirementKey);
+                if (!requirementWitness)
+                    return nullptr;
+
+                // The `inheritanceDeclRef` has substitutions applied to it that
+                // *aren't* present in the `requirementWitness`, because it was
+                // derived by the front-end when looking at the `InheritanceDecl` alone.
+                //
+                // We need to apply these substitutions here for the result to make sense.
+                //
+                // E.g., if we have a case like:
+                //
+                //      interface ISidekick { associatedtype Hero; void follow(Hero hero); }
+                //      struct Sidekick<H> : ISidekick { typedef H Hero; void follow(H hero) {} };
+                //
+                //      void followHero<S : ISidekick>(S s, S.Hero h)
+                //      {
+                //          s.follow(h);
+                //      }
+                //
+                //      Batman batman;
+                //      Sidekick<Batman> robin;
+                //      followHero<Sidekick<Batman>>(robin, batman);
+                //
+                // The second argument to `followHero` is `batman`, which has type `Batman`.
+                // The parameter declaration lists the type `S.Hero`, which is a reference
+                // to an associated type. The front  end will expand this into something
+                // like `S.{S:ISidekick}.Hero` - that is, we'll end up with a declaration
+                // reference to `ISidekick.Hero` with a this-type substitution that references
+                // the `{S:ISidekick}` declaration as a witness.
+                //
+                // The front-end will expand the generic application `followHero<Sidekick<Batman>>`
+                // to `followHero<Sidekick<Batman>, {Sidekick<H>:ISidekick}[H->Batman]>`
+                // (that is, the hidden second parameter will reference the inheritance
+                // clause on `Sidekick<H>`, with a substitution to map `H` to `Batman`.
+                //
+                // This step should map the `{S:ISidekick}` declaration over to the
+                // concrete `{Sidekick<H>:ISidekick}[H->Batman]` inheritance declaration.
+                // At that point `tryLookupRequirementWitness` might be called, because
+                // we want to look up the witness for the key `ISidekick.Hero` in the
+                // inheritance decl-ref that is `{Sidekick<H>:ISidekick}[H->Batman]`.
+                //
+                // That lookup will yield us a reference to the typedef `Sidekick<H>.Hero`,
+                // *without* any substitution for `H` (or rather, with a default one that
+                // maps `H` to `H`.
+                //
+                // So, in order to get the *right* end result, we need to apply
+                // the substitutions from the inheritance decl-ref to the witness.
+                //
+                outSubsts.add(SubstitutionSet(inheritanceDeclRef));
+                return requirementWitness;
             }
         }
         else if (auto transitiveTypeWitness = as<TransitiveSubtypeWitness>(subtypeWitness))
@@ -448,16 +481,17 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
             if (auto declaredSubtypeWitnessMidToSup = as<DeclaredSubtypeWitness>(transitiveTypeWitness->getMidToSup()))
             {
                 auto midKey = declaredSubtypeWitnessMidToSup->getDeclRef();
-                auto midWitness = tryLookUpRequirementWitness(astBuilder, as<SubtypeWitness>(transitiveTypeWitness->getSubToMid()), midKey.getDecl());
-                if (midWitness.getFlavor() == RequirementWitness::Flavor::witnessTable)
+                List<SubstitutionSet> midSubsts;
+                auto midWitness = _findRequirementWitness(astBuilder, as<SubtypeWitness>(transitiveTypeWitness->getSubToMid()), midKey.getDecl(), midSubsts);
+                if (midWitness && midWitness->getFlavor() == RequirementWitness::Flavor::witnessTable)
                 {
-                    auto table = midWitness.getWitnessTable();
-                    RequirementWitness result;
-                    if (table->getRequirementDictionary().tryGetValue(requirementKey, result))
-                    {
-                        result = result.specialize(astBuilder, SubstitutionSet(midKey));
-                    }
-                    return result;
+                    auto table = midWitness->getWitnessTable();
+                    auto requirementWitness = table->getRequirementDictionary().tryGetValue(requirementKey);
+                    if (!requirementWitness)
+                        return nullptr;
+                    _addWitnessTableEntrySubsts(astBuilder, table, midSubsts, outSubsts);
+                    outSubsts.add(SubstitutionSet(midKey));
+                    return requirementWitness;
                 }
             }
         }
@@ -469,10 +503,30 @@ Index getFilterCountImpl(const ReflectClassInfo& clsInfo, MemberFilterStyle filt
                     conjunctionTypeWitness->getComponentWitness(
                         extractFromConjunctionTypeWitness->getIndexInConjunction()));
 
-                return tryLookUpRequirementWitness(astBuilder, componentWitness, requirementKey);
+                return _findRequirementWitness(astBuilder, componentWitness, requirementKey, outSubsts);
             }
         }
-        
+        return nullptr;
+    }
+
+    RequirementWitness tryLookUpRequirementWitness(
+        ASTBuilder*     astBuilder,
+        SubtypeWitness* subtypeWitness,
+        Decl*           requirementKey)
+    {
+        List<SubstitutionSet> substs;
+        if (auto requirementWitness = _findRequirementWitness(astBuilder, subtypeWitness, requirementKey, substs))
+        {
+            // A witness table would have to be shared with the declaration that owns it
+            if (requirementWitness->getFlavor() == RequirementWitness::Flavor::witnessTable)
+                return RequirementWitness();
+
+            RequirementWitness result = *requirementWitness;
+            for (auto const& subst : substs)
+                result = result.specialize(astBuilder, subst);
+            return result;
+        }
+
         // If we are looking for `ThisType`, just return subtype.
         if (as<ThisTypeDecl>(requirementKey))
         {
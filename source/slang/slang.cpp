@@ -4,6 +4,7 @@
 #include "../core/slang-string-util.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-archive-file-system.h"
+#include "../core/slang-riff-file-system.h"
 #include "../core/slang-type-text-util.h"
 #include "../core/slang-type-convert-util.h"
 #include "../core/slang-castable.h"
@@ -22,6 +23,7 @@
 #include "slang-check.h"
 #include "slang-parameter-binding.h"
 #include "slang-lower-to-ir.h"
+#include "slang-ir-link.h"
 #include "slang-mangle.h"
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
@@ -37,12 +39,14 @@
 #include "../core/slang-writer.h"
 
 #include "../compiler-core/slang-source-loc.h"
+#include "../compiler-core/slang-source-file-digest-cache.h"
 
 #include "slang-ast-dump.h"
 
 #include "slang-serialize-ast.h"
 #include "slang-serialize-ir.h"
 #include "slang-serialize-container.h"
+#include "slang-ir-spirv-snippet.h"
 
 #include "slang-doc-ast.h"
 #include "slang-doc-markdown-writer.h"
@@ -52,6 +56,7 @@
 #include "slang-tag-version.h"
 
 #include <sys/stat.h>
+#include <mutex>
 
 // Used to print exception type names in internal-compiler-error messages
 #include <typeinfo>
@@ -374,6 +379,17 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
         }
     }
 
+    {
+        DiagnosticSink sink(getBuiltinSourceManager(), Lexer::sourceLocationLexer);
+        if (SLANG_FAILED(_parseStdLibSpvSnippets(&sink)))
+        {
+            char const* diagnostics = sink.outputBuffer.getBuffer();
+            fprintf(stderr, "%s", diagnostics);
+            PlatformUtil::outputDebugMessage(diagnostics);
+            return SLANG_FAIL;
+        }
+    }
+
     finalizeSharedASTBuilder();
 
 #ifdef _DEBUG
@@ -384,6 +400,9 @@ SlangResult Session::compileStdLib(slang::CompileStdLibFlags compileFlags)
     return SLANG_OK;
 }
 
+// The file in a saved stdlib archive that holds the parsed SPIR-V snippets of its target intrinsics.
+static const char kStdLibSpvSnippetsFileName[] = "core.spirv-snippets";
+
 SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
 {
     SLANG_PROFILE;
@@ -398,11 +417,21 @@ SlangResult Session::loadStdLib(const void* stdLib, size_t stdLibSizeInBytes)
 
     // Make a file system to read it from
     ComPtr<ISlangFileSystemExt> fileSystem;
-    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(stdLib, stdLibSizeInBytes, fileSystem));
+    SLANG_RETURN_ON_FAIL(loadArchiveFileSystem(stdLib, stdLibSizeInBytes, fileSystem, getThreadPool()));
 
     // Let's try loading serialized modules and adding them
     SLANG_RETURN_ON_FAIL(_readBuiltinModule(fileSystem, coreLanguageScope, "core"));
 
+    // A stdlib saved without its parsed snippets still works, they are just parsed
+    // as they are used.
+    m_stdLibSpvSnippets = new SpvSnippetCache();
+    ComPtr<ISlangBlob> snippetsBlob;
+    if (SLANG_SUCCEEDED(fileSystem->loadFile(kStdLibSpvSnippetsFileName, snippetsBlob.writeRef())))
+    {
+        if (SLANG_FAILED(m_stdLibSpvSnippets->read(snippetsBlob->getBufferPointer(), snippetsBlob->getBufferSize())))
+            m_stdLibSpvSnippets = new SpvSnippetCache();
+    }
+
     finalizeSharedASTBuilder();
     return SLANG_OK;
 }
@@ -417,7 +446,7 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
 
     // Make a file system to read it from
     ComPtr<ISlangMutableFileSystem> fileSystem;
-    SLANG_RETURN_ON_FAIL(createArchiveFileSystem(archiveType, fileSystem));
+    SLANG_RETURN_ON_FAIL(createArchiveFileSystem(archiveType, fileSystem, getThreadPool()));
 
     // Must have archiveFileSystem interface
     auto archiveFileSystem = as<IArchiveFileSystem>(fileSystem);
@@ -452,11 +481,56 @@ SlangResult Session::saveStdLib(SlangArchiveType archiveType, ISlangBlob** outBl
         SLANG_RETURN_ON_FAIL(fileSystem->saveFile(builder.getBuffer(), contents.getBuffer(), contents.getCount()));
     }
 
+    if (m_stdLibSpvSnippets && m_stdLibSpvSnippets->getCount())
+    {
+        List<uint8_t> snippetsData;
+        m_stdLibSpvSnippets->write(snippetsData);
+        SLANG_RETURN_ON_FAIL(fileSystem->saveFile(kStdLibSpvSnippetsFileName, snippetsData.getBuffer(), snippetsData.getCount()));
+    }
+
     // Now need to convert into a blob
     SLANG_RETURN_ON_FAIL(archiveFileSystem->storeArchive(true, outBlob));
     return SLANG_OK;
 }
 
+SlangResult Session::_parseStdLibSpvSnippets(DiagnosticSink* sink)
+{
+    SlangResult result = SLANG_OK;
+    m_stdLibSpvSnippets = new SpvSnippetCache();
+    const auto& spirvGrammar = getSPIRVCoreGrammarInfo();
+
+    List<IRInst*> workList;
+    for (const auto& [_, module] : m_builtinLinkage->mapNameToLoadedModules)
+    {
+        if (auto irModule = module->getIRModule())
+            workList.add(irModule->getModuleInst());
+    }
+    while (workList.getCount())
+    {
+        auto inst = workList.getLast();
+        workList.removeLast();
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (auto targetIntrinsic = as<IRTargetIntrinsicDecoration>(child))
+            {
+                // Definitions for other targets aren't SPIR-V, and can't be parsed as it.
+                const auto targetCaps = targetIntrinsic->getTargetCaps();
+                if (!targetCaps.isEmpty() && !targetCaps.isIncompatibleWith(CapabilityName::spirv) &&
+                    SLANG_FAILED(m_stdLibSpvSnippets->addParsed(spirvGrammar, targetIntrinsic->getDefinition())))
+                {
+                    sink->diagnose(targetIntrinsic, Diagnostics::snippetParsingFailed, targetIntrinsic->getDefinition());
+                    result = SLANG_FAIL;
+                }
+            }
+            else
+            {
+                workList.add(child);
+            }
+        }
+    }
+    return result;
+}
+
 SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* scope, String moduleName)
 {
     // Get the name of the module
@@ -464,6 +538,12 @@ SlangResult Session::_readBuiltinModule(ISlangFileSystem* fileSystem, Scope* sco
     moduleFilename << moduleName << ".slang-module";
 
     RiffContainer riffContainer;
+    if (auto riffFileSystem = as<RiffFileSystem>(fileSystem))
+    {
+        // Only decompress the chunks of the module that are read
+        SLANG_RETURN_ON_FAIL(riffFileSystem->loadFileRiff(moduleFilename.getBuffer(), riffContainer));
+    }
+    else
     {
         // Load it
         ComPtr<ISlangBlob> blob;
@@ -836,6 +916,17 @@ IDownstreamCompiler* Session::getDownstreamCompiler(CodeGenTarget source, CodeGe
     return getOrLoadDownstreamCompiler(compilerType, nullptr);
 }
 
+ThreadPool* Session::getThreadPool()
+{
+    std::lock_guard<std::mutex> lock(m_threadPoolMutex);
+    if (!m_threadPool)
+    {
+        // The thread that starts a loop runs iterations too, so one less worker is needed
+        m_threadPool = new ThreadPool(ThreadPool::getHardwareThreadCount() - 1);
+    }
+    return m_threadPool;
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL Session::setSPIRVCoreGrammar(char const* jsonPath)
 {
     if(!jsonPath)
@@ -1055,7 +1146,7 @@ Linkage::Linkage(Session* session, ASTBuilder* astBuilder, Linkage* builtinLinka
     , m_cmdLineContext(new CommandLineContext())
 {
     if (builtinLinkage)
-        m_astBuilder->m_cachedNodes = builtinLinkage->getASTBuilder()->m_cachedNodes;
+        m_astBuilder->m_cachedNodes.setParent(&builtinLinkage->getASTBuilder()->m_cachedNodes);
 
     getNamePool()->setRootNamePool(session->getRootNamePool());
 
@@ -1075,6 +1166,8 @@ ISlangUnknown* Linkage::getInterface(const Guid& guid)
 {
     if(guid == ISlangUnknown::getTypeGuid() || guid == ISession::getTypeGuid())
         return asExternal(this);
+    if(guid == slang::ISessionMemoryUsage::getTypeGuid())
+        return static_cast<slang::ISessionMemoryUsage*>(this);
 
     return nullptr;
 }
@@ -1096,6 +1189,15 @@ SearchDirectoryList& Linkage::getSearchDirectories()
     return searchDirectoryCache;
 }
 
+ASTBuilder* Linkage::getWorkerASTBuilder(Index threadSlot)
+{
+    while (m_workerASTBuilders.getCount() <= threadSlot)
+    {
+        m_workerASTBuilders.add(new ASTBuilder(m_astBuilder, "m_workerASTBuilders"));
+    }
+    return m_workerASTBuilders[threadSlot];
+}
+
 TypeCheckingCache* Linkage::getTypeCheckingCache()
 {
     if (!m_typeCheckingCache)
@@ -1155,6 +1257,8 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModule(
 {
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
+    _enforceModuleMemoryBudget();
+
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
@@ -1168,6 +1272,8 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModule(
         auto name = getNamePool()->getName(moduleName);
 
         auto module = findOrImportModule(name, SourceLoc(), &sink);
+        _noteModuleUse(module);
+        recordMemoryUsage("load module");
         sink.getBlobIfNeeded(outDiagnostics);
 
         return asExternal(module);
@@ -1189,6 +1295,8 @@ slang::IModule* Linkage::loadModuleFromBlob(
 {
     SLANG_AST_BUILDER_RAII(getASTBuilder());
 
+    _enforceModuleMemoryBudget();
+
     DiagnosticSink sink(getSourceManager(), Lexer::sourceLocationLexer);
     applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
 
@@ -1215,7 +1323,20 @@ slang::IModule* Linkage::loadModuleFromBlob(
         RefPtr<LoadedModule> loadedModule;
         if (mapNameToLoadedModules.tryGetValue(name, loadedModule))
         {
-            return loadedModule;
+            if (!loadedModule || _isModuleCompatibleWithCurrentDefinitions(loadedModule))
+            {
+                _noteModuleUse(loadedModule);
+                return loadedModule;
+            }
+
+            // The module was parsed under preprocessor definitions that would
+            // produce a different result now.
+            _deactivateModule(name, loadedModule);
+            if (auto compatibleModule = _reactivateCompatibleModule(name))
+            {
+                _noteModuleUse(compatibleModule);
+                return asExternal(compatibleModule);
+            }
         }
         String pathStr = path;
         if (pathStr.getLength() == 0)
@@ -1240,6 +1361,8 @@ slang::IModule* Linkage::loadModuleFromBlob(
             &sink,
             nullptr,
             blobType);
+        _noteModuleUse(module);
+        recordMemoryUsage("load module");
         sink.getBlobIfNeeded(outDiagnostics);
         return asExternal(module);
 
@@ -1595,7 +1718,9 @@ SLANG_NO_THROW SlangInt SLANG_MCALL Linkage::getLoadedModuleCount()
 SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::getLoadedModule(SlangInt index)
 {
     if (index >= 0 && index < loadedModulesList.getCount())
+    {
         return loadedModulesList[index].get();
+    }
     return nullptr;
 }
 
@@ -1941,12 +2066,15 @@ Scope* TranslationUnitRequest::getLanguageScope()
     return languageScope;
 }
 
-Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefinitions()
+static Dictionary<String, String> _getCombinedPreprocessorDefinitions(
+    Dictionary<String, String> const&   translationUnitDefinitions,
+    CompilerOptionSet&                  optionSet,
+    SourceLanguage                      sourceLanguage)
 {
     Dictionary<String, String> combinedPreprocessorDefinitions;
-    for (const auto& def : preprocessorDefinitions)
+    for (const auto& def : translationUnitDefinitions)
         combinedPreprocessorDefinitions.addIfNotExists(def);
-    for (const auto& def : compileRequest->optionSet.getArray(CompilerOptionName::MacroDefine))
+    for (const auto& def : optionSet.getArray(CompilerOptionName::MacroDefine))
         combinedPreprocessorDefinitions.addIfNotExists(def.stringValue, def.stringValue2);
 
     // Define standard macros, if not already defined. This style assumes using `#if __SOME_VAR` style, as in
@@ -1987,6 +2115,11 @@ Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefini
     return combinedPreprocessorDefinitions;
 }
 
+Dictionary<String, String> TranslationUnitRequest::getCombinedPreprocessorDefinitions()
+{
+    return _getCombinedPreprocessorDefinitions(preprocessorDefinitions, compileRequest->optionSet, sourceLanguage);
+}
+
 void TranslationUnitRequest::addSourceArtifact(IArtifact* sourceArtifact)
 {
     SLANG_ASSERT(sourceArtifact);
@@ -2618,6 +2751,17 @@ protected:
                 addModifier(moduleDecl, modifier);
             }
         }
+
+        // The third task is recording which macros the source of the module
+        // actually looked at, so that the linkage can tell whether the module
+        // can be reused when it is imported under different preprocessor
+        // definitions.
+        //
+        // Note: This is done last so that the lookups made above are included.
+        //
+        auto& footprint = m_module->getPreprocessorFootprint();
+        for (auto name : getConsultedMacroNames(preprocessor))
+            footprint.consultedMacroNames.add(name);
     }
 
         /// Validate that a re-defintion of an NVAPI-related macro matches any previous definition
@@ -2818,6 +2962,13 @@ void FrontEndCompileRequest::parseTranslationUnit(
     
     auto module = translationUnit->getModule();
 
+    // The names of the macros consulted are filled in by the `FrontEndPreprocessorHandler`
+    // as each source file is preprocessed.
+    auto& preprocessorFootprint = module->getPreprocessorFootprint();
+    preprocessorFootprint.isRecorded = true;
+    preprocessorFootprint.sourceLanguage = translationUnit->sourceLanguage;
+    preprocessorFootprint.definitions = combinedPreprocessorDefinitions;
+
     ASTBuilder* astBuilder = module->getASTBuilder();
 
     ModuleDecl* translationUnitSyntax = astBuilder->create<ModuleDecl>();
@@ -3271,6 +3422,7 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     if (m_passThrough == PassThroughMode::None)
     {
         SLANG_RETURN_ON_FAIL(getFrontEndReq()->executeActionsInner());
+        getLinkage()->recordMemoryUsage("front end");
     }
 
     if (getOptionSet().getBoolOption(CompilerOptionName::PreprocessorOutput))
@@ -3316,6 +3468,19 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         }
     }
 
+    // If permutations of the program were requested, we generate
+    // code for each of them, rather than for the program as
+    // specialized by the request itself.
+    //
+    if (m_passThrough == PassThroughMode::None && m_permutationArgStrings.getCount() != 0)
+    {
+        m_specializedGlobalComponentType = getUnspecializedGlobalComponentType();
+        m_specializedGlobalAndEntryPointsComponentType = getUnspecializedGlobalAndEntryPointsComponentType();
+        m_specializedEntryPoints = getFrontEndReq()->getUnspecializedEntryPoints();
+
+        return generatePermutationOutput();
+    }
+
     // If codegen is enabled, we need to move along to
     // apply any generic specialization that the user asked for.
     //
@@ -3371,6 +3536,7 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
 
     // Generate output code, in whatever format was requested
     generateOutput();
+    getLinkage()->recordMemoryUsage("code generation");
     if (getSink()->getErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -3552,8 +3718,8 @@ void Linkage::loadParsedModule(
     String mostUniqueIdentity = pathInfo.getMostUniqueIdentity();
     SLANG_ASSERT(mostUniqueIdentity.getLength() > 0);
 
-    mapPathToLoadedModule.add(mostUniqueIdentity, loadedModule);
-    mapNameToLoadedModules.add(name, loadedModule);
+    mapPathToLoadedModule.set(mostUniqueIdentity, loadedModule);
+    mapNameToLoadedModules.set(name, loadedModule);
 
     auto sink = translationUnit->compileRequest->getSink();
 
@@ -3636,11 +3802,16 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     if (m_optionSet.getBoolOption(CompilerOptionName::UseUpToDateBinaryModule))
     {
         if (!isBinaryModuleUpToDate(filePathInfo.foundPath, &container))
+        {
+            // The module will be compiled from source instead. Its functions that haven't
+            // changed since this binary was written don't need to be lowered again.
+            _addIRReuseSource(name, &container, sink);
             return nullptr;
+        }
     }
 
-    mapPathToLoadedModule.add(mostUniqueIdentity, resultModule);
-    mapNameToLoadedModules.add(name, resultModule);
+    mapPathToLoadedModule.set(mostUniqueIdentity, resultModule);
+    mapNameToLoadedModules.set(name, resultModule);
 
     SerialContainerUtil::ReadOptions readOptions;
     readOptions.linkage = this;
@@ -3651,6 +3822,9 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     readOptions.sourceManager = getSourceManager();
     readOptions.namePool = getNamePool();
     readOptions.modulePath = filePathInfo.foundPath;
+    // Most code that links against a precompiled module only uses a small part of it,
+    // so function bodies are only decoded once the linker needs them.
+    readOptions.deferIRFunctionBodies = true;
     SerialContainerData containerData;
     if (SLANG_FAILED(SerialContainerUtil::read(&container, readOptions, additionalLoadedModules, containerData)) ||
         containerData.modules.getCount() != 1)
@@ -3668,6 +3842,41 @@ RefPtr<Module> Linkage::loadModuleFromIRBlobImpl(
     return resultModule;
 }
 
+void Linkage::_addIRReuseSource(Name* name, RiffContainer* container, DiagnosticSink* sink)
+{
+    SerialContainerUtil::ReadOptions readOptions;
+    readOptions.linkage = this;
+    readOptions.astBuilder = getASTBuilder();
+    readOptions.session = getSessionImpl();
+    readOptions.sharedASTBuilder = getASTBuilder()->getSharedASTBuilder();
+    readOptions.sink = sink;
+    readOptions.sourceManager = getSourceManager();
+    readOptions.namePool = getNamePool();
+    readOptions.skipASTModules = true;
+    SerialContainerData containerData;
+    if (SLANG_FAILED(SerialContainerUtil::read(container, readOptions, nullptr, containerData)) ||
+        containerData.modules.getCount() != 1)
+    {
+        return;
+    }
+    auto& moduleEntry = containerData.modules.getFirst();
+    if (!moduleEntry.irModule || !moduleEntry.irReuseDigests.isRecorded)
+        return;
+
+    RefPtr<IRReuseSource> reuseSource = new IRReuseSource();
+    reuseSource->digests = moduleEntry.irReuseDigests;
+    reuseSource->irModule = moduleEntry.irModule;
+    m_irReuseSources[name] = reuseSource;
+}
+
+RefPtr<IRReuseSource> Linkage::takeIRReuseSource(Name* name)
+{
+    RefPtr<IRReuseSource> reuseSource;
+    if (m_irReuseSources.tryGetValue(name, reuseSource))
+        m_irReuseSources.remove(name);
+    return reuseSource;
+}
+
 Module* Linkage::loadModule(String const& name)
 {
     // TODO: We either need to have a diagnostics sink
@@ -3694,6 +3903,9 @@ void Linkage::_diagnoseErrorInImportedModule(
     }
 }
 
+// Most modules are much smaller than the blocks of the linkage's `ASTBuilder`.
+static const size_t kModuleASTBuilderArenaBlockSize = 64 * 1024;
+
 RefPtr<Module> Linkage::loadModule(
     Name*               name,
     const PathInfo&     filePathInfo,
@@ -3712,6 +3924,14 @@ RefPtr<Module> Linkage::loadModule(
 
     RefPtr<TranslationUnitRequest> translationUnit = new TranslationUnitRequest(frontEndReq);
     translationUnit->compileRequest = frontEndReq;
+
+    // With a memory budget, the module is parsed into an `ASTBuilder` of its own, so that
+    // its AST is released if the module is unloaded.
+    if (m_optionSet.getIntOption(CompilerOptionName::ModuleMemoryBudget) > 0)
+    {
+        translationUnit->module = new Module(this, ASTBuilder::createModuleBuilder(getASTBuilder(), "Module::m_astBuilder", kModuleASTBuilderArenaBlockSize));
+    }
+
     translationUnit->setModuleName(name);
     Stage impliedStage;
     translationUnit->sourceLanguage = SourceLanguage::Slang;
@@ -3816,6 +4036,226 @@ bool Linkage::isBeingImported(Module* module)
     return false;
 }
 
+Dictionary<String, String> Linkage::getImportPreprocessorDefinitions(SourceLanguage sourceLanguage)
+{
+    // An imported module is parsed as a translation unit of its own, without any
+    // translation-unit specific definitions, by a front-end request that inherits
+    // the options of the linkage (see `loadModule`).
+    //
+    return _getCombinedPreprocessorDefinitions(Dictionary<String, String>(), m_optionSet, sourceLanguage);
+}
+
+bool Linkage::_isModuleCompatibleWithCurrentDefinitions(Module* module)
+{
+    auto isFootprintCompatible = [&](Module* m)
+    {
+        // Modules shared from another linkage (e.g., the builtin modules) were
+        // not parsed under our definitions, and are never re-parsed by us.
+        if (m->getLinkage() != this)
+            return true;
+
+        auto& footprint = m->getPreprocessorFootprint();
+        if (!footprint.isRecorded)
+            return true;
+        return footprint.isCompatibleWith(getImportPreprocessorDefinitions(footprint.sourceLanguage), getNamePool());
+    };
+
+    if (!isFootprintCompatible(module))
+        return false;
+
+    // The module was checked against the modules it imports, so it can only be
+    // reused if those would be reused too. Otherwise a program could end up
+    // with two different versions of the same imported module.
+    //
+    // Note: The dependency list is already transitive.
+    //
+    for (auto dependency : module->getModuleDependencyList())
+    {
+        if (dependency != module && !isFootprintCompatible(dependency))
+            return false;
+    }
+    return true;
+}
+
+void Linkage::_deactivateModule(Name* name, Module* module)
+{
+    RefPtr<LoadedModule> mappedModule;
+    if (mapNameToLoadedModules.tryGetValue(name, mappedModule) && mappedModule.get() == module)
+        mapNameToLoadedModules.remove(name);
+
+    String mostUniqueIdentity = module->getPathInfo().getMostUniqueIdentity();
+    if (mapPathToLoadedModule.tryGetValue(mostUniqueIdentity, mappedModule) && mappedModule.get() == module)
+        mapPathToLoadedModule.remove(mostUniqueIdentity);
+
+    if (loadedModulesList.contains(module))
+    {
+        m_inactiveModules.add(module);
+        loadedModulesList.remove(module);
+    }
+}
+
+Module* Linkage::_reactivateCompatibleModule(Name* name)
+{
+    for (Index i = 0; i < m_inactiveModules.getCount(); ++i)
+    {
+        RefPtr<LoadedModule> module = m_inactiveModules[i];
+        if (module->getNameObj() != name || !_isModuleCompatibleWithCurrentDefinitions(module))
+            continue;
+
+        m_inactiveModules.removeAt(i);
+
+        loadedModulesList.add(module);
+        mapNameToLoadedModules.set(name, module);
+        mapPathToLoadedModule.set(module->getPathInfo().getMostUniqueIdentity(), module);
+        return module;
+    }
+    return nullptr;
+}
+
+void Linkage::_noteModuleUse(Module* module)
+{
+    if (!module)
+        return;
+
+    // The dependency list includes the module itself.
+    auto tick = ++m_moduleUseTick;
+    for (auto dependency : module->getModuleDependencyList())
+        dependency->setLastUseTick(tick);
+}
+
+bool Linkage::_canUnloadModule(Module* module, Dictionary<Module*, Index> const& dependentCounts)
+{
+    if (isBeingImported(module))
+        return false;
+
+    // A module that another loaded module was checked against has to stay,
+    // because the AST and IR of the other module refer to it.
+    //
+    if (auto dependentCount = dependentCounts.tryGetValue(module))
+    {
+        if (*dependentCount > 0)
+            return false;
+    }
+
+    // Any reference that isn't one of the linkage's own is from a component type,
+    // compile request or the application, which may still use the module. A module the
+    // application doesn't hold a reference to can be unloaded, even if it was returned
+    // to it.
+    //
+    UInt linkageReferenceCount = 0;
+    for (auto& loadedModule : loadedModulesList)
+        linkageReferenceCount += (loadedModule.get() == module);
+    for (auto& inactiveModule : m_inactiveModules)
+        linkageReferenceCount += (inactiveModule.get() == module);
+    for (auto& [_, value] : mapNameToLoadedModules)
+        linkageReferenceCount += (value.get() == module);
+    for (auto& [_, value] : mapPathToLoadedModule)
+        linkageReferenceCount += (value.get() == module);
+
+    return module->debugGetReferenceCount() == linkageReferenceCount;
+}
+
+void Linkage::_unloadModule(Module* module)
+{
+    // Keeps the module alive until it has been removed from everything.
+    RefPtr<Module> unloadedModule = module;
+
+    // The AST of a module that shares the linkage's `ASTBuilder` is not released
+    // along with it, so only a module with its own builder can leave the linkage
+    // caches below, and the `Val` cache of the linkage's builder, pointing at
+    // released declarations.
+    //
+    if (module->getASTBuilder() != getASTBuilder())
+    {
+        destroyTypeCheckingCache();
+        m_containerTypes.clear();
+        getASTBuilder()->removeValsReferencing(module->getASTBuilder());
+    }
+
+    if (auto moduleDecl = module->getModuleDecl())
+        moduleDecl->module = nullptr;
+
+    List<Name*> names;
+    for (auto& [name, value] : mapNameToLoadedModules)
+    {
+        if (value.get() == module)
+            names.add(name);
+    }
+    for (auto name : names)
+        mapNameToLoadedModules.remove(name);
+
+    List<String> paths;
+    for (auto& [path, value] : mapPathToLoadedModule)
+    {
+        if (value.get() == module)
+            paths.add(path);
+    }
+    for (auto& path : paths)
+        mapPathToLoadedModule.remove(path);
+
+    m_inactiveModules.remove(module);
+    loadedModulesList.remove(module);
+}
+
+void Linkage::_enforceModuleMemoryBudget()
+{
+    const auto budgetInKB = m_optionSet.getIntOption(CompilerOptionName::ModuleMemoryBudget);
+    if (budgetInKB <= 0 || m_modulesBeingImported)
+        return;
+
+    const size_t budget = size_t(budgetInKB) * 1024;
+    size_t usage = 0;
+    for (auto& loadedModule : loadedModulesList)
+        usage += loadedModule->getMemoryUsage();
+    for (auto& inactiveModule : m_inactiveModules)
+        usage += inactiveModule->getMemoryUsage();
+    if (usage <= budget)
+        return;
+
+    // Count the modules that depend on each module. The dependency list of a module
+    // includes the module itself, which doesn't count.
+    //
+    Dictionary<Module*, Index> dependentCounts;
+    auto addDependents = [&](Module* module, Index delta)
+    {
+        for (auto dependency : module->getModuleDependencyList())
+        {
+            if (dependency != module)
+                dependentCounts[dependency] += delta;
+        }
+    };
+    for (auto& loadedModule : loadedModulesList)
+        addDependents(loadedModule, 1);
+    for (auto& inactiveModule : m_inactiveModules)
+        addDependents(inactiveModule, 1);
+
+    while (usage > budget)
+    {
+        Module* leastRecentlyUsed = nullptr;
+        auto consider = [&](Module* module)
+        {
+            if (leastRecentlyUsed && leastRecentlyUsed->getLastUseTick() <= module->getLastUseTick())
+                return;
+            if (_canUnloadModule(module, dependentCounts))
+                leastRecentlyUsed = module;
+        };
+        for (auto& loadedModule : loadedModulesList)
+            consider(loadedModule);
+        for (auto& inactiveModule : m_inactiveModules)
+            consider(inactiveModule);
+
+        if (!leastRecentlyUsed)
+            break;
+
+        // Unloading a module can make the modules it imported unloadable too.
+        addDependents(leastRecentlyUsed, -1);
+        dependentCounts.remove(leastRecentlyUsed);
+
+        usage -= leastRecentlyUsed->getMemoryUsage();
+        _unloadModule(leastRecentlyUsed);
+    }
+}
+
     // Derive a file name for the module, by taking the given
     // identifier, replacing all occurrences of `_` with `-`,
     // and then appending `.slang`.
@@ -3873,7 +4313,17 @@ RefPtr<Module> Linkage::findOrImportModule(
             return nullptr;
         }
 
-        return loadedModule;
+        if (_isModuleCompatibleWithCurrentDefinitions(loadedModule))
+            return loadedModule;
+
+        // The preprocessor definitions have changed since the module was
+        // loaded, in a way that could affect its source. We set it aside
+        // (it may become usable again later), and either reuse an earlier
+        // compatible load or load the module again below.
+        //
+        _deactivateModule(name, loadedModule);
+        if (auto compatibleModule = _reactivateCompatibleModule(name))
+            return compatibleModule;
     }
 
     // If the user is providing an additional list of loaded modules, we find
@@ -3936,7 +4386,14 @@ RefPtr<Module> Linkage::findOrImportModule(
 
             // Maybe this was loaded previously at a different relative name?
             if (mapPathToLoadedModule.tryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
-                return loadedModule;
+            {
+                if (_isModuleCompatibleWithCurrentDefinitions(loadedModule))
+                    return loadedModule;
+                auto loadedName = loadedModule->getNameObj();
+                _deactivateModule(loadedName, loadedModule);
+                if (auto compatibleModule = _reactivateCompatibleModule(loadedName))
+                    return compatibleModule;
+            }
 
             // Try to load it
             if (!fileContents && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
@@ -4017,17 +4474,67 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
         }
     }
 
-    for (auto file : moduleHeader.dependentFiles)
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+
+    // Files can only be checked with `stat` when they come from the OS file system.
+    const bool canStatFiles = (m_fileSystem == nullptr);
+
+    for (Index i = 0; i < moduleHeader.dependentFiles.getCount(); ++i)
     {
-        auto sourceFile = loadSourceFile(fromPath, file);
-        if (!sourceFile)
+        const auto& file = moduleHeader.dependentFiles[i];
+
+        PathInfo pathInfo;
+        if (SLANG_FAILED(includeSystem.findFile(file, fromPath, pathInfo)))
         {
             // If we cannot find the source file from `fromPath`,
             // try again from the module's source file path.
-            if (moduleHeader.dependentFiles.getCount() != 0)
-                sourceFile = loadSourceFile(moduleSrcPath, file);
+            if (SLANG_FAILED(includeSystem.findFile(file, moduleSrcPath, pathInfo)))
+                return false;
         }
-        if (!sourceFile)
+
+        if (canStatFiles && pathInfo.hasFileFoundPath())
+        {
+            // If the file has the same size and modification time as when the module was
+            // compiled, or as when it was last hashed by any linkage in this process, we can
+            // avoid reading and hashing it again.
+            File::Stat stat;
+            String canonicalPath;
+            if (SLANG_SUCCEEDED(File::getStat(pathInfo.foundPath, stat)) && stat.modifiedTime != 0)
+            {
+                if (i < moduleHeader.dependentFileStates.getCount() &&
+                    moduleHeader.dependentFileStates[i].stat == stat)
+                {
+                    digestBuilder.append(moduleHeader.dependentFileStates[i].digest);
+                    continue;
+                }
+
+                SHA1::Digest fileDigest;
+                if (SLANG_SUCCEEDED(Path::getCanonical(pathInfo.foundPath, canonicalPath)) &&
+                    SourceFileDigestCache::getSingleton().tryGetDigest(canonicalPath, stat, fileDigest))
+                {
+                    digestBuilder.append(fileDigest);
+                    continue;
+                }
+            }
+
+            // Read the file from disk rather than through the linkage, whose source manager and
+            // file system may hold contents read before the file last changed, and so don't
+            // match the stat.
+            SHA1::Digest fileDigest;
+            if (SLANG_SUCCEEDED(SourceFileDigestCache::readFile(pathInfo.foundPath, stat, fileDigest)))
+            {
+                if (canonicalPath.getLength() && stat.modifiedTime != 0)
+                {
+                    SourceFileDigestCache::getSingleton().addDigest(canonicalPath, stat, fileDigest);
+                }
+                digestBuilder.append(fileDigest);
+                continue;
+            }
+        }
+
+        ComPtr<slang::IBlob> blob;
+        SourceFile* sourceFile = nullptr;
+        if (SLANG_FAILED(includeSystem.loadFile(pathInfo, blob, sourceFile)) || !sourceFile)
             return false;
         digestBuilder.append(sourceFile->getDigest());
     }
@@ -4275,6 +4782,23 @@ SHA1::Digest Module::computeDigest()
     return m_digest;
 }
 
+IRReuseDigests const& Module::getIRReuseDigests()
+{
+    if (!m_irReuseDigests.isRecorded)
+        computeIRReuseDigests(this, m_irReuseDigests);
+    return m_irReuseDigests;
+}
+
+size_t Module::getMemoryUsage()
+{
+    size_t usage = 0;
+    if (m_irModule)
+        usage += m_irModule->getMemoryArena().calcTotalMemoryAllocated();
+    if (m_astBuilder && m_astBuilder.get() != getLinkage()->getASTBuilder())
+        usage += m_astBuilder->getArena().calcTotalMemoryAllocated();
+    return usage;
+}
+
 void Module::addModuleDependency(Module* module)
 {
     m_moduleDependencyList.addDependency(module);
@@ -4286,6 +4810,35 @@ void Module::addFileDependency(SourceFile* sourceFile)
     m_fileDependencyList.addDependency(sourceFile);
 }
 
+bool PreprocessorFootprint::isCompatibleWith(Dictionary<String, String> const& otherDefinitions, NamePool* namePool) const
+{
+    // Any name that was looked up was interned by the lexer, so a definition
+    // whose name isn't in the pool cannot have been consulted.
+    auto isConsulted = [&](String const& macroName)
+    {
+        auto name = namePool->tryGetName(macroName);
+        return name && consultedMacroNames.contains(name);
+    };
+
+    // Every consulted definition we were parsed with must still have the same value...
+    for (const auto& [macroName, value] : definitions)
+    {
+        if (!isConsulted(macroName))
+            continue;
+        auto otherValue = otherDefinitions.tryGetValue(macroName);
+        if (!otherValue || *otherValue != value)
+            return false;
+    }
+
+    // ...and no consulted name may have gained a definition.
+    for (const auto& [macroName, value] : otherDefinitions)
+    {
+        if (isConsulted(macroName) && !definitions.containsKey(macroName))
+            return false;
+    }
+    return true;
+}
+
 void Module::setModuleDecl(ModuleDecl* moduleDecl)
 {
     m_moduleDecl = moduleDecl;
@@ -4458,6 +5011,10 @@ ISlangUnknown* ComponentType::getInterface(Guid const& guid)
     {
         return static_cast<slang::IComponentType*>(this);
     }
+    if(guid == slang::IComponentType2::getTypeGuid())
+    {
+        return static_cast<slang::IComponentType2*>(this);
+    }
     return nullptr;
 }
 
@@ -4601,6 +5158,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCode(
 
     IArtifact* artifact = targetProgram->getOrCreateEntryPointResult(entryPointIndex, &sink);
     sink.getBlobIfNeeded(outDiagnostics);
+    linkage->recordMemoryUsage("code generation");
 
     if(artifact == nullptr)
         return SLANG_FAIL;
@@ -4794,6 +5352,221 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::linkWithOptions(
     return SLANG_OK;
 }
 
+SlangResult ComponentType::generateEntryPointPermutations(
+    Index                           entryPointIndex,
+    TargetRequest*                  target,
+    List<Permutation> const&        permutations,
+    DiagnosticSink*                 sink,
+    List<ComPtr<IArtifact>>&        outArtifacts)
+{
+    SLANG_PROFILE;
+
+    auto linkage = getLinkage();
+
+    outArtifacts.clear();
+    outArtifacts.setCount(permutations.getCount());
+
+    // Everything that doesn't depend on the permutation is done once
+    // up front: the program is linked against its dependencies, so
+    // that every variant shares the same IR modules (and with them,
+    // the symbol index each module builds for IR linking).
+    //
+    RefPtr<ComponentType> linkedProgram = fillRequirements(this);
+    if (!linkedProgram)
+        return SLANG_FAIL;
+    if (linkedProgram.get() != this)
+        linkedProgram->getOptionSet().overrideWith(getOptionSet());
+
+    if (entryPointIndex < 0 || entryPointIndex >= linkedProgram->getEntryPointCount())
+        return SLANG_E_INVALID_ARG;
+
+    // The IR of every variant is linked from the stdlib and the modules
+    // of the linked program, along with the few modules that are specific
+    // to the variant. Which definition is linked for each symbol in the
+    // shared modules is decided once, in a cache that the links of all
+    // of the variants use.
+    //
+    auto session = linkage->getSessionImpl();
+    auto linkedTargetProgram = linkedProgram->getTargetProgram(target);
+    initializeSharedLinkCache(
+        linkedTargetProgram->getLinkCache(),
+        session,
+        target,
+        linkedProgram,
+        permutations.getCount());
+
+    // Code generation for the variants runs one at a time, as the IR
+    // and AST they share can only be used by one thread. Their downstream
+    // compiles are queued, and run together on the session's thread pool
+    // once the code for all of them has been generated.
+    //
+    Count downstreamJobCount = linkedProgram->getOptionSet().getIntOption(CompilerOptionName::DownstreamJobs);
+    if (downstreamJobCount <= 0)
+        downstreamJobCount = session->getThreadPool()->getWorkerCount() + 1;
+    DownstreamCompileQueue downstreamCompileQueue(downstreamJobCount);
+
+    // The variants must be kept alive until the queue has been run, as it
+    // writes the results into their target programs.
+    //
+    List<RefPtr<ComponentType>> variants;
+    variants.setCount(permutations.getCount());
+
+    SlangResult result = SLANG_OK;
+    for (Index pp = 0; pp < permutations.getCount(); ++pp)
+    {
+        auto& permutation = permutations[pp];
+        const auto errorCount = sink->getErrorCount();
+
+        // Any link-time components (such as modules that define
+        // link-time constants) are composed with the linked program,
+        // along with whatever they require that it doesn't provide.
+        //
+        RefPtr<ComponentType> variant = linkedProgram;
+        if (permutation.linkTimeComponents.getCount() != 0)
+        {
+            List<RefPtr<ComponentType>> components;
+            components.add(linkedProgram);
+            components.addRange(permutation.linkTimeComponents);
+
+            variant = fillRequirements(CompositeComponentType::create(linkage, components));
+            variant->getOptionSet().overrideWith(linkedProgram->getOptionSet());
+        }
+
+        auto specializationParamCount = variant->getSpecializationParamCount();
+        if (permutation.specializationArgs.getCount() != specializationParamCount)
+        {
+            sink->diagnose(SourceLoc(), Diagnostics::mismatchSpecializationArguments,
+                specializationParamCount,
+                permutation.specializationArgs.getCount());
+            result = SLANG_FAIL;
+            continue;
+        }
+
+        variant = variant->specialize(
+            permutation.specializationArgs.getBuffer(),
+            permutation.specializationArgs.getCount(),
+            sink);
+        if (!variant || sink->getErrorCount() != errorCount)
+        {
+            result = SLANG_FAIL;
+            continue;
+        }
+
+        auto targetProgram = variant->getTargetProgram(target);
+        if (targetProgram != linkedTargetProgram)
+            targetProgram->setSharedLinkCache(linkedTargetProgram->getLinkCache());
+
+        // The queue holds a pointer into the results, so there must be space for them up front.
+        targetProgram->reserveEntryPointResults(entryPointIndex + 1);
+        variants[pp] = variant;
+
+        if (targetProgram->getExistingEntryPointResult(entryPointIndex))
+            continue;
+
+        if (!targetProgram->getOrCreateIRModuleForLayout(sink))
+        {
+            variants[pp] = nullptr;
+            result = SLANG_FAIL;
+            continue;
+        }
+
+        targetProgram->_createEntryPointResult(
+            entryPointIndex,
+            sink,
+            nullptr,
+            targetProgram->canQueueDownstreamCompiles() ? &downstreamCompileQueue : nullptr);
+    }
+
+    downstreamCompileQueue.run(session, sink);
+
+    for (Index pp = 0; pp < permutations.getCount(); ++pp)
+    {
+        if (!variants[pp])
+            continue;
+
+        auto targetProgram = variants[pp]->getTargetProgram(target);
+        IArtifact* artifact = targetProgram->getExistingEntryPointResult(entryPointIndex);
+        if (!artifact)
+        {
+            result = SLANG_FAIL;
+            continue;
+        }
+        outArtifacts[pp] = artifact;
+    }
+
+    return result;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getEntryPointCodeForPermutations(
+    SlangInt                        entryPointIndex,
+    SlangInt                        targetIndex,
+    slang::PermutationDesc const*   permutations,
+    SlangInt                        permutationCount,
+    slang::IBlob**                  outCodes,
+    slang::IBlob**                  outDiagnostics)
+{
+    auto linkage = getLinkage();
+    if(targetIndex < 0 || targetIndex >= linkage->targets.getCount())
+        return SLANG_E_INVALID_ARG;
+    auto target = linkage->targets[targetIndex];
+
+    SLANG_AST_BUILDER_RAII(linkage->getASTBuilder());
+
+    List<Permutation> internalPermutations;
+    for (SlangInt pp = 0; pp < permutationCount; ++pp)
+    {
+        auto& desc = permutations[pp];
+
+        Permutation permutation;
+        for (SlangInt aa = 0; aa < desc.specializationArgCount; ++aa)
+        {
+            auto apiArg = desc.specializationArgs[aa];
+
+            SpecializationArg arg;
+            switch (apiArg.kind)
+            {
+            case slang::SpecializationArg::Kind::Type:
+                arg.val = asInternal(apiArg.type);
+                break;
+
+            default:
+                return SLANG_E_INVALID_ARG;
+            }
+            permutation.specializationArgs.add(arg);
+        }
+        for (SlangInt cc = 0; cc < desc.linkTimeComponentCount; ++cc)
+        {
+            permutation.linkTimeComponents.add(asInternal(desc.linkTimeComponents[cc]));
+        }
+        internalPermutations.add(permutation);
+    }
+
+    DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+    applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
+    applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+
+    List<ComPtr<IArtifact>> artifacts;
+    SlangResult result = generateEntryPointPermutations(
+        entryPointIndex,
+        target,
+        internalPermutations,
+        &sink,
+        artifacts);
+    sink.getBlobIfNeeded(outDiagnostics);
+
+    for (SlangInt pp = 0; pp < permutationCount; ++pp)
+    {
+        outCodes[pp] = nullptr;
+        if (pp < artifacts.getCount() && artifacts[pp])
+        {
+            if (SLANG_FAILED(artifacts[pp]->loadBlob(ArtifactKeep::Yes, &outCodes[pp])))
+                result = SLANG_FAIL;
+        }
+    }
+
+    return result;
+}
+
     /// Visitor used by `ComponentType::enumerateModules`
 struct EnumerateModulesVisitor : ComponentTypeVisitor
 {
@@ -5680,6 +6453,7 @@ void Linkage::prepareDeserializedModule(SerialContainerData::Module& moduleEntry
     }
     module->setPathInfo(filePathInfo);
     module->setDigest(moduleEntry.digest);
+    module->setIRReuseDigests(moduleEntry.irReuseDigests);
     module->_collectShaderParams();
     module->_discoverEntryPoints(sink, targets);
 
@@ -5802,6 +6576,7 @@ Session::~Session()
     globalAstBuilder.setNull();
 
     // destroy modules next
+    m_targetStdLibIRs = decltype(m_targetStdLibIRs)();
     stdlibModules = decltype(stdlibModules)();
 }
 
@@ -6442,8 +7217,26 @@ SlangResult EndToEndCompileRequest::compile()
         StringBuilder perfResult;
         PerformanceProfiler::getProfiler()->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+
+        const auto valCacheStats = getLinkage()->getASTBuilder()->m_cachedNodes.getStats();
+        perfResult << "Val Cache: " << valCacheStats.nodeCount << " nodes, ";
+        perfResult << valCacheStats.largestShardNodeCount << " in the largest of " << valCacheStats.shardCount << " shards, ";
+        perfResult << valCacheStats.lookupCount << " lookups, ";
+        perfResult << String(valCacheStats.getHitRate() * 100.0, "%.1f") << "% hit rate\n";
+        perfResult << "Reused Function Bodies: " << getLinkage()->getReusedFuncBodyCount() << "\n";
+        const auto stdLibSpvSnippets = getSession()->getStdLibSpvSnippets();
+        perfResult << "SPIR-V Snippets: " << (stdLibSpvSnippets ? stdLibSpvSnippets->getCount() : 0) << " loaded with the stdlib, ";
+        perfResult << getSession()->getParsedSpvSnippetCount() << " parsed while emitting\n";
         getSink()->diagnose(SourceLoc(), Diagnostics::performanceBenchmarkResult, perfResult.produceString());
     }
+    if (getOptionSet().getBoolOption(CompilerOptionName::ReportMemory))
+    {
+        MemoryUsageSnapshot currentMemoryUsage;
+        getLinkage()->collectMemoryUsage(currentMemoryUsage);
+        StringBuilder memoryReport;
+        getLinkage()->getMemoryReport().writeText(currentMemoryUsage, memoryReport);
+        getSink()->diagnose(SourceLoc(), Diagnostics::memoryUsageReport, memoryReport.produceString());
+    }
 
     // Repro dump handling
     {
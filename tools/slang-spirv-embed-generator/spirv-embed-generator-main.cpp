@@ -266,7 +266,7 @@ void writeInfo(
                 String ret;
                 if(i.numOperandTypes)
                 {
-                    ret.append("const static OperandKind operandTypes[] = {");
+                    ret.append("static constexpr OperandKind operandTypes[] = {");
                     String operandTypes;
                     for(Index o = 0; o < i.numOperandTypes; ++o)
                     {
@@ -304,7 +304,7 @@ void writeInfo(
                 return "Spv" + String(info.opNames.dict.getValue(o));
             },
             [](const UnownedStringSlice& i){
-                return "v = UnownedStringSlice{\"" + String(i) + "\"}";
+                return "v = toSlice(\"" + String(i) + "\")";
             },
             w
         );
@@ -373,7 +373,7 @@ void writeInfo(
             "UnownedStringSlice",
             "k1.index",
             [](const UnownedStringSlice& i){
-                return "v = UnownedStringSlice{\"" + String(i) + "\"}";
+                return "v = toSlice(\"" + String(i) + "\")";
             },
             w
         );
@@ -391,7 +391,7 @@ void writeInfo(
                 return String(o.index);
             },
             [](const UnownedStringSlice& i){
-                return "v = UnownedStringSlice{\"" + String(i) + "\"}";
+                return "v = toSlice(\"" + String(i) + "\")";
             },
             w
         );
@@ -0,0 +1,87 @@
+// unit-test-binary-module-up-to-date.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "unit-test-compile-util.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+using namespace Slang;
+
+// Test that a serialized module is only reported as up to date while its source file has the
+// contents it was compiled from, both when the file's size and modification time match the
+// ones recorded in the module, and when they don't and the file has to be hashed.
+
+static bool _isUpToDate(slang::IGlobalSession* globalSession, String const& modulePath, slang::IBlob* moduleBlob)
+{
+    // Use a new session each time, so the source file isn't already loaded
+    auto session = createUnitTestSession(globalSession);
+    return session && session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob);
+}
+
+SLANG_UNIT_TEST(binaryModuleUpToDate)
+{
+    const char* moduleSource = "public float getValue() { return 1.5; }\n";
+    const char* changedModuleSource = "public float getValue() { return 2.75; }\n";
+
+    auto moduleName = "upToDateModule" + String(Process::getId());
+    auto sourcePath = moduleName + ".slang";
+    auto modulePath = moduleName + ".slang-module";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+
+    ComPtr<slang::IBlob> moduleBlob;
+    {
+        File::writeAllText(sourcePath, moduleSource);
+        auto session = createUnitTestSession(globalSession);
+        SLANG_CHECK(session != nullptr);
+        auto module = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+        SLANG_CHECK(module != nullptr);
+        if (module)
+            SLANG_CHECK(module->serialize(moduleBlob.writeRef()) == SLANG_OK);
+    }
+    if (!moduleBlob)
+        return;
+
+    // The file is unchanged, so its size and modification time match
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // Changing the file makes the module out of date
+    File::writeAllText(sourcePath, changedModuleSource);
+    SLANG_CHECK(!_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // Writing back the original contents gives the file a new modification time, so it is
+    // hashed, and then the digest for its new modification time is found without hashing it
+    File::writeAllText(sourcePath, moduleSource);
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+    SLANG_CHECK(_isUpToDate(globalSession, modulePath, moduleBlob));
+
+    // A file that changes after the module is compiled, but before it is serialized, must not
+    // have its new size and modification time recorded alongside the digest of the old contents.
+    ComPtr<slang::IBlob> staleModuleBlob;
+    {
+        auto session = createUnitTestSession(globalSession);
+        auto module = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+        SLANG_CHECK(module != nullptr);
+        File::writeAllText(sourcePath, changedModuleSource);
+        if (module)
+            SLANG_CHECK(module->serialize(staleModuleBlob.writeRef()) == SLANG_OK);
+    }
+    if (staleModuleBlob)
+    {
+        SLANG_CHECK(!_isUpToDate(globalSession, modulePath, staleModuleBlob));
+
+        File::writeAllText(sourcePath, moduleSource);
+        SLANG_CHECK(_isUpToDate(globalSession, modulePath, staleModuleBlob));
+    }
+
+    File::remove(sourcePath);
+}
@@ -0,0 +1,75 @@
+// unit-test-compile-util.h
+#ifndef SLANG_UNIT_TEST_COMPILE_UTIL_H
+#define SLANG_UNIT_TEST_COMPILE_UTIL_H
+
+#include "slang.h"
+#include "slang-com-ptr.h"
+
+#include "../../source/core/slang-string.h"
+
+// Helpers shared by the tests that compile user modules against other modules through the
+// session API.
+
+namespace Slang
+{
+
+    /// Create a session with an HLSL target, that finds modules in the current directory
+inline ComPtr<slang::ISession> createUnitTestSession(
+    slang::IGlobalSession* globalSession,
+    slang::CompilerOptionEntry* optionEntries = nullptr,
+    uint32_t optionEntryCount = 0)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    const char* searchPath = ".";
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.searchPaths = &searchPath;
+    sessionDesc.compilerOptionEntryCount = optionEntryCount;
+    sessionDesc.compilerOptionEntries = optionEntries;
+
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+    /// Load `userSource` as a module named "user", and return the code for its `computeMain` entry point,
+    /// or an empty string if it can't be compiled.
+inline String compileUnitTestUserModule(slang::ISession* session, const char* userSource)
+{
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString("user", "user.slang", userSource, diagnosticBlob.writeRef());
+    if (!module)
+        return String();
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    if (!entryPoint)
+        return String();
+
+    ComPtr<slang::IComponentType> program;
+    slang::IComponentType* components[] = { module, entryPoint.get() };
+    session->createCompositeComponentType(components, 2, program.writeRef(), diagnosticBlob.writeRef());
+    if (!program)
+        return String();
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    program->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    if (!linkedProgram)
+        return String();
+
+    ComPtr<slang::IBlob> code;
+    linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef());
+    if (!code)
+        return String();
+
+    return String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+}
+
+}
+
+#endif
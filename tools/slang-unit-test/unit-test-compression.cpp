@@ -3,6 +3,9 @@
 
 #include "../../source/core/slang-lz4-compression-system.h"
 #include "../../source/core/slang-deflate-compression-system.h"
+#include "../../source/core/slang-riff-file-system.h"
+#include "../../source/core/slang-castable.h"
+#include "../../source/core/slang-thread-pool.h"
 
 using namespace Slang;
 
@@ -12,6 +15,7 @@ static ICompressionSystem* _getCompressionSystem(CompressionSystemType type)
     {
         case CompressionSystemType::Deflate: return DeflateCompressionSystem::getSingleton(); break;
         case CompressionSystemType::LZ4:     return LZ4CompressionSystem::getSingleton(); break;
+        case CompressionSystemType::ChunkedLZ4: return ChunkedLZ4CompressionSystem::getSingleton(); break;
         default: break;
     }
     return nullptr;
@@ -47,3 +51,104 @@ SLANG_UNIT_TEST(compression)
         SLANG_CHECK(::memcmp(src, decompressedData.getBuffer(), srcSize) == 0);
     }
 }
+
+SLANG_UNIT_TEST(chunkedCompression)
+{
+    // Data large enough to be split into blocks for several threads, with a partial last block
+    const size_t blockSize = ChunkedLZ4CompressionSystem::kDefaultBlockSize;
+    const size_t srcSize = blockSize * 8 + 1000;
+    List<Byte> src;
+    src.setCount(srcSize);
+    uint32_t value = 1;
+    for (size_t i = 0; i < srcSize; ++i)
+    {
+        value = value * 1664525 + 1013904223;
+        src[i] = Byte((value >> 24) & 0x0f);
+    }
+
+    // Blocks are processed on the calling thread by the singleton, and on the threads of the pool otherwise
+    RefPtr<ThreadPool> threadPool = new ThreadPool(3);
+    ThreadPool* const threadPools[] = { nullptr, threadPool };
+    for (ThreadPool* pool : threadPools)
+    {
+        ComPtr<ICompressionSystem> system = ChunkedLZ4CompressionSystem::create(pool);
+        CompressionStyle style;
+        ComPtr<ISlangBlob> compressedBlob;
+        SLANG_CHECK(SLANG_SUCCEEDED(system->compress(&style, src.getBuffer(), srcSize, compressedBlob.writeRef())));
+
+        List<Byte> decompressed;
+        decompressed.setCount(srcSize);
+        SLANG_CHECK(SLANG_SUCCEEDED(system->decompress(compressedBlob->getBufferPointer(), compressedBlob->getBufferSize(), srcSize, decompressed.getBuffer())));
+        SLANG_CHECK(::memcmp(src.getBuffer(), decompressed.getBuffer(), srcSize) == 0);
+
+        // Ranges within a block, across blocks, and at the end of the data
+        const size_t ranges[][2] = { { 10, 100 }, { blockSize - 50, blockSize + 100 }, { blockSize, blockSize }, { srcSize - 1500, 1500 } };
+        for (const auto& range : ranges)
+        {
+            List<Byte> part;
+            part.setCount(range[1]);
+            SLANG_CHECK(SLANG_SUCCEEDED(ChunkedLZ4CompressionSystem::decompressRange(
+                compressedBlob->getBufferPointer(), compressedBlob->getBufferSize(), range[0], range[1], part.getBuffer(), pool)));
+            SLANG_CHECK(::memcmp(src.getBuffer() + range[0], part.getBuffer(), range[1]) == 0);
+        }
+
+        // Asking for more data than was compressed fails
+        List<Byte> tooLarge;
+        tooLarge.setCount(srcSize + 10);
+        SLANG_CHECK(SLANG_FAILED(system->decompress(compressedBlob->getBufferPointer(), compressedBlob->getBufferSize(), srcSize + 10, tooLarge.getBuffer())));
+    }
+}
+
+SLANG_UNIT_TEST(chunkedCompressionRiffFileSystem)
+{
+    typedef RiffContainer::ScopeChunk ScopeChunk;
+    typedef RiffContainer::Chunk::Kind Kind;
+
+    const FourCC markThings = SLANG_FOUR_CC('T', 'H', 'I', 'N');
+    const FourCC markData = SLANG_FOUR_CC('D', 'A', 'T', 'A');
+
+    // A small chunk, and one that spans several blocks
+    const char small[] = "Small";
+    List<Byte> large;
+    large.setCount(ChunkedLZ4CompressionSystem::kDefaultBlockSize * 2 + 100);
+    for (Index i = 0; i < large.getCount(); ++i)
+    {
+        large[i] = Byte(i * 7 + (i >> 10));
+    }
+
+    RiffContainer container;
+    {
+        ScopeChunk scopeContainer(&container, Kind::List, markThings);
+        {
+            ScopeChunk scopeChunk(&container, Kind::Data, markData);
+            container.write(small, sizeof(small));
+        }
+        {
+            ScopeChunk scopeChunk(&container, Kind::Data, markData);
+            container.write(large.getBuffer(), large.getCount());
+        }
+    }
+
+    OwnedMemoryStream stream(FileAccess::ReadWrite);
+    SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(container.getRoot(), true, &stream)));
+
+    ComPtr<ISlangMutableFileSystem> fileSystemInterface(new RiffFileSystem(ChunkedLZ4CompressionSystem::getSingleton()));
+    auto fileSystem = as<RiffFileSystem>(fileSystemInterface.get());
+    SLANG_CHECK(SLANG_SUCCEEDED(fileSystem->saveFile("riff", stream.getContents().getBuffer(), stream.getContents().getCount())));
+
+    RiffContainer readContainer;
+    SLANG_CHECK(SLANG_SUCCEEDED(fileSystem->loadFileRiff("riff", readContainer)));
+
+    // The payloads are decompressed when accessed
+    auto listChunk = as<RiffContainer::ListChunk>(readContainer.getRoot());
+    auto smallChunk = listChunk ? as<RiffContainer::DataChunk>(listChunk->getFirstContainedChunk()) : nullptr;
+    auto largeChunk = smallChunk ? as<RiffContainer::DataChunk>(smallChunk->m_next) : nullptr;
+    SLANG_CHECK(largeChunk != nullptr);
+    if (largeChunk)
+    {
+        SLANG_CHECK(largeChunk->isEqual(large.getBuffer(), large.getCount()));
+        SLANG_CHECK(smallChunk->isEqual(small, sizeof(small)));
+    }
+
+    SLANG_CHECK(SLANG_FAILED(fileSystem->loadFileRiff("missing", readContainer)));
+}
@@ -0,0 +1,134 @@
+// unit-test-downstream-compile-cache.cpp
+#include "tools/unit-test/slang-unit-test.h"
+
+#include "../../source/compiler-core/slang-downstream-compiler-util.h"
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-char-util.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// A compiler that 'compiles' by upper casing the source, and reports a warning.
+class UpperCaseDownstreamCompiler : public DownstreamCompilerBase
+{
+public:
+    typedef DownstreamCompilerBase Super;
+
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        m_compileCount++;
+
+        ComPtr<ISlangBlob> sourceBlob;
+        SLANG_RETURN_ON_FAIL(options.sourceArtifacts[0]->loadBlob(ArtifactKeep::No, sourceBlob.writeRef()));
+
+        StringBuilder buf;
+        for (auto c : UnownedStringSlice((const char*)sourceBlob->getBufferPointer(), sourceBlob->getBufferSize()))
+        {
+            buf.appendChar(CharUtil::toUpper(c));
+        }
+
+        auto diagnostics = ArtifactDiagnostics::create();
+        ArtifactDiagnostic diagnostic;
+        diagnostic.severity = ArtifactDiagnostic::Severity::Warning;
+        diagnostic.text = TerminatedCharSlice("upper cased");
+        diagnostic.location.line = 1;
+        diagnostics->add(diagnostic);
+
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+        artifact->addRepresentationUnknown(StringBlob::moveCreate(buf));
+        ArtifactUtil::addAssociated(artifact, diagnostics);
+
+        *outArtifact = artifact.detach();
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE { return false; }
+
+    UpperCaseDownstreamCompiler()
+        : Super(Desc(SLANG_PASS_THROUGH_DXC, SemanticVersion(1, 2, 3)))
+    {
+    }
+
+    Count m_compileCount = 0;
+};
+
+} // anonymous
+
+static ComPtr<IArtifact> _compile(IDownstreamCompiler* compiler, PersistentCache* cache, const char* source, const char* profileName)
+{
+    auto sourceArtifact = ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactKind::Source, ArtifactPayload::HLSL));
+    sourceArtifact->addRepresentationUnknown(StringBlob::create(UnownedStringSlice(source)));
+
+    DownstreamCompileOptions options;
+    options.targetType = SLANG_DXIL;
+    options.sourceLanguage = SLANG_SOURCE_LANGUAGE_HLSL;
+    options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+    options.profileName = TerminatedCharSlice(profileName);
+
+    ComPtr<IArtifact> artifact;
+    SLANG_CHECK(SLANG_SUCCEEDED(DownstreamCompilerUtil::compileWithCache(compiler, options, cache, artifact.writeRef())));
+    return artifact;
+}
+
+static String _getText(IArtifact* artifact)
+{
+    ComPtr<ISlangBlob> blob;
+    if (!artifact || SLANG_FAILED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        return String();
+    return StringUtil::getString(blob);
+}
+
+// Test that a compile with the same source and options reuses the cached result and
+// diagnostics, and that changing either compiles again.
+SLANG_UNIT_TEST(downstreamCompileCache)
+{
+    auto osFileSystem = OSFileSystem::getMutableSingleton();
+    const String cacheDirectory = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/downstream-compile-cache-test" + String(Process::getId()));
+
+    {
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        RefPtr<PersistentCache> cache = new PersistentCache(desc);
+        cache->clear();
+
+        ComPtr<UpperCaseDownstreamCompiler> compiler(new UpperCaseDownstreamCompiler);
+
+        auto first = _compile(compiler, cache, "float4 main()", "ps_6_0");
+        SLANG_CHECK(compiler->m_compileCount == 1);
+        SLANG_CHECK(_getText(first) == "FLOAT4 MAIN()");
+
+        // Same inputs come from the cache, along with the diagnostics
+        auto second = _compile(compiler, cache, "float4 main()", "ps_6_0");
+        SLANG_CHECK(compiler->m_compileCount == 1);
+        SLANG_CHECK(_getText(second) == "FLOAT4 MAIN()");
+        SLANG_CHECK(second->getDesc() == first->getDesc());
+
+        auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(second);
+        SLANG_CHECK(diagnostics && diagnostics->getCount() == 1);
+        if (diagnostics && diagnostics->getCount() == 1)
+        {
+            SLANG_CHECK(asStringSlice(diagnostics->getAt(0)->text) == toSlice("upper cased"));
+            SLANG_CHECK(diagnostics->getAt(0)->severity == ArtifactDiagnostic::Severity::Warning);
+            SLANG_CHECK(diagnostics->getAt(0)->location.line == 1);
+        }
+
+        // A different source or option is a different entry
+        _compile(compiler, cache, "float4 main2()", "ps_6_0");
+        SLANG_CHECK(compiler->m_compileCount == 2);
+        _compile(compiler, cache, "float4 main()", "ps_6_1");
+        SLANG_CHECK(compiler->m_compileCount == 3);
+
+        // No cache just compiles
+        _compile(compiler, nullptr, "float4 main()", "ps_6_0");
+        SLANG_CHECK(compiler->m_compileCount == 4);
+
+        cache->clear();
+    }
+
+    osFileSystem->remove(cacheDirectory.getBuffer());
+}
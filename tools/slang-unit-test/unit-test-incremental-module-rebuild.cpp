@@ -0,0 +1,139 @@
+// unit-test-incremental-module-rebuild.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "unit-test-compile-util.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+// Test that a module whose binary is out of date is compiled again from source correctly,
+// when the functions that didn't change since the binary was written reuse its IR.
+
+static ComPtr<slang::ISession> _createSession(slang::IGlobalSession* globalSession, bool useUpToDateBinaryModule)
+{
+    slang::CompilerOptionEntry optionEntry;
+    optionEntry.name = slang::CompilerOptionName::UseUpToDateBinaryModule;
+    optionEntry.value.intValue0 = 1;
+
+    return createUnitTestSession(globalSession, &optionEntry, useUpToDateBinaryModule ? 1 : 0);
+}
+
+static String _compileUserModule(slang::ISession* session, String const& moduleName)
+{
+    StringBuilder userSource;
+    userSource << "import " << moduleName << ";\n";
+    userSource << R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            float x = float(tid.x);
+            outputBuffer[tid.x] = unchangedFunc(x) + changedFunc(x) + Counter().next(x);
+        }
+        )";
+
+    return compileUnitTestUserModule(session, userSource.getBuffer());
+}
+
+    // Get the number of function bodies the session reused from out of date binary modules,
+    // from the performance report of a compile request that shares the session.
+static Index _getReusedFuncBodyCount(slang::ISession* session)
+{
+    ComPtr<slang::ICompileRequest> request;
+    if (SLANG_FAILED(session->createCompileRequest(request.writeRef())))
+        return -1;
+
+    request->setReportPerfBenchmark(true);
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "empty");
+    request->addTranslationUnitSourceString(translationUnitIndex, "empty.slang", "");
+    if (SLANG_FAILED(request->compile()))
+        return -1;
+
+    const auto prefix = toSlice("Reused Function Bodies: ");
+    String output = request->getDiagnosticOutput();
+    const Index prefixIndex = output.indexOf(prefix);
+    if (prefixIndex < 0)
+        return -1;
+    return stringToInt(output.subString(prefixIndex + prefix.getLength(), output.getLength()));
+}
+
+SLANG_UNIT_TEST(incrementalModuleRebuild)
+{
+    const char* moduleSource = R"(
+        float helper(float x) { return x * 3.25; }
+
+        public float unchangedFunc(float x) { return helper(x) + 1.5; }
+
+        public float changedFunc(float x) { return x * 7.125; }
+
+        public struct Counter
+        {
+            public float next(float x) { return x + 0.375; }
+        }
+        )";
+
+    auto moduleName = "rebuildModule" + String(Process::getId());
+    File::writeAllText(moduleName + ".slang", moduleSource);
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+
+    // Compile the module from source, and write out its binary.
+    {
+        auto session = _createSession(globalSession, false);
+        SLANG_CHECK(session != nullptr);
+        auto module = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+        SLANG_CHECK(module != nullptr);
+        if (module)
+            SLANG_CHECK(module->writeToFile((moduleName + ".slang-module").getBuffer()) == SLANG_OK);
+    }
+
+    // Change one function body, so that the binary is out of date.
+    String changedSource = StringUtil::replaceAll(
+        UnownedStringSlice(moduleSource), toSlice("x * 7.125"), toSlice("x * 9.625"));
+    File::writeAllText(moduleName + ".slang", changedSource);
+
+    {
+        auto session = _createSession(globalSession, true);
+        SLANG_CHECK(session != nullptr);
+        String code = _compileUserModule(session, moduleName);
+        SLANG_CHECK(code.getLength() != 0);
+        SLANG_CHECK(code.indexOf(toSlice("9.625")) != -1);
+        SLANG_CHECK(code.indexOf(toSlice("7.125")) == -1);
+        SLANG_CHECK(code.indexOf(toSlice("3.25")) != -1);
+        SLANG_CHECK(code.indexOf(toSlice("1.5")) != -1);
+        SLANG_CHECK(code.indexOf(toSlice("0.375")) != -1);
+
+        // The bodies of `helper`, `unchangedFunc` and `Counter.next` are reused.
+        SLANG_CHECK(_getReusedFuncBodyCount(session) == 3);
+    }
+
+    // Changing the code around the bodies means none of them can be reused.
+    changedSource = StringUtil::replaceAll(
+        changedSource.getUnownedSlice(), toSlice("float helper(float x)"), toSlice("float helper(float y, float x = 0.0)"));
+    changedSource = StringUtil::replaceAll(changedSource.getUnownedSlice(), toSlice("x * 3.25"), toSlice("y * 3.25"));
+    File::writeAllText(moduleName + ".slang", changedSource);
+
+    {
+        auto session = _createSession(globalSession, true);
+        String code = _compileUserModule(session, moduleName);
+        SLANG_CHECK(code.indexOf(toSlice("9.625")) != -1);
+        SLANG_CHECK(code.indexOf(toSlice("3.25")) != -1);
+        SLANG_CHECK(_getReusedFuncBodyCount(session) == 0);
+    }
+
+    File::remove(moduleName + ".slang");
+    File::remove(moduleName + ".slang-module");
+}
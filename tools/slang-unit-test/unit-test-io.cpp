@@ -58,7 +58,34 @@ static SlangResult _checkGenerateTemporary()
     return SLANG_OK;
 }
 
+static SlangResult _checkGetStat()
+{
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-check"), path));
+    SLANG_RETURN_ON_FAIL(File::writeAllText(path, "hello"));
+
+    File::Stat stat;
+    SLANG_RETURN_ON_FAIL(File::getStat(path, stat));
+    SLANG_CHECK(stat.size == 5);
+    SLANG_CHECK(stat.modifiedTime != 0);
+
+    // Changing the size of the file changes the stat
+    SLANG_RETURN_ON_FAIL(File::writeAllText(path, "hello world"));
+    File::Stat newStat;
+    SLANG_RETURN_ON_FAIL(File::getStat(path, newStat));
+    SLANG_CHECK(newStat.size == 11);
+    SLANG_CHECK(newStat != stat);
+
+    SLANG_RETURN_ON_FAIL(File::remove(path));
+
+    // A file that doesn't exist has no stat
+    SLANG_CHECK(SLANG_FAILED(File::getStat(path, stat)));
+
+    return SLANG_OK;
+}
+
 SLANG_UNIT_TEST(io)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_checkGenerateTemporary()));
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkGetStat()));
 }
@@ -0,0 +1,110 @@
+// unit-test-ir-link-cache.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "unit-test-compile-util.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+// Test that the entry points of a program link against the same definitions, when the ones
+// chosen for the first entry point are reused for the others. Also checks that a program
+// linked after the modules of an earlier one are destroyed links against its own modules.
+
+static const char* kUserSource = R"(
+    import library;
+
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = getValue(float(tid.x));
+    }
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void otherMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = getValue(float(tid.x)) + 1.0;
+    }
+    )";
+
+    /// Compile both entry points of the user module against a library returning `x * scale`,
+    /// and return the code for each of them.
+static void _compileEntryPoints(slang::IGlobalSession* globalSession, const char* scale, String outCode[2])
+{
+    StringBuilder librarySource;
+    librarySource << "module library;\npublic float getValue(float x) { return x * " << scale << "; }\n";
+
+    auto session = createUnitTestSession(globalSession);
+    if (!session)
+        return;
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto library = session->loadModuleFromSourceString("library", "library.slang", librarySource.getBuffer(), diagnosticBlob.writeRef());
+    auto module = session->loadModuleFromSourceString("user", "user.slang", kUserSource, diagnosticBlob.writeRef());
+    if (!library || !module)
+        return;
+
+    List<slang::IComponentType*> components;
+    components.add(module);
+
+    const char* entryPointNames[] = { "computeMain", "otherMain" };
+    List<ComPtr<slang::IEntryPoint>> entryPoints;
+    for (auto entryPointName : entryPointNames)
+    {
+        ComPtr<slang::IEntryPoint> entryPoint;
+        module->findEntryPointByName(entryPointName, entryPoint.writeRef());
+        if (!entryPoint)
+            return;
+        entryPoints.add(entryPoint);
+        components.add(entryPoint);
+    }
+
+    ComPtr<slang::IComponentType> program;
+    session->createCompositeComponentType(components.getBuffer(), components.getCount(), program.writeRef(), diagnosticBlob.writeRef());
+    if (!program)
+        return;
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    program->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    if (!linkedProgram)
+        return;
+
+    // Each entry point is linked separately, in order
+    for (Index i = 0; i < 2; ++i)
+    {
+        ComPtr<slang::IBlob> code;
+        linkedProgram->getEntryPointCode(i, 0, code.writeRef(), diagnosticBlob.writeRef());
+        if (code)
+            outCode[i] = String(UnownedStringSlice((const char*)code->getBufferPointer(), code->getBufferSize()));
+    }
+}
+
+SLANG_UNIT_TEST(irLinkCache)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    String code[2];
+    _compileEntryPoints(globalSession, "3.25", code);
+    SLANG_CHECK(code[0].indexOf(toSlice("3.25")) != -1);
+    SLANG_CHECK(code[1].indexOf(toSlice("3.25")) != -1);
+
+    // The modules of the first program have been released, so the new ones may be allocated
+    // where they were.
+    String otherCode[2];
+    _compileEntryPoints(globalSession, "5.75", otherCode);
+    for (auto& entryPointCode : otherCode)
+    {
+        SLANG_CHECK(entryPointCode.indexOf(toSlice("5.75")) != -1);
+        SLANG_CHECK(entryPointCode.indexOf(toSlice("3.25")) == -1);
+    }
+}
@@ -0,0 +1,135 @@
+// unit-test-memory-usage.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+
+using namespace Slang;
+
+// Test that a session reports the memory it holds for each pipeline phase through
+// `ISessionMemoryUsage`, along with the peak and current values. The peak includes
+// the IR linked for code generation, which is gone by the end of the phase.
+SLANG_UNIT_TEST(memoryUsage)
+{
+    const char* userSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            outputBuffer[tid.x] = float(tid.x) * 2.0;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry optionEntry;
+    optionEntry.name = slang::CompilerOptionName::ReportMemory;
+    optionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &optionEntry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString("m", "m.slang", userSource, diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> program;
+    slang::IComponentType* components[] = { module, entryPoint.get() };
+    session->createCompositeComponentType(components, 2, program.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(program != nullptr);
+
+    ComPtr<slang::IComponentType> linkedProgram;
+    program->link(linkedProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(linkedProgram != nullptr);
+
+    ComPtr<slang::IBlob> code;
+    SLANG_CHECK(linkedProgram->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::ISessionMemoryUsage> memoryUsage;
+    SLANG_CHECK(session->queryInterface(
+        slang::ISessionMemoryUsage::getTypeGuid(), (void**)memoryUsage.writeRef()) == SLANG_OK);
+    if (!memoryUsage)
+        return;
+
+    bool hasLoadPhase = false;
+    bool hasCodeGenPhase = false;
+    bool hasLinkIRPhase = false;
+    bool hasPeak = false;
+    size_t peakLinkedIRBytes = 0;
+    size_t currentLinkedIRBytes = 0;
+    size_t currentIRBytes = 0;
+    size_t currentASTBytes = 0;
+    size_t currentGlobalIRBytes = 0;
+    size_t currentGlobalASTBytes = 0;
+
+    const auto entryCount = memoryUsage->getMemoryUsageEntryCount();
+    for (SlangInt i = 0; i < entryCount; ++i)
+    {
+        slang::MemoryUsageEntry entry;
+        SLANG_CHECK(memoryUsage->getMemoryUsageEntry(i, &entry) == SLANG_OK);
+        SLANG_CHECK(entry.usedBytes <= entry.reservedBytes);
+
+        auto phase = UnownedStringSlice(entry.phase);
+        auto category = UnownedStringSlice(entry.category);
+        hasLoadPhase |= phase == toSlice("load module");
+        hasCodeGenPhase |= phase == toSlice("code generation");
+        hasLinkIRPhase |= phase == toSlice("link IR");
+        hasPeak |= phase == toSlice("peak");
+        if (phase == toSlice("peak") && category == toSlice("LinkedIRModule"))
+            peakLinkedIRBytes = entry.usedBytes;
+        if (phase == toSlice("current") && category == toSlice("LinkedIRModule"))
+            currentLinkedIRBytes = entry.usedBytes;
+        if (phase == toSlice("current") && category == toSlice("IRModule"))
+            currentIRBytes = entry.usedBytes;
+        if (phase == toSlice("current") && category == toSlice("ASTBuilder"))
+            currentASTBytes = entry.usedBytes;
+        if (phase == toSlice("current") && category == toSlice("GlobalIRModule"))
+            currentGlobalIRBytes = entry.usedBytes;
+        if (phase == toSlice("current") && category == toSlice("GlobalASTBuilder"))
+            currentGlobalASTBytes = entry.usedBytes;
+    }
+    SLANG_CHECK(hasLoadPhase);
+    SLANG_CHECK(hasCodeGenPhase);
+    SLANG_CHECK(hasLinkIRPhase);
+    SLANG_CHECK(hasPeak);
+    SLANG_CHECK(peakLinkedIRBytes != 0);
+    SLANG_CHECK(currentLinkedIRBytes == 0);
+    SLANG_CHECK(currentIRBytes != 0);
+    SLANG_CHECK(currentASTBytes != 0);
+
+    // The builtin modules are held by the global session
+    SLANG_CHECK(currentGlobalIRBytes != 0);
+    SLANG_CHECK(currentGlobalASTBytes != 0);
+
+    slang::MemoryUsageEntry entry;
+    SLANG_CHECK(memoryUsage->getMemoryUsageEntry(entryCount, &entry) == SLANG_E_INVALID_ARG);
+
+    ComPtr<slang::IBlob> report;
+    SLANG_CHECK(memoryUsage->getMemoryUsageReport(report.writeRef()) == SLANG_OK);
+    if (report)
+    {
+        auto reportText = UnownedStringSlice((const char*)report->getBufferPointer(), report->getBufferSize());
+        SLANG_CHECK(reportText.indexOf(toSlice("IRModule")) != -1);
+        SLANG_CHECK(reportText.indexOf(toSlice("peak")) != -1);
+        SLANG_CHECK(reportText.indexOf(toSlice("Estimated")) != -1);
+    }
+}
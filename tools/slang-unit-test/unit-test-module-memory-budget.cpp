@@ -0,0 +1,111 @@
+// unit-test-module-memory-budget.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+using namespace Slang;
+
+static bool _isModuleLoaded(slang::ISession* session, slang::IModule* module)
+{
+    for (SlangInt i = 0; i < session->getLoadedModuleCount(); ++i)
+    {
+        if (session->getLoadedModule(i) == module)
+            return true;
+    }
+    return false;
+}
+
+    /// Compile `source` with a compile request of `session`, so any module it imports is loaded
+    /// into the session without the application holding a reference to it.
+static SlangResult _compileWithRequest(slang::ISession* session, const char* source)
+{
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_RETURN_ON_FAIL(session->createCompileRequest(request.writeRef()));
+
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "request");
+    request->addTranslationUnitSourceString(translationUnitIndex, "request.slang", source);
+    return request->compile();
+}
+
+// Test that a session with a module memory budget unloads modules that nothing uses anymore,
+// keeps the ones the application or other modules still reference, and loads unloaded
+// modules again when they are imported.
+SLANG_UNIT_TEST(moduleMemoryBudget)
+{
+    auto importedModuleName = "budgetImported" + String(Process::getId());
+    File::writeAllText(importedModuleName + ".slang", "public float importedValue() { return 4.0; }");
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    // A budget this small is always exceeded, so every module that can be unloaded is.
+    slang::CompilerOptionEntry optionEntry;
+    optionEntry.name = slang::CompilerOptionName::ModuleMemoryBudget;
+    optionEntry.value.intValue0 = 1;
+
+    const char* searchPath = ".";
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.searchPaths = &searchPath;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &optionEntry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    const auto initialModuleCount = session->getLoadedModuleCount();
+
+    // The application doesn't keep a reference, so it is unloaded by the next load.
+    auto unusedModule = session->loadModuleFromSourceString(
+        "unused", "unused.slang", "public float unusedValue() { return 1.0; }", diagnosticBlob.writeRef());
+    SLANG_CHECK(unusedModule != nullptr);
+
+    // Retained by the application, so never unloaded.
+    ComPtr<slang::IModule> retainedModule(session->loadModuleFromSourceString(
+        "retained", "retained.slang", "public float retainedValue() { return 2.0; }", diagnosticBlob.writeRef()));
+    SLANG_CHECK(retainedModule != nullptr);
+    SLANG_CHECK(session->getLoadedModuleCount() == initialModuleCount + 1);
+
+    // Only loaded for the compile request, so it can be unloaded once the request is done.
+    StringBuilder importingSource;
+    importingSource << "import " << importedModuleName << ";\n";
+    importingSource << "public float importingValue() { return importedValue() * 2.0; }\n";
+    SLANG_CHECK(SLANG_SUCCEEDED(_compileWithRequest(session, importingSource.getBuffer())));
+    SLANG_CHECK(session->getLoadedModuleCount() == initialModuleCount + 2);
+
+    // A module importing it keeps it loaded for as long as the importing module is retained.
+    ComPtr<slang::IModule> importingModule(session->loadModuleFromSourceString(
+        "importing", "importing.slang", importingSource.getBuffer(), diagnosticBlob.writeRef()));
+    SLANG_CHECK(importingModule != nullptr);
+    SLANG_CHECK(_isModuleLoaded(session, retainedModule));
+    SLANG_CHECK(session->getLoadedModuleCount() == initialModuleCount + 3);
+
+    // Once nothing uses the importing module, both it and the module it imports can be unloaded.
+    importingModule.setNull();
+    ComPtr<slang::IModule> otherModule(session->loadModuleFromSourceString(
+        "other", "other.slang", "public float otherValue() { return 3.0; }", diagnosticBlob.writeRef()));
+    SLANG_CHECK(otherModule != nullptr);
+    SLANG_CHECK(_isModuleLoaded(session, retainedModule));
+    SLANG_CHECK(_isModuleLoaded(session, otherModule));
+    SLANG_CHECK(session->getLoadedModuleCount() == initialModuleCount + 2);
+
+    // An unloaded module found on the search paths is loaded again when imported.
+    ComPtr<slang::IModule> reloadingModule(session->loadModuleFromSourceString(
+        "reloading", "reloading.slang", importingSource.getBuffer(), diagnosticBlob.writeRef()));
+    SLANG_CHECK(reloadingModule != nullptr);
+    SLANG_CHECK(session->getLoadedModuleCount() == initialModuleCount + 4);
+
+    File::remove(importedModuleName + ".slang");
+}
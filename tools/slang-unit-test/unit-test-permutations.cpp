@@ -0,0 +1,138 @@
+// unit-test-permutations.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+
+using namespace Slang;
+
+// Test that IComponentType2::getEntryPointCodeForPermutations generates code for
+// variants of a program that differ in specialization arguments and link-time constants.
+
+SLANG_UNIT_TEST(permutations)
+{
+    const char* userSourceBody = R"(
+        interface IMaterial
+        {
+            static int getValue();
+        }
+
+        struct MaterialA : IMaterial
+        {
+            static int getValue() { return 1111; }
+        }
+
+        struct MaterialB : IMaterial
+        {
+            static int getValue() { return 2222; }
+        }
+
+        extern static const int kScale;
+
+        RWStructuredBuffer<int> outputBuffer;
+
+        [shader("compute")]
+        [numthreads(1, 1, 1)]
+        void computeMain<M : IMaterial>()
+        {
+            outputBuffer[0] = M.getValue() * kScale;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString("m", "m.slang", userSourceBody, diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    module->findEntryPointByName("computeMain", entryPoint.writeRef());
+    SLANG_CHECK(entryPoint != nullptr);
+
+    ComPtr<slang::IComponentType> compositeProgram;
+    slang::IComponentType* components[] = { module, entryPoint.get() };
+    session->createCompositeComponentType(components, 2, compositeProgram.writeRef(), diagnosticBlob.writeRef());
+    SLANG_CHECK(compositeProgram != nullptr);
+
+    auto constants3 = session->loadModuleFromSourceString(
+        "constants3", "constants3.slang", "export static const int kScale = 303;", diagnosticBlob.writeRef());
+    auto constants4 = session->loadModuleFromSourceString(
+        "constants4", "constants4.slang", "export static const int kScale = 404;", diagnosticBlob.writeRef());
+    SLANG_CHECK(constants3 != nullptr && constants4 != nullptr);
+
+    auto layout = compositeProgram->getLayout();
+    slang::SpecializationArg materialA = slang::SpecializationArg::fromType(layout->findTypeByName("MaterialA"));
+    slang::SpecializationArg materialB = slang::SpecializationArg::fromType(layout->findTypeByName("MaterialB"));
+    slang::IComponentType* constants3Components[] = { constants3 };
+    slang::IComponentType* constants4Components[] = { constants4 };
+
+    slang::PermutationDesc permutations[3];
+    permutations[0].specializationArgs = &materialA;
+    permutations[0].specializationArgCount = 1;
+    permutations[0].linkTimeComponents = constants3Components;
+    permutations[0].linkTimeComponentCount = 1;
+    permutations[1] = permutations[0];
+    permutations[1].specializationArgs = &materialB;
+    permutations[2] = permutations[0];
+    permutations[2].linkTimeComponents = constants4Components;
+
+    ComPtr<slang::IComponentType2> compositeProgram2;
+    SLANG_CHECK(compositeProgram->queryInterface(
+        slang::IComponentType2::getTypeGuid(), (void**)compositeProgram2.writeRef()) == SLANG_OK);
+
+    slang::IBlob* codes[3] = {};
+    SLANG_CHECK(compositeProgram2->getEntryPointCodeForPermutations(
+        0, 0, permutations, 3, codes, diagnosticBlob.writeRef()) == SLANG_OK);
+
+    for (auto code : codes)
+    {
+        SLANG_CHECK(code != nullptr);
+    }
+    if (codes[0] && codes[1] && codes[2])
+    {
+        auto code0 = UnownedStringSlice((const char*)codes[0]->getBufferPointer(), codes[0]->getBufferSize());
+        auto code1 = UnownedStringSlice((const char*)codes[1]->getBufferPointer(), codes[1]->getBufferSize());
+        auto code2 = UnownedStringSlice((const char*)codes[2]->getBufferPointer(), codes[2]->getBufferSize());
+        SLANG_CHECK(code0.indexOf(toSlice("computeMain")) != -1);
+
+        // Each variant uses the material and the value of the constant it was given
+        SLANG_CHECK(code0.indexOf(toSlice("1111")) != -1 && code0.indexOf(toSlice("303")) != -1);
+        SLANG_CHECK(code0.indexOf(toSlice("2222")) == -1 && code0.indexOf(toSlice("404")) == -1);
+        SLANG_CHECK(code1.indexOf(toSlice("2222")) != -1 && code1.indexOf(toSlice("303")) != -1);
+        SLANG_CHECK(code1.indexOf(toSlice("1111")) == -1 && code1.indexOf(toSlice("404")) == -1);
+        SLANG_CHECK(code2.indexOf(toSlice("1111")) != -1 && code2.indexOf(toSlice("404")) != -1);
+        SLANG_CHECK(code2.indexOf(toSlice("2222")) == -1 && code2.indexOf(toSlice("303")) == -1);
+    }
+
+    for (auto code : codes)
+    {
+        if (code)
+            code->release();
+    }
+
+    // A permutation with the wrong number of specialization arguments fails,
+    // without affecting the others.
+    permutations[1].specializationArgCount = 0;
+    slang::IBlob* moreCodes[2] = {};
+    SLANG_CHECK(SLANG_FAILED(compositeProgram2->getEntryPointCodeForPermutations(
+        0, 0, permutations, 2, moreCodes, diagnosticBlob.writeRef())));
+    SLANG_CHECK(moreCodes[0] != nullptr);
+    SLANG_CHECK(moreCodes[1] == nullptr);
+    if (moreCodes[0])
+        moreCodes[0]->release();
+}
@@ -0,0 +1,73 @@
+// unit-test-preprocessor-footprint.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+
+using namespace Slang;
+
+// Test that a linkage reuses an imported module when the preprocessor definitions change
+// in a way the module source never looks at, and loads it again when they don't.
+SLANG_UNIT_TEST(preprocessorFootprint)
+{
+    const char* moduleSource = R"(
+        #ifdef USE_OTHER_VALUE
+        public int getOtherValue() { return 2; }
+        #else
+        public int getValue() { return 1; }
+        #endif
+        )";
+
+    // Write the module to its own directory, which is removed however the test ends.
+    const String directory = Path::simplify(Path::getParentDirectory(Path::getExecutablePath()) + "/preprocessor-footprint-test" + String(Process::getId()));
+    const String moduleName = "footprintModule";
+    const String modulePath = Path::combine(directory, moduleName + ".slang");
+    Path::createDirectory(directory);
+    SLANG_DEFER(File::remove(modulePath); Path::remove(directory));
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::writeAllText(modulePath, moduleSource)));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    const char* searchPath = directory.getBuffer();
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.searchPaths = &searchPath;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+    SLANG_CHECK(module->getLayout()->findFunctionByName("getValue") != nullptr);
+    const auto loadedModuleCount = session->getLoadedModuleCount();
+
+    // Definitions added through a compile request created from the session apply to the
+    // whole session.
+    ComPtr<slang::ICompileRequest> request;
+    SLANG_CHECK_ABORT(session->createCompileRequest(request.writeRef()) == SLANG_OK);
+
+    // A definition the module never consults should not cause it to be parsed again.
+    request->addPreprocessorDefine("UNRELATED_DEFINE", "1");
+    SLANG_CHECK(session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef()) == module);
+
+    // A definition tested by `#ifdef` in the module requires a new version of the module,
+    // which replaces the previous one in the list of loaded modules, and is parsed with the
+    // definition in effect.
+    request->addPreprocessorDefine("USE_OTHER_VALUE", "1");
+    auto otherModule = session->loadModule(moduleName.getBuffer(), diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(otherModule != nullptr && otherModule != module);
+    SLANG_CHECK(session->getLoadedModuleCount() == loadedModuleCount);
+    SLANG_CHECK(otherModule->getLayout()->findFunctionByName("getOtherValue") != nullptr);
+    SLANG_CHECK(otherModule->getLayout()->findFunctionByName("getValue") == nullptr);
+}
@@ -88,6 +88,32 @@ static SlangResult _httpReflectTest(UnitTestContext* context)
     return finalRes;
 }
 
+static SlangResult _checkCountOutput(const ExecuteResult& exeRes, Index size, Index crashIndex)
+{
+    Index v = 0;
+    for (auto line : LineParser(exeRes.standardOutput.getUnownedSlice()))
+    {
+        if (line.getLength() == 0)
+        {
+            continue;
+        }
+
+        Index value;
+        StringUtil::parseInt(line, value);
+
+        if (value != v)
+        {
+            return SLANG_FAIL;
+        }
+
+        v++;
+    }
+
+    const Index endIndex = (crashIndex >= 0) ? (crashIndex + 1) : size;
+
+    return v == endIndex ? SLANG_OK : SLANG_FAIL;
+}
+
 static SlangResult _countTest(UnitTestContext* context, Index size, Index crashIndex = -1)
 {
     /* Here we are trying to test what happens if the server produces a large amount of data, and
@@ -121,28 +147,7 @@ static SlangResult _countTest(UnitTestContext* context, Index size, Index crashI
 
     SLANG_RETURN_ON_FAIL(ProcessUtil::readUntilTermination(process, exeRes));
 
-    Index v = 0;
-    for (auto line : LineParser(exeRes.standardOutput.getUnownedSlice()))
-    {
-        if (line.getLength() == 0)
-        {
-            continue;
-        }
-
-        Index value;
-        StringUtil::parseInt(line, value);
-
-        if (value != v)
-        {
-            return SLANG_FAIL;
-        }
-
-        v++;
-    }
-
-    const Index endIndex = (crashIndex >= 0) ? (crashIndex + 1) : size;
-
-    return v == endIndex ? SLANG_OK : SLANG_FAIL;
+    return _checkCountOutput(exeRes, size, crashIndex);
 }
 
 static SlangResult _countTests(UnitTestContext* context)
@@ -187,9 +192,100 @@ static SlangResult _reflectTest(UnitTestContext* context)
     return SLANG_OK;
 }
 
+static SlangResult _pumpStreamsTest(UnitTestContext* context)
+{
+    /* Write more input than fits in a pipe to several processes that echo it back, while reading their
+    output from the same thread. If the input isn't written as it's consumed this would deadlock. */
+
+    const Index processCount = 4;
+
+    StringBuilder expected;
+    for (Index i = 0; i < 20000; i++)
+    {
+        expected << i << " Hello " << i << "\n";
+    }
+
+    StringBuilder input;
+    input << expected << "end\n";
+
+    List<RefPtr<Process>> processes;
+    List<List<Byte>> outputs;
+    List<Process::StreamIO> ios;
+    processes.setCount(processCount);
+    outputs.setCount(processCount);
+    ios.setCount(processCount);
+
+    for (Index i = 0; i < processCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_createProcess(context, "reflect", nullptr, processes[i]));
+
+        auto& io = ios[i];
+        io.process = processes[i];
+        io.writeInput = true;
+        io.input = ConstArrayView<Byte>((const Byte*)input.getBuffer(), input.getLength());
+        io.output = &outputs[i];
+    }
+
+    SLANG_RETURN_ON_FAIL(Process::pumpStreams(ios.getBuffer(), processCount));
+
+    for (Index i = 0; i < processCount; ++i)
+    {
+        processes[i]->waitForTermination();
+
+        // Compare by line, as the output may have different line endings
+        const UnownedStringSlice output((const char*)outputs[i].begin(), (const char*)outputs[i].end());
+        if (!StringUtil::areLinesEqual(expected.getUnownedSlice(), output))
+        {
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _executeAllTest(UnitTestContext* context)
+{
+    /* Run several processes that produce different amounts of output, some of which crash part way, and
+    check all of the output of each is read while they run at the same time. */
+
+    const Index sizes[] = { 1, 1000, 100000, 10000 };
+    const Index crashIndices[] = { -1, 500, -1, 5000 };
+    const Index processCount = SLANG_COUNT_OF(sizes);
+
+    List<CommandLine> cmdLines;
+    for (Index i = 0; i < processCount; ++i)
+    {
+        CommandLine cmdLine;
+        cmdLine.setExecutableLocation(ExecutableLocation(context->executableDirectory, "test-process"));
+        cmdLine.addArg("count");
+
+        StringBuilder buf;
+        buf << sizes[i];
+        cmdLine.addArg(buf);
+        if (crashIndices[i] >= 0)
+        {
+            buf.clear();
+            buf << crashIndices[i];
+            cmdLine.addArg(buf);
+        }
+        cmdLines.add(cmdLine);
+    }
+
+    List<ExecuteResult> exeResults;
+    exeResults.setCount(processCount);
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLines.getBuffer(), processCount, exeResults.getBuffer()));
+
+    for (Index i = 0; i < processCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_checkCountOutput(exeResults[i], sizes[i], crashIndices[i]));
+    }
+    return SLANG_OK;
+}
+
 SLANG_UNIT_TEST(CommandLineProcess)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_countTests(unitTestContext)));
     SLANG_CHECK(SLANG_SUCCEEDED(_reflectTest(unitTestContext)));
+    SLANG_CHECK(SLANG_SUCCEEDED(_pumpStreamsTest(unitTestContext)));
+    SLANG_CHECK(SLANG_SUCCEEDED(_executeAllTest(unitTestContext)));
     SLANG_CHECK(SLANG_SUCCEEDED(_httpReflectTest(unitTestContext)));
 }
@@ -33,6 +33,29 @@ static void _writeRandom(RandomGenerator* rand, size_t maxSize, RiffContainer& i
     SLANG_ASSERT(dataChunk);
 }
 
+namespace { // anonymous
+
+// Reads payloads from memory, counting the reads
+class CountingPayloadSource : public RiffContainer::PayloadSource
+{
+public:
+    virtual SlangResult read(size_t offset, size_t size, void* outData) SLANG_OVERRIDE
+    {
+        if (offset > m_data.getCount() || size > m_data.getCount() - offset)
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(outData, m_data.getBuffer() + offset, size);
+        m_readCount++;
+        return SLANG_OK;
+    }
+
+    List<uint8_t> m_data;
+    Index m_readCount = 0;
+};
+
+} // anonymous
+
 SLANG_UNIT_TEST(riff)
 {
     typedef RiffContainer::ScopeChunk ScopeChunk;
@@ -111,6 +134,60 @@ SLANG_UNIT_TEST(riff)
 
     }
 
+    // Test reading with deferred payloads only reads a payload when it is accessed
+    {
+        RiffContainer container;
+        {
+            ScopeChunk scopeContainer(&container, Kind::List, markThings);
+            {
+                ScopeChunk scopeChunk(&container, Kind::Data, markData);
+                const char first[] = "First";
+                container.write(first, sizeof(first));
+            }
+            {
+                ScopeChunk scopeChunk(&container, Kind::Data, markData);
+                const char second[] = "Second!";
+                container.write(second, sizeof(second));
+            }
+        }
+
+        OwnedMemoryStream stream(FileAccess::ReadWrite);
+        SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::write(container.getRoot(), true, &stream)));
+
+        RefPtr<CountingPayloadSource> source = new CountingPayloadSource;
+        source->m_data.addRange(stream.getContents().getBuffer(), stream.getContents().getCount());
+
+        RiffContainer readContainer;
+        SLANG_CHECK(SLANG_SUCCEEDED(RiffUtil::readDeferred(source, size_t(source->m_data.getCount()), readContainer)));
+
+        auto listChunk = as<RiffContainer::ListChunk>(readContainer.getRoot());
+        SLANG_CHECK(listChunk != nullptr);
+        if (listChunk)
+        {
+            auto firstChunk = as<RiffContainer::DataChunk>(listChunk->getFirstContainedChunk());
+            auto secondChunk = firstChunk ? as<RiffContainer::DataChunk>(firstChunk->m_next) : nullptr;
+            SLANG_CHECK(firstChunk && secondChunk);
+            if (firstChunk && secondChunk)
+            {
+                const Index headerReadCount = source->m_readCount;
+
+                SLANG_CHECK(secondChunk->isEqual("Second!", sizeof("Second!")));
+                SLANG_CHECK(source->m_readCount == headerReadCount + 1);
+
+                // Accessing it again doesn't read it again
+                SLANG_CHECK(secondChunk->isEqual("Second!", sizeof("Second!")));
+                SLANG_CHECK(source->m_readCount == headerReadCount + 1);
+
+                SLANG_CHECK(firstChunk->isEqual("First", sizeof("First")));
+                SLANG_CHECK(source->m_readCount == headerReadCount + 2);
+            }
+        }
+
+        // A RIFF that is cut short fails to read
+        RiffContainer truncatedContainer;
+        SLANG_CHECK(SLANG_FAILED(RiffUtil::readDeferred(source, size_t(source->m_data.getCount()) - 4, truncatedContainer)));
+    }
+
     // Test writing as a stream only allocates a single data block (as long as there is enough space).
     {
         RiffContainer container;
@@ -0,0 +1,82 @@
+// unit-test-serialized-module-link.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "unit-test-compile-util.h"
+
+using namespace Slang;
+
+// Test linking against a module loaded from a serialized blob, where function bodies are only
+// decoded once they are used. Also checks that a module loaded this way can be serialized again.
+
+static const char* kUserSource = R"(
+    import library;
+
+    RWStructuredBuffer<float> outputBuffer;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain(uint3 tid : SV_DispatchThreadID)
+    {
+        outputBuffer[tid.x] = usedFunc(float(tid.x)) + genericFunc<Scale2>(1.0);
+    }
+    )";
+
+SLANG_UNIT_TEST(serializedModuleLink)
+{
+    const char* librarySource = R"(
+        module library;
+
+        public interface IScale { static float get(); }
+        public struct Scale2 : IScale { static float get() { return 2.0; } }
+
+        float helper(float x) { return x * 3.25; }
+
+        public float usedFunc(float x) { return helper(x) + 1.5; }
+        public float unusedFunc(float x) { return x * 7.0; }
+
+        public float genericFunc<T : IScale>(float x) { return x * T.get(); }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+
+    // Compile against the library from source, and serialize it.
+    auto sourceSession = createUnitTestSession(globalSession);
+    SLANG_CHECK(sourceSession != nullptr);
+    auto sourceLibrary = sourceSession->loadModuleFromSourceString("library", "library.slang", librarySource, diagnosticBlob.writeRef());
+    SLANG_CHECK(sourceLibrary != nullptr);
+
+    ComPtr<slang::IBlob> libraryBlob;
+    SLANG_CHECK(sourceLibrary->serialize(libraryBlob.writeRef()) == SLANG_OK);
+
+    String sourceCode = compileUnitTestUserModule(sourceSession, kUserSource);
+    SLANG_CHECK(sourceCode.getLength() != 0);
+    SLANG_CHECK(sourceCode.indexOf(toSlice("3.25")) != -1);
+
+    // Compile against the library loaded from the blob.
+    auto blobSession = createUnitTestSession(globalSession);
+    auto blobLibrary = blobSession->loadModuleFromIRBlob("library", "library.slang-module", libraryBlob, diagnosticBlob.writeRef());
+    SLANG_CHECK(blobLibrary != nullptr);
+
+    String blobCode = compileUnitTestUserModule(blobSession, kUserSource);
+    SLANG_CHECK(blobCode.indexOf(toSlice("3.25")) != -1);
+
+    // A loaded module can be serialized again, including the bodies the user module didn't need.
+    ComPtr<slang::IBlob> reserializedBlob;
+    SLANG_CHECK(blobLibrary->serialize(reserializedBlob.writeRef()) == SLANG_OK);
+
+    auto reloadSession = createUnitTestSession(globalSession);
+    auto reloadedLibrary = reloadSession->loadModuleFromIRBlob("library", "library.slang-module", reserializedBlob, diagnosticBlob.writeRef());
+    SLANG_CHECK(reloadedLibrary != nullptr);
+
+    String reloadedCode = compileUnitTestUserModule(reloadSession, kUserSource);
+    SLANG_CHECK(reloadedCode.indexOf(toSlice("3.25")) != -1);
+}
@@ -0,0 +1,86 @@
+// unit-test-source-file-digest-cache.cpp
+
+#include "../../source/compiler-core/slang-source-file-digest-cache.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+static SHA1::Digest _getDigest(const char* text)
+{
+    DigestBuilder<SHA1> builder;
+    builder.append(UnownedStringSlice(text));
+    return builder.finalize();
+}
+
+static SlangResult _checkReadFile()
+{
+    String path;
+    SLANG_RETURN_ON_FAIL(File::generateTemporary(toSlice("slang-digest-cache"), path));
+    SLANG_RETURN_ON_FAIL(File::writeAllText(path, "int f() { return 1; }"));
+
+    File::Stat stat;
+    SHA1::Digest digest;
+    SLANG_RETURN_ON_FAIL(SourceFileDigestCache::readFile(path, stat, digest));
+    SLANG_CHECK(stat.size == 21);
+    SLANG_CHECK(digest == _getDigest("int f() { return 1; }"));
+
+    // The byte order mark isn't part of the contents of a source file, so doesn't change the digest
+    const unsigned char contentsWithBOM[] = { 0xef, 0xbb, 0xbf, 'i', 'n', 't', ' ', 'x', ';' };
+    SLANG_RETURN_ON_FAIL(File::writeAllBytes(path, contentsWithBOM, sizeof(contentsWithBOM)));
+    SLANG_RETURN_ON_FAIL(SourceFileDigestCache::readFile(path, stat, digest));
+    SLANG_CHECK(stat.size == sizeof(contentsWithBOM));
+    SLANG_CHECK(digest == _getDigest("int x;"));
+
+    SLANG_RETURN_ON_FAIL(File::remove(path));
+
+    // A file that doesn't exist can't be read
+    SLANG_CHECK(SLANG_FAILED(SourceFileDigestCache::readFile(path, stat, digest)));
+
+    return SLANG_OK;
+}
+
+static void _checkCache()
+{
+    SourceFileDigestCache cache;
+
+    File::Stat stat;
+    stat.size = 10;
+    stat.modifiedTime = 100;
+
+    const auto digest = _getDigest("a");
+
+    SHA1::Digest foundDigest;
+    SLANG_CHECK(!cache.tryGetDigest("/a.slang", stat, foundDigest));
+
+    cache.addDigest("/a.slang", stat, digest);
+    SLANG_CHECK(cache.tryGetDigest("/a.slang", stat, foundDigest));
+    SLANG_CHECK(foundDigest == digest);
+
+    // The digest is only found for the same path, size and modification time
+    SLANG_CHECK(!cache.tryGetDigest("/b.slang", stat, foundDigest));
+
+    File::Stat changedStat = stat;
+    changedStat.modifiedTime = 200;
+    SLANG_CHECK(!cache.tryGetDigest("/a.slang", changedStat, foundDigest));
+
+    changedStat = stat;
+    changedStat.size = 11;
+    SLANG_CHECK(!cache.tryGetDigest("/a.slang", changedStat, foundDigest));
+
+    // Adding a digest for a path replaces the one for its older stat
+    const auto changedDigest = _getDigest("b");
+    changedStat = stat;
+    changedStat.modifiedTime = 200;
+    cache.addDigest("/a.slang", changedStat, changedDigest);
+    SLANG_CHECK(cache.getCount() == 1);
+    SLANG_CHECK(!cache.tryGetDigest("/a.slang", stat, foundDigest));
+    SLANG_CHECK(cache.tryGetDigest("/a.slang", changedStat, foundDigest));
+    SLANG_CHECK(foundDigest == changedDigest);
+}
+
+SLANG_UNIT_TEST(sourceFileDigestCache)
+{
+    SLANG_CHECK(SLANG_SUCCEEDED(_checkReadFile()));
+    _checkCache();
+}
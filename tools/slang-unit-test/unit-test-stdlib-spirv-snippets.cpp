@@ -0,0 +1,137 @@
+// unit-test-stdlib-spirv-snippets.cpp
+
+#include "slang.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "tools/unit-test/slang-unit-test.h"
+#include "slang-com-ptr.h"
+#include "unit-test-compile-util.h"
+
+using namespace Slang;
+
+// Test that a global session created from a saved stdlib gets the SPIR-V snippets parsed when
+// the stdlib was compiled from the `core.spirv-snippets` file in the archive, and that emitting
+// SPIR-V with it doesn't parse any snippet text.
+
+namespace
+{
+
+struct SpvSnippetCounts
+{
+    Index loadedCount = -1;         ///< The number of snippets that came with the stdlib
+    Index parsedCount = -1;         ///< The number of snippets parsed while emitting code
+};
+
+} // anonymous
+
+static ComPtr<slang::ISession> _createSPIRVSession(slang::IGlobalSession* globalSession)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_SPIRV;
+    targetDesc.profile = globalSession->findProfile("spirv_1_5");
+
+    slang::CompilerOptionEntry optionEntry;
+    optionEntry.name = slang::CompilerOptionName::EmitSpirvDirectly;
+    optionEntry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &optionEntry;
+
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+    // Get the snippet counts of the global session of `session`, from the performance report of
+    // a compile request that shares it.
+static SpvSnippetCounts _getSpvSnippetCounts(slang::ISession* session)
+{
+    SpvSnippetCounts counts;
+
+    ComPtr<slang::ICompileRequest> request;
+    if (SLANG_FAILED(session->createCompileRequest(request.writeRef())))
+        return counts;
+
+    request->setReportPerfBenchmark(true);
+    const int translationUnitIndex = request->addTranslationUnit(SLANG_SOURCE_LANGUAGE_SLANG, "empty");
+    request->addTranslationUnitSourceString(translationUnitIndex, "empty.slang", "");
+    if (SLANG_FAILED(request->compile()))
+        return counts;
+
+    // The line is "SPIR-V Snippets: <loaded> loaded with the stdlib, <parsed> parsed while emitting"
+    const auto prefix = toSlice("SPIR-V Snippets: ");
+    const auto separator = toSlice("stdlib, ");
+    String output = request->getDiagnosticOutput();
+    const Index prefixIndex = output.indexOf(prefix);
+    if (prefixIndex < 0)
+        return counts;
+    String line = output.subString(prefixIndex + prefix.getLength(), output.getLength());
+    const Index separatorIndex = line.indexOf(separator);
+    if (separatorIndex < 0)
+        return counts;
+
+    counts.loadedCount = stringToInt(line);
+    counts.parsedCount = stringToInt(line.subString(separatorIndex + separator.getLength(), line.getLength()));
+    return counts;
+}
+
+SLANG_UNIT_TEST(stdlibSpirvSnippets)
+{
+    const char* userSource = R"(
+        RWStructuredBuffer<float> outputBuffer;
+        RWStructuredBuffer<uint> counterBuffer;
+        Texture2D<float4> texture;
+        SamplerState sampler;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid : SV_DispatchThreadID)
+        {
+            float x = float(tid.x);
+            float4 sampled = texture.SampleLevel(sampler, float2(x, 0.5), 0);
+            uint previous;
+            InterlockedAdd(counterBuffer[0], 1, previous);
+            outputBuffer[tid.x] = sin(x) + sqrt(abs(x)) + WaveActiveSum(x) + sampled.x + float(previous);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    auto session = _createSPIRVSession(globalSession);
+    SLANG_CHECK(session != nullptr);
+    if (!session)
+        return;
+    const auto counts = _getSpvSnippetCounts(session);
+    SLANG_CHECK(counts.loadedCount >= 0);
+
+    ComPtr<ISlangBlob> stdLibBlob;
+    SLANG_CHECK(globalSession->saveStdLib(SLANG_ARCHIVE_TYPE_RIFF_LZ4, stdLibBlob.writeRef()) == SLANG_OK);
+    if (!stdLibBlob)
+        return;
+
+    // A new global session, set up the way a new process would set up a saved stdlib, gets the
+    // same snippets from the archive
+    ComPtr<slang::IGlobalSession> loadedGlobalSession;
+    SLANG_CHECK(slang_createGlobalSessionWithoutStdLib(SLANG_API_VERSION, loadedGlobalSession.writeRef()) == SLANG_OK);
+    if (!loadedGlobalSession)
+        return;
+    SLANG_CHECK(loadedGlobalSession->loadStdLib(stdLibBlob->getBufferPointer(), stdLibBlob->getBufferSize()) == SLANG_OK);
+
+    auto loadedSession = _createSPIRVSession(loadedGlobalSession);
+    SLANG_CHECK(loadedSession != nullptr);
+    if (!loadedSession)
+        return;
+    const auto loadedCounts = _getSpvSnippetCounts(loadedSession);
+    SLANG_CHECK(loadedCounts.loadedCount == counts.loadedCount);
+    SLANG_CHECK(loadedCounts.parsedCount == 0);
+
+    // Emitting SPIR-V that uses the stdlib finds all the snippets it needs among the loaded ones
+    SLANG_CHECK(compileUnitTestUserModule(loadedSession, userSource).getLength() > 0);
+    SLANG_CHECK(_getSpvSnippetCounts(loadedSession).parsedCount == 0);
+}
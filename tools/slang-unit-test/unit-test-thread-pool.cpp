@@ -0,0 +1,78 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+
+#include "tools/unit-test/slang-unit-test.h"
+
+#include <atomic>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(threadPool)
+{
+    RefPtr<ThreadPool> pool = new ThreadPool(3);
+
+    // Every iteration runs once, on a thread slot within the limit
+    {
+        const Index count = 1000;
+        List<int> runCounts;
+        runCounts.setCount(count);
+        for (auto& runCount : runCounts)
+            runCount = 0;
+
+        std::atomic<Index> largestSlot{0};
+        pool->forEach(count, 3, [&](Index index, Index threadSlot)
+        {
+            runCounts[index]++;
+            Index largest = largestSlot.load();
+            while (threadSlot > largest && !largestSlot.compare_exchange_weak(largest, threadSlot)) {}
+        });
+
+        for (auto runCount : runCounts)
+            SLANG_CHECK(runCount == 1);
+        SLANG_CHECK(largestSlot.load() < 3);
+    }
+
+    // Loops can be started from the iterations of another loop
+    {
+        std::atomic<Index> sum{0};
+        pool->forEach(16, 4, [&](Index, Index)
+        {
+            pool->forEach(10, 4, [&](Index index, Index) { sum += index; });
+        });
+        SLANG_CHECK(sum.load() == 16 * 45);
+    }
+
+    // The first exception is rethrown once all iterations have run
+    {
+        std::atomic<Index> runCount{0};
+        bool threw = false;
+        try
+        {
+            pool->forEach(10, 4, [&](Index index, Index)
+            {
+                runCount++;
+                if (index == 5)
+                    throw 5;
+            });
+        }
+        catch (int)
+        {
+            threw = true;
+        }
+        SLANG_CHECK(threw);
+        SLANG_CHECK(runCount.load() == 10);
+    }
+
+    // A pool without workers runs loops on the calling thread
+    {
+        RefPtr<ThreadPool> serialPool = new ThreadPool(0);
+        Index sum = 0;
+        serialPool->forEach(10, 4, [&](Index index, Index threadSlot)
+        {
+            SLANG_CHECK(threadSlot == 0);
+            sum += index;
+        });
+        SLANG_CHECK(sum == 45);
+    }
+}